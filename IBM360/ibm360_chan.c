@@ -353,6 +353,7 @@ writebuff(struct _chanctl *chan) {
     }
     key[addr >> 9] |= 0x6;
     M[addr] = chan->chan_buf;
+    MEM_DIRTY(addr);
     sim_debug(DEBUG_CDATA, &cpu_dev, "Channel readf %03x %06x %08x %08x '",
           chan->daddr, addr << 2, chan->chan_buf, chan->ccw_count);
     for(k = 24; k >= 0; k -= 8) {
@@ -784,7 +785,9 @@ chan_end(uint16 addr, uint8 flags) {
 void
 store_csw(struct _chanctl *chan) {
     M[0x40 >> 2] = chan->caw;
+    MEM_DIRTY(0x40 >> 2);
     M[0x44 >> 2] = (((uint32)chan->ccw_count)) | ((uint32)chan->chan_status<<16);
+    MEM_DIRTY(0x44 >> 2);
     key[0] |= 0x6;
     if (chan->chan_status & STATUS_PCI) {
         chan->chan_status &= ~STATUS_PCI;
@@ -844,7 +847,9 @@ startio(uint16 addr) {
         if (dev_status[addr] & SNS_DEVEND)
             dev_status[addr] |= SNS_BSY;
         M[0x44 >> 2] = (((uint32)dev_status[addr]) << 24);
+        MEM_DIRTY(0x44 >> 2);
         M[0x40 >> 2] = 0;
+        MEM_DIRTY(0x40 >> 2);
         key[0] |= 0x6;
         sim_debug(DEBUG_EXP, &cpu_dev,
             "SIO Set atten %03x %02x [%08x] %08x\n",
@@ -863,6 +868,7 @@ startio(uint16 addr) {
         }
         if (status != 0) {
             M[0x44 >> 2] = ((uint32)status<<16) | (M[0x44 >> 2] & 0xffff);
+            MEM_DIRTY(0x44 >> 2);
             sim_debug(DEBUG_EXP, &cpu_dev, "Channel store csw  %03x %08x\n",
                    chan->daddr, M[0x44 >> 2]);
             return 1;
@@ -882,6 +888,7 @@ startio(uint16 addr) {
     /* Try to load first command */
     if (load_ccw(chan, 0)) {
         M[0x44 >> 2] = ((uint32)chan->chan_status<<16) | (M[0x44 >> 2] & 0xffff);
+        MEM_DIRTY(0x44 >> 2);
         key[0] |= 0x6;
         sim_debug(DEBUG_CMD, &cpu_dev, "SIO %03x %02x %x cc=1\n", addr,
               chan->ccw_cmd, chan->ccw_flags);
@@ -896,7 +903,9 @@ startio(uint16 addr) {
     /* If channel returned busy save CSW and return cc=1 */
     if (chan->chan_status & STATUS_BUSY) {
         M[0x40 >> 2] = 0;
+        MEM_DIRTY(0x40 >> 2);
         M[0x44 >> 2] = ((uint32)chan->chan_status<<16);
+        MEM_DIRTY(0x44 >> 2);
         key[0] |= 0x6;
         chan->chan_status = 0;
         chan->ccw_cmd = 0;
@@ -966,7 +975,9 @@ int testio(uint16 addr) {
         sim_debug(DEBUG_CMD, &cpu_dev, "TIO %03x %03x %02x %x cc=1b\n", addr,
               chan->daddr, chan->ccw_cmd, chan->ccw_flags);
         M[0x40 >> 2] = 0;
+        MEM_DIRTY(0x40 >> 2);
         M[0x44 >> 2] = ((uint32)dev_status[addr]) << 24;
+        MEM_DIRTY(0x44 >> 2);
         key[0] |= 0x6;
         dev_status[addr] = 0;
         return 1;
@@ -996,6 +1007,7 @@ int testio(uint16 addr) {
     /* If we get a error, save csw and return cc=1 */
     if (status & ERROR_STATUS) {
         M[0x44 >> 2] = ((uint32)status<<16) | (M[0x44 >> 2] & 0xffff);
+        MEM_DIRTY(0x44 >> 2);
         key[0] |= 0x6;
         sim_debug(DEBUG_CMD, &cpu_dev, "TIO %03x %03x %02x %x %x cc=1d\n", addr,
               chan->daddr, chan->ccw_cmd, chan->ccw_flags, status);
@@ -1058,6 +1070,7 @@ int haltio(uint16 addr) {
         if (cc == 1) {
             M[0x44 >> 2] = (((uint32)chan->chan_status) << 16) |
                        (M[0x44 >> 2] & 0xffff);
+            MEM_DIRTY(0x44 >> 2);
             key[0] |= 0x6;
             sim_debug(DEBUG_EXP, &cpu_dev, "Channel store csw %03x %08x\n",
                     chan->daddr, M[0x44 >> 2]);
@@ -1068,6 +1081,7 @@ int haltio(uint16 addr) {
     /* Store CSW and return 1. */
     sim_debug(DEBUG_CMD, &cpu_dev, "HIOx %03x %03x cc=1\n", addr, chan->daddr);
     M[0x44 >> 2] = (((uint32)chan->chan_status) << 16) | (M[0x44 >> 2] & 0xffff);
+    MEM_DIRTY(0x44 >> 2);
     key[0] |= 0x6;
     sim_debug(DEBUG_EXP, &cpu_dev, "Channel store csw %03x %08x\n", chan->daddr,
               M[0x44 >> 2]);
@@ -1315,7 +1329,9 @@ scan_chan(uint16 mask, int irq_en) {
                       chan_pend[j] = 1;
                       irq_pend = 1;
                       M[0x44 >> 2] = (((uint32)dev_status[nchan|i]) << 24);
+                      MEM_DIRTY(0x44 >> 2);
                       M[0x40>>2] = 0;
+                      MEM_DIRTY(0x40>>2);
                       key[0] |= 0x6;
                       sim_debug(DEBUG_EXP, &cpu_dev,
                                "Set atten %03x %02x [%08x] %08x\n", nchan|i,
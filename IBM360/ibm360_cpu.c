@@ -84,6 +84,7 @@
 #define HIST_LPW     0x4000000
 
 uint32       *M = NULL;
+uint8        mem_dirty[SIM_DIRTY_BYTES(MAXMEMSIZE)]; /* Pages changed since SAVE */
 uint8        key[MAXMEMSIZE/2048];
 uint32       regs[16];             /* CPU Registers */
 uint32       PC;                   /* Program counter */
@@ -295,7 +296,10 @@ int32               rtc_tps = 300;
    cpu_mod      CPU modifier list
 */
 
-UNIT cpu_unit[] = { {UDATA (&rtc_srv, UNIT_IDLE|UNIT_BINK|UNIT_FIX, MAXMEMSIZE)} };
+UNIT cpu_unit[] = {
+    {UDATA (&rtc_srv, UNIT_IDLE|UNIT_BINK|UNIT_FIX, MAXMEMSIZE)},
+    {UDATA (NULL, UNIT_FIX, MAXMEMSIZE/2048)},  /* Storage keys */
+    };
 
 REG cpu_reg[] = {
     { HRDATA (PC, PC, 24) },
@@ -332,6 +336,9 @@ REG cpu_reg[] = {
 MTAB cpu_mod[] = {
     { MTAB_XTD|MTAB_VDV, 0, "IDLE", "IDLE", &sim_set_idle, &sim_show_idle },
     { MTAB_XTD|MTAB_VDV, 0, NULL, "NOIDLE", &sim_clr_idle, NULL },
+    { MTAB_XTD|MTAB_VDV|MTAB_VALR|MTAB_NMO, 0, "PROFILE", "PROFILE",
+      &sim_set_profile, &sim_show_profile },
+    { MTAB_XTD|MTAB_VDV, 0, NULL, "NOPROFILE", &sim_clr_profile, NULL },
     { MTAB_VDV, MEMAMOUNT(1), NULL, "16K", &cpu_set_size },
     { MTAB_VDV, MEMAMOUNT(2), NULL, "32K", &cpu_set_size },
     { MTAB_VDV, MEMAMOUNT(4), NULL, "64K", &cpu_set_size },
@@ -375,12 +382,22 @@ MTAB cpu_mod[] = {
 
 DEVICE cpu_dev = {
     "CPU", cpu_unit, cpu_reg, cpu_mod,
-    1, 16, 24, 1, 16, 8,
+    2, 16, 24, 1, 16, 8,
     &cpu_ex, &cpu_dep, &cpu_reset, NULL, NULL, NULL,
     NULL, DEV_DEBUG, 0, dev_debug,
     NULL, NULL, &cpu_help, NULL, NULL, &cpu_description
     };
 
+/* Memory as seen by SAVE/RESTORE, M is filled in at reset */
+static MEMREGION cpu_mem_region = {
+    &cpu_dev, &cpu_unit[0], NULL, sizeof (uint32), 4, 0, 0, mem_dirty
+    };
+
+/* Storage keys, one per 2K page, saved whole as unit 1 */
+static MEMREGION key_mem_region = {
+    &cpu_dev, &cpu_unit[1], key, sizeof (uint8), 1, 0, 0, NULL
+    };
+
 void post_extirq() {
      cpu_unit[0].flags |= EXT_IRQ;
 }
@@ -409,20 +426,26 @@ void storepsw(uint32 addr, uint16 ircode) {
              switch(addr) {
              case OEPSW:
                    M[0x84 >> 2] = (M[0x84 >> 2] & 0xffff0000) | ircode;
+                   MEM_DIRTY(0x84 >> 2);
                    break;
              case OSPSW:
                    M[0x88 >> 2] = (ilc << 17) | ircode;
+                   MEM_DIRTY(0x88 >> 2);
                    break;
              case OPPSW:
                    M[0x8C >> 2] = (ilc << 17) | ircode;
+                   MEM_DIRTY(0x8C >> 2);
                    break;
              case OIOPSW:
                    M[0xB8 >> 2] = ircode;
+                   MEM_DIRTY(0xB8 >> 2);
                    break;
              }
              if (per_en && per_code) {
                 M[150 >> 2] = (M[150 >> 2] & 0xFFFF0000) | per_code;
+                MEM_DIRTY(150 >> 2);
                 M[152 >> 2] = per_addr;
+                MEM_DIRTY(152 >> 2);
              }
          } else {  /* IBM 370 under EC mode */
              word = (((uint32)dat_en) << 26) |
@@ -437,15 +460,19 @@ void storepsw(uint32 addr, uint16 ircode) {
              switch(addr) {
              case OEPSW:
                    M[0xc >> 2] = (M[0xc >> 2] & 0xffff0000) | ircode;
+                   MEM_DIRTY(0xc >> 2);
                    break;
              case OSPSW:
                    M[0x10 >> 2] = (M[0x10 >> 2] & 0x0000ffff) | ((uint32)ircode << 16);
+                   MEM_DIRTY(0x10 >> 2);
                    break;
              case OPPSW:
                    M[0x10 >> 2] = (M[0x10 >> 2] & 0xffff0000) | ircode;
+                   MEM_DIRTY(0x10 >> 2);
                    break;
              case OIOPSW:
                    M[0x14 >> 2] = (M[0x14 >> 2] & 0xffff0000) | ircode;
+                   MEM_DIRTY(0x14 >> 2);
                    break;
              }
          }
@@ -465,8 +492,10 @@ void storepsw(uint32 addr, uint16 ircode) {
                 (PC & AMASK);
      }
      M[addr >> 2] = word;
+     MEM_DIRTY(addr >> 2);
      addr += 4;
      M[addr >> 2] = word2;
+     MEM_DIRTY(addr >> 2);
      key[0] |= 0x6;
      /* Update history */
      if (hst_lnt) {
@@ -548,6 +577,7 @@ int  TransAddr(uint32 va, uint32 *pa) {
      if (seg > seg_len) {
          if (Q370) {
              M[0x90 >> 2] = va;
+             MEM_DIRTY(0x90 >> 2);
              key[0] |= 0x6;
              PC = iPC;
          } else {
@@ -570,6 +600,7 @@ int  TransAddr(uint32 va, uint32 *pa) {
          /* Check if entry valid and in correct length */
          if (entry & PTE_VALID || (page >> pte_len_shift) >= addr) {
              M[0x90 >> 2] = va;
+             MEM_DIRTY(0x90 >> 2);
              key[0] |= 0x6;
              PC = iPC;
              storepsw(OPPSW, (entry & PTE_VALID) ? IRC_SEG : IRC_PAGE);
@@ -600,6 +631,7 @@ int  TransAddr(uint32 va, uint32 *pa) {
      if ((entry & pte_mbz) != 0) {
          if (Q370) {
              M[0x90 >> 2] = va;
+             MEM_DIRTY(0x90 >> 2);
              key[0] |= 0x6;
              PC = iPC;
          } else {
@@ -613,6 +645,7 @@ int  TransAddr(uint32 va, uint32 *pa) {
      if (entry & pte_avail) {
          if (Q370) {
              M[0x90 >> 2] = va;
+             MEM_DIRTY(0x90 >> 2);
              key[0] |= 0x6;
              PC = iPC;
          } else {
@@ -844,6 +877,9 @@ int WriteFull(uint32 addr, uint32 data) {
      }
      pa >>= 2;
      pa2 >>= 2;
+     MEM_DIRTY(pa);
+     if (offset != 0)
+         MEM_DIRTY(pa2);
 
      /* Put data in correct locations */
      switch (offset) {
@@ -924,6 +960,7 @@ int WriteByte(uint32 addr, uint32 data) {
      data &= mask;
      data <<= offset;
      mask <<= offset;
+     MEM_DIRTY(pa);
      M[pa] &= ~mask;
      M[pa] |= data;
      return 0;
@@ -1017,6 +1054,8 @@ int WriteHalf(uint32 addr, uint32 data) {
         }
         pa >>= 2;
         pa2 >>= 2;
+        MEM_DIRTY(pa);
+        MEM_DIRTY(pa2);
         M[pa] &= 0xffffff00;
         M[pa] |= 0xff & (data >> 8);
         M[pa2] &= 0x00ffffff;
@@ -1024,6 +1063,7 @@ int WriteHalf(uint32 addr, uint32 data) {
         return 0;
      }
      pa >>= 2;
+     MEM_DIRTY(pa);
 
      mask = 0xffff;
      data &= mask;
@@ -1201,6 +1241,7 @@ wait_loop:
         if (sim_brk_summ && sim_brk_test(PC, SWMASK('E'))) {
            return STOP_IBKPT;
         }
+        SIM_PROFILE(PC, flags & PROBLEM);
 
         if (PC & 1) {
             ilc = 0;
@@ -3253,7 +3294,9 @@ save_dbl:
                         addr2 = (0x94 >> 2);
                         M[addr2] &= 0xffff;
                         M[addr2] |= src1 << 16;
+                        MEM_DIRTY(addr2);
                         M[0x9C >> 2] = addr1;
+                        MEM_DIRTY(0x9C >> 2);
                         key[0] |= 0x6;
                         storepsw(OPPSW, IRC_MCE);
                         goto supress;
@@ -5832,6 +5875,9 @@ t_stat cpu_reset (DEVICE *dptr)
         if (M == NULL)
             return SCPE_MEM;
     }
+    cpu_mem_region.mem = M;                 /* M moves when the size changes */
+    sim_register_mem_region (&cpu_mem_region);
+    sim_register_mem_region (&key_mem_region);
     /* Set up channels */
     chan_set_devs();
 
@@ -5887,6 +5933,7 @@ rtc_srv(UNIT * uptr)
         interval_irq = 1;
     }
     M[0x50>>2] -= 0x100;
+    MEM_DIRTY(0x50>>2);
     key[0] |= 0x6;
     sim_debug(DEBUG_INST, &cpu_dev, "TIMER = %08x\n", M[0x50>>2]);
     /* Time of day clock and timer on IBM 370 */
@@ -5939,6 +5986,13 @@ t_stat cpu_ex (t_value *vptr, t_addr exta, UNIT *uptr, int32 sw)
 
     if (vptr == NULL)
         return SCPE_ARG;
+    if (uptr == &cpu_unit[1]) {
+        /* Storage key */
+        if (addr >= uptr->capac)
+            return SCPE_NXM;
+        *vptr = key[addr];
+        return SCPE_OK;
+    }
     if (sw & SWMASK ('V')) {
         /* Virtual address, simulate LRA */
         uint32      seg;
@@ -6013,6 +6067,13 @@ t_stat cpu_dep (t_value val, t_addr exta, UNIT *uptr, int32 sw)
     uint32 word;
     uint32 mask;
 
+    if (uptr == &cpu_unit[1]) {
+        /* Storage key */
+        if (addr >= uptr->capac)
+            return SCPE_NXM;
+        key[addr] = val & 0xfe;
+        return SCPE_OK;
+    }
     if (sw & SWMASK ('V')) {
         /* Virtual address, simulate LRA */
         uint32      seg;
@@ -32,6 +32,7 @@
 #define PAMASK            (MAXMEMSIZE - 1)    /* physical addr mask */
 #define MEMSIZE           (cpu_unit[0].capac) /* actual memory size */
 #define MEM_ADDR_OK(x)    (((x)) < MEMSIZE)
+#define MEM_DIRTY(w)      SIM_SET_DIRTY(mem_dirty, (w) << 2) /* Word changed since SAVE */
 
 /* channel:
 
@@ -352,6 +353,7 @@ t_stat chan_set_devs();
 t_stat set_dev_addr(UNIT * uptr, int32 val, CONST char *cptr, void *desc);
 t_stat show_dev_addr(FILE * st, UNIT * uptr, int32 v, CONST void *desc);
 extern uint16 loading;
+extern uint8  mem_dirty[];
 extern int    irq_pend;
 
 extern const uint8 ascii_to_ebcdic[128];
@@ -652,6 +652,13 @@ static int check_nxm (uint64 data, int *n, uint64 *data2, int *n2)
     return 0;
 }
 
+static void mem_dirty_range (uint64 addr, int n)
+{
+    uint64 end = addr + n;
+    for (addr &= ~(uint64)(SIM_DIRTY_PAGE - 1); addr < end; addr += SIM_DIRTY_PAGE)
+        MEM_DIRTY(addr);
+}
+
 /* Execute one channel instruction.  It may come from a channel
    program in core, or from a DATAO DC0, */
 static void channel_command (uint64 data)
@@ -697,6 +704,7 @@ static void channel_command (uint64 data)
             if (check_nxm (data, &n, &data2, &n2))
                 break;
             M[data & ADDR] = (channel_pc + (channel_unit - ai_unit)) << 036;
+            MEM_DIRTY(data & ADDR);
             channel_pc++;
             channel_status |= DSSRUN|DSSACT;
             sim_activate(ai_unit, channel_default_delay);
@@ -723,17 +731,21 @@ static void channel_command (uint64 data)
         case MODE_READ:
             (void)sim_fread (&M[data & ADDR], sizeof(uint64), n,
                              channel_unit->fileref);
+            mem_dirty_range (data & ADDR, n);
             if (nxm)
                 break;
             (void)sim_fread (&M[data2], sizeof(uint64), n2,
                              channel_unit->fileref);
+            mem_dirty_range (data2, n2);
             print_data (&M[data & ADDR], n);
             break;
         case MODE_READ_HEADERS:
             (void)sim_freadh (&M[data & ADDR], n, channel_unit->fileref);
+            mem_dirty_range (data & ADDR, n);
             if (nxm)
                 break;
             (void)sim_freadh (&M[data2], n2, channel_unit->fileref);
+            mem_dirty_range (data2, n2);
             break;
         case MODE_WRITE:
             if (channel_unit->flags & UNIT_RO) {
@@ -813,7 +825,9 @@ static void channel_command (uint64 data)
         latency_timer = ts.tv_nsec / 100000;
         latency_timer %= 254;
         M[data & ADDR] = latency_timer & 0377;
+        MEM_DIRTY(data & ADDR);
         M[data & ADDR] |= channel_cylinder << 8;
+        MEM_DIRTY(data & ADDR);
         if (channel_unit->flags & UNIT_ATT)
             /* Drive online. */
             M[data & ADDR] |= DDSONL;
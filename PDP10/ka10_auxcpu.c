@@ -86,6 +86,8 @@ static DEBTAB auxcpu_debug[] = {
   {0},
 };
 
+DIB auxcpu_dib = { AUXCPU_DEVNUM, 1, &auxcpu_devio, NULL };
+
 DEVICE auxcpu_dev = {
   "AUXCPU", auxcpu_unit, auxcpu_reg, auxcpu_mod,
   1, 8, 16, 2, 8, 16,
@@ -95,7 +97,7 @@ DEVICE auxcpu_dev = {
   NULL,                                               /* boot */
   auxcpu_attach,                                       /* attach */
   auxcpu_detach,                                       /* detach */
-  NULL,                                               /* context */
+  &auxcpu_dib,                                         /* context */
   DEV_DISABLE | DEV_DIS | DEV_DEBUG | DEV_MUX,
   DBG_CMD,                                            /* debug control */
   auxcpu_debug,                                        /* debug flags */
@@ -109,6 +111,8 @@ DEVICE auxcpu_dev = {
 
 static TMLN auxcpu_ldsc;                                 /* line descriptor */
 static TMXR auxcpu_desc = { 1, 0, 0, &auxcpu_ldsc };      /* mux descriptor */
+static SHMEM *auxcpu_shmem = NULL;                       /* Segment when attached -M */
+static uint64 *auxcpu_shm = NULL;
 
 static t_stat auxcpu_reset (DEVICE *dptr)
 {
@@ -135,6 +139,19 @@ static t_stat auxcpu_attach (UNIT *uptr, CONST char *cptr)
     return SCPE_ARG;
   if (!(uptr->flags & UNIT_ATTABLE))
     return SCPE_NOATT;
+  if (sim_switches & SWMASK ('M')) {
+    /* PDP-6 memory is mapped here, no transactions are needed */
+    r = sim_shmem_open (cptr, SHM_WORDS * sizeof (uint64), &auxcpu_shmem,
+                        (void **)&auxcpu_shm);
+    if (r != SCPE_OK)
+      return r;
+    uptr->filename = (char *)calloc (1, strlen (cptr) + 1);
+    strcpy (uptr->filename, cptr);
+    uptr->flags |= UNIT_ATT;
+    sim_debug(DBG_TRC, &auxcpu_dev, "shared memory %s\n", cptr);
+    sim_activate (uptr, 10);
+    return SCPE_OK;
+  }
   r = tmxr_attach_ex (&auxcpu_desc, uptr, cptr, FALSE);
   if (r != SCPE_OK)                                       /* error? */
     return r;
@@ -150,6 +167,15 @@ static t_stat auxcpu_detach (UNIT *uptr)
   if (!(uptr->flags & UNIT_ATT))
     return SCPE_OK;
   sim_cancel (uptr);
+  if (auxcpu_shmem != NULL) {
+    sim_shmem_close (auxcpu_shmem);
+    auxcpu_shmem = NULL;
+    auxcpu_shm = NULL;
+    free (uptr->filename);
+    uptr->filename = NULL;
+    uptr->flags &= ~UNIT_ATT;
+    return SCPE_OK;
+  }
   r = tmxr_detach (&auxcpu_desc, uptr);
   uptr->filename = NULL;
   return r;
@@ -163,10 +189,12 @@ static void build (unsigned char *request, unsigned char octet)
 
 static t_stat auxcpu_svc (UNIT *uptr)
 {
-  tmxr_poll_rx (&auxcpu_desc);
-  if (auxcpu_ldsc.rcve && !auxcpu_ldsc.conn) {
-    auxcpu_ldsc.rcve = 0;
-    tmxr_reset_ln (&auxcpu_ldsc);
+  if (auxcpu_shm == NULL) {
+    tmxr_poll_rx (&auxcpu_desc);
+    if (auxcpu_ldsc.rcve && !auxcpu_ldsc.conn) {
+      auxcpu_ldsc.rcve = 0;
+      tmxr_reset_ln (&auxcpu_ldsc);
+    }
   }
 
   /* If incoming interrput => uptr->STATUS |= 010 */
@@ -175,7 +203,7 @@ static t_stat auxcpu_svc (UNIT *uptr)
   else
     clr_interrupt(AUXCPU_DEVNUM);
 
-  if (tmxr_poll_conn(&auxcpu_desc) >= 0) {
+  if (auxcpu_shm == NULL && tmxr_poll_conn(&auxcpu_desc) >= 0) {
     sim_debug(DBG_CMD, &auxcpu_dev, "got connection\n");
     auxcpu_ldsc.rcve = 1;
     uptr->wait = AUXCPU_POLL;
@@ -197,6 +225,12 @@ const char helpString[] =
     "\n"
     "+sim> ATTACH %U port\n"
     "\n"
+    " When both simulators run on the same host the -M switch maps the PDP-6\n"
+    " memory into this simulator instead, the name given must match the one\n"
+    " the SLAVE device on the PDP-6 is attached to.\n"
+    "\n"
+    "+sim> ATTACH -M %U name\n"
+    "\n"
     ;
 
  return scp_help (st, dptr, uptr, flag, helpString, cptr);
@@ -247,6 +281,11 @@ int auxcpu_read (t_addr addr, uint64 *data)
 
   addr &= 037777;
 
+  if (auxcpu_shm != NULL) {
+    *data = auxcpu_shm[SHM_MEM + addr] & FMASK;
+    return 0;
+  }
+
   memset (request, 0, sizeof request);
   build (request, DATI);
   build (request, addr & 0377);
@@ -287,6 +326,11 @@ int auxcpu_write (t_addr addr, uint64 data)
 
   addr &= 037777;
 
+  if (auxcpu_shm != NULL) {
+    auxcpu_shm[SHM_MEM + addr] = data & FMASK;
+    return 0;
+  }
+
   memset (request, 0, sizeof request);
   build (request, DATO);
   build (request, (addr) & 0377);
@@ -324,6 +368,11 @@ static int auxcpu_interrupt (void)
 
   sim_debug(DEBUG_IRQ, &auxcpu_dev, "PDP-10 interrupting the PDP-6\n");
 
+  if (auxcpu_shm != NULL) {
+    sim_shmem_atomic_add ((int32 *)&auxcpu_shm[SHM_IRQ], 1);
+    return 0;
+  }
+
   build (request, IRQ);
 
   transaction (request, response);
@@ -538,12 +538,14 @@ iii_svc (UNIT *uptr)
                A = (iii_instr >> 18) & RMASK;
                if ((iii_instr & 030) != 030) {
                   M[A] = temp;
+                  MEM_DIRTY(A);
                   A++;
                }
                if ((iii_instr & 020) != 020) {
                    temp = uptr->STATUS & 0377;
                    temp |= ((uint64)uptr->POS) << 8;
                    M[A] = temp;
+                   MEM_DIRTY(A);
                    A++;
                }
                if ((iii_instr & 030) != 030) {
@@ -59,6 +59,14 @@ static uint64 ten11_pager[256];
 /* Simulator time units for a Unibus memory cycle. */
 #define UNIBUS_MEM_CYCLE 100
 
+/*
+ * With ATTACH -M the PDP-11 memory is a shared segment holding the
+ * Unibus memory below the I/O page as 16 bit words in host byte order,
+ * word n at Unibus address 2n.  The PDP-11 simulator maps the same
+ * segment.  Anything above it is nonexistent memory to the PDP-10.
+ */
+#define T11SHM_WORDS    (0760000 >> 1)
+
 
 static t_stat ten11_svc (UNIT *uptr);
 static t_stat ten11_reset (DEVICE *dptr);
@@ -112,6 +120,8 @@ DEVICE ten11_dev = {
 
 static TMLN ten11_ldsc;                                 /* line descriptor */
 static TMXR ten11_desc = { 1, 0, 0, &ten11_ldsc };      /* mux descriptor */
+static SHMEM *ten11_shmem = NULL;                       /* Segment when attached -M */
+static uint16 *ten11_shm = NULL;
 
 static t_stat ten11_reset (DEVICE *dptr)
 {
@@ -122,7 +132,7 @@ static t_stat ten11_reset (DEVICE *dptr)
   ten11_desc.notelnet = TRUE;
   ten11_desc.buffered = 2048;
 
-  if (ten11_unit[0].flags & UNIT_ATT)
+  if ((ten11_unit[0].flags & UNIT_ATT) && ten11_shm == NULL)
     sim_activate_abs (&ten11_unit[0], 0);
   else
     sim_cancel (&ten11_unit[0]);
@@ -138,6 +148,18 @@ static t_stat ten11_attach (UNIT *uptr, CONST char *cptr)
     return SCPE_ARG;
   if (!(uptr->flags & UNIT_ATTABLE))
     return SCPE_NOATT;
+  if (sim_switches & SWMASK ('M')) {
+    /* Shared PDP-11 memory, nothing to poll */
+    r = sim_shmem_open (cptr, T11SHM_WORDS * sizeof (uint16), &ten11_shmem,
+                        (void **)&ten11_shm);
+    if (r != SCPE_OK)
+      return r;
+    uptr->filename = (char *)calloc (1, strlen (cptr) + 1);
+    strcpy (uptr->filename, cptr);
+    uptr->flags |= UNIT_ATT;
+    sim_debug(DBG_TRC, &ten11_dev, "shared memory %s\n", cptr);
+    return SCPE_OK;
+  }
   r = tmxr_attach_ex (&ten11_desc, uptr, cptr, FALSE);
   if (r != SCPE_OK)                                       /* error? */
     return r;
@@ -154,7 +176,13 @@ static t_stat ten11_detach (UNIT *uptr)
   if (!(uptr->flags & UNIT_ATT))
     return SCPE_OK;
   sim_cancel (uptr);
-  r = tmxr_detach (&ten11_desc, uptr);
+  if (ten11_shmem != NULL) {
+    sim_shmem_close (ten11_shmem);
+    ten11_shmem = NULL;
+    ten11_shm = NULL;
+    r = SCPE_OK;
+  } else
+    r = tmxr_detach (&ten11_desc, uptr);
   uptr->flags &= ~UNIT_ATT;
   free (uptr->filename);
   uptr->filename = NULL;
@@ -196,6 +224,13 @@ const char helpString[] =
     "\n"
     "+sim> ATTACH %U port\n"
     "\n"
+    " When the PDP-11 simulator runs on the same host and shares its memory,\n"
+    " the -M switch attaches to that shared memory segment instead.  It holds\n"
+    " the Unibus memory below the I/O page as 16 bit words, word n at address\n"
+    " 2n.  Pages mapped above it are nonexistent memory to the PDP-10.\n"
+    "\n"
+    "+sim> ATTACH -M %U name\n"
+    "\n"
     ;
 
  return scp_help (st, dptr, uptr, flag, helpString, cptr);
@@ -251,6 +286,12 @@ static int read_word (t_addr addr, int *data)
       return 0;
   }
 
+  if (ten11_shm != NULL) {
+    *data = ten11_shm[addr >> 1];
+    sim_debug (DBG_TRC, &ten11_dev, "Read word %06o\n", *data);
+    return 0;
+  }
+
   memset (request, 0, sizeof request);
   build (request, DATI);
   build (request, (addr >> 16) & 0377);
@@ -316,6 +357,11 @@ int ten11_read (t_addr addr, uint64 *data)
     unibus = (mapping & T11PDP11) >> 26;
     uaddr = ((mapping & T11ADDR) >> 10) + offset;
     uaddr <<= 2;
+    if (ten11_shm != NULL && uaddr >= (T11SHM_WORDS << 1)) {
+      sim_debug (DBG_TRC, &ten11_dev,
+                 "Read NXM: %06o not in shared memory\n", uaddr);
+      return 1;
+    }
 
     read_word (uaddr, &word1);
     read_word (uaddr + 2, &word2);
@@ -339,6 +385,11 @@ static int write_word (t_addr addr, uint16 data)
       return 0;
   }
 
+  if (ten11_shm != NULL) {
+    ten11_shm[addr >> 1] = data;
+    return 0;
+  }
+
   memset (request, 0, sizeof request);
   build (request, DATO);
   build (request, (addr >> 16) & 0377);
@@ -402,6 +453,11 @@ int ten11_write (t_addr addr, uint64 data)
     unibus = (mapping & T11PDP11) >> 26;
     uaddr = ((mapping & T11ADDR) >> 10) + offset;
     uaddr <<= 2;
+    if (ten11_shm != NULL && uaddr >= (T11SHM_WORDS << 1)) {
+      sim_debug (DBG_TRC, &ten11_dev,
+                 "Write NXM: %06o not in shared memory\n", uaddr);
+      return 1;
+    }
     sim_debug (DBG_TRC, &ten11_dev,
                "Write: (%o) %06o <- %012llo\n",
                unibus, uaddr, data);
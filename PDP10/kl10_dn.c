@@ -393,7 +393,9 @@ int i;
              sim_activate(&dn_unit[1], 200);
          }
          M[SEC_DTCHR + base] = ch;
+         MEM_DIRTY(SEC_DTCHR + base);
          M[SEC_DTMTD + base] = FMASK;
+         MEM_DIRTY(SEC_DTMTD + base);
          break;
 
      case SEC_SETPRI:
@@ -422,19 +424,24 @@ for (i = 1; i <100; i++) {
          /* Start input process */
          M[SEC_DTCMD + base] = 0;
          M[SEC_DTFLG + base] = FMASK;
+         MEM_DIRTY(SEC_DTFLG + base);
          uptr->STATUS &= ~DTE_11DB;
          return;
 
      case SEC_SETDDT: /* Read character from console */
          if (empty(&cty_in)) {
              M[SEC_DTF11 + base] = 0;
+             MEM_DIRTY(SEC_DTF11 + base);
              M[SEC_DTMTI + base] = FMASK;
+             MEM_DIRTY(SEC_DTMTI + base);
              break;
          }
          ch = cty_in.buff[cty_in.out_ptr];
          inco(&cty_in);
          M[SEC_DTF11 + base] = 0177 & ch;
+         MEM_DIRTY(SEC_DTF11 + base);
          M[SEC_DTMTI + base] = FMASK;
+         MEM_DIRTY(SEC_DTMTI + base);
          break;
 
      case SEC_CLRDDT: /* Clear DDT input mode */
@@ -447,7 +454,9 @@ for (i = 1; i <100; i++) {
 
      case SEC_RDSW:  /* Read switch register */
          M[SEC_DTSWR + base] = SW;
+         MEM_DIRTY(SEC_DTSWR + base);
          M[SEC_DTF11 + base] = SW;
+         MEM_DIRTY(SEC_DTF11 + base);
          break;
 
      case SEC_PGMCTL: /* Program control: Used by KLDCP */
@@ -470,7 +479,9 @@ for (i = 1; i <100; i++) {
      }
      /* Acknowledge command */
      M[SEC_DTCMD + base] = 0;
+     MEM_DIRTY(SEC_DTCMD + base);
      M[SEC_DTFLG + base] = FMASK;
+     MEM_DIRTY(SEC_DTFLG + base);
      uptr->STATUS &= ~DTE_11DB;
 #endif
      if (dn_dev.flags & TYPE_RSX20) {
@@ -509,6 +520,7 @@ error:
 #endif
          /* If we can't read it, go back to secondary */
          M[SEC_DTFLG + base] = FMASK;
+         MEM_DIRTY(SEC_DTFLG + base);
          uptr->STATUS |= DTE_SEC;
          uptr->STATUS &= ~DTE_11DB;
          if (dn_dev.flags & TYPE_RSX20) {
@@ -1066,7 +1078,9 @@ t_stat dni_svc (UNIT *uptr)
         ch = cty_in.buff[cty_in.out_ptr];
         inco(&cty_in);
         M[SEC_DTF11 + base] = ch;
+        MEM_DIRTY(SEC_DTF11 + base);
         M[SEC_DTMTI + base] = FMASK;
+        MEM_DIRTY(SEC_DTMTI + base);
         if (dn_dev.flags & TYPE_RSX20) {
             uptr->STATUS |= DTE_10DB;
             set_interrupt(DTE_DEVNUM, dn_unit[0].STATUS);
@@ -1115,6 +1129,7 @@ dnrtc_srv(UNIT * uptr)
         word = M[addr];
         word = (word + 1) & FMASK;
         M[addr] = word;
+        MEM_DIRTY(addr);
       sim_debug(DEBUG_EXP, &dn_dev, "DN keepalive %06o %012llo %06o\n",
                           addr, word, optr->STATUS);
     }
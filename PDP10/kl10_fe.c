@@ -677,7 +677,9 @@ void dte_second(UNIT *uptr) {
                  sim_activate(&dte_unit[1], 200);
          }
          M[SEC_DTCHR + base] = ch;
+         MEM_DIRTY(SEC_DTCHR + base);
          M[SEC_DTMTD + base] = FMASK;
+         MEM_DIRTY(SEC_DTMTD + base);
          break;
 
      case SEC_SETPRI:
@@ -696,20 +698,26 @@ enter_pri:
          cty_done = 0;
          /* Start input process */
          M[SEC_DTCMD + base] = 0;
+         MEM_DIRTY(SEC_DTCMD + base);
          M[SEC_DTFLG + base] = FMASK;
+         MEM_DIRTY(SEC_DTFLG + base);
          uptr->STATUS &= ~DTE_11DB;
          return;
 
      case SEC_SETDDT: /* Read character from console */
          if (empty(&cty_in)) {
              M[SEC_DTF11 + base] = 0;
+             MEM_DIRTY(SEC_DTF11 + base);
              M[SEC_DTMTI + base] = FMASK;
+             MEM_DIRTY(SEC_DTMTI + base);
              break;
          }
          ch = cty_in.buff[cty_in.out_ptr];
          inco(&cty_in);
          M[SEC_DTF11 + base] = 0177 & ch;
+         MEM_DIRTY(SEC_DTF11 + base);
          M[SEC_DTMTI + base] = FMASK;
+         MEM_DIRTY(SEC_DTMTI + base);
          break;
 
      case SEC_CLRDDT: /* Clear DDT input mode */
@@ -722,7 +730,9 @@ enter_pri:
 
      case SEC_RDSW:  /* Read switch register */
          M[SEC_DTSWR + base] = SW;
+         MEM_DIRTY(SEC_DTSWR + base);
          M[SEC_DTF11 + base] = SW;
+         MEM_DIRTY(SEC_DTF11 + base);
          break;
 
      case SEC_PGMCTL: /* Program control: Used by KLDCP */
@@ -755,13 +765,16 @@ enter_pri:
               break;
          case SEC_CLKRD:
               M[SEC_DTF11+base] = rtc_tick;
+              MEM_DIRTY(SEC_DTF11+base);
               break;
          }
          break;
      }
      /* Acknowledge command */
      M[SEC_DTCMD + base] = 0;
+     MEM_DIRTY(SEC_DTCMD + base);
      M[SEC_DTFLG + base] = FMASK;
+     MEM_DIRTY(SEC_DTFLG + base);
      uptr->STATUS &= ~DTE_11DB;
      if (dte_dev.flags & TYPE_RSX20) {
          uptr->STATUS |= DTE_10DB;
@@ -782,6 +795,7 @@ void dte_its(UNIT *uptr) {
      word = M[ITS_DTEINP];
      if ((word & SMASK) == 0) {
          M[ITS_DTEINP] = FMASK;
+         MEM_DIRTY(ITS_DTEINP);
          sim_debug(DEBUG_DETAIL, &dte_dev, "CTY ITS DTEINP = %012llo\n", word);
      }
      /* Check for output Start */
@@ -819,6 +833,7 @@ void dte_its(UNIT *uptr) {
              }
          }
          M[ITS_DTEOUT] = FMASK;
+         MEM_DIRTY(ITS_DTEOUT);
          uptr->STATUS |= DTE_11DN;
          set_interrupt(DTE_DEVNUM, uptr->STATUS);
          sim_debug(DEBUG_DETAIL, &dte_dev, "CTY ITS DTEOUT = %012llo\n", word);
@@ -827,6 +842,7 @@ void dte_its(UNIT *uptr) {
      word = M[ITS_DTELSP];
      if ((word & SMASK) == 0) {  /* Ready? */
          M[ITS_DTELSP] = FMASK;
+         MEM_DIRTY(ITS_DTELSP);
          sim_debug(DEBUG_DETAIL, &dte_dev, "CTY ITS DTELSP = %012llo %012llo\n", word, M[ITS_DTELPR]);
      }
      dte_input();
@@ -841,6 +857,7 @@ void dte_its(UNIT *uptr) {
          }
 #endif
          M[ITS_DTEOST] = FMASK;
+         MEM_DIRTY(ITS_DTEOST);
          sim_debug(DEBUG_DETAIL, &dte_dev, "CTY ITS DTEOST = %012llo\n", word);
      }
 }
@@ -878,6 +895,7 @@ error:
 #endif
          /* If we can't read it, go back to secondary */
          M[SEC_DTFLG + base] = FMASK;
+         MEM_DIRTY(SEC_DTFLG + base);
          uptr->STATUS |= DTE_SEC;
          uptr->STATUS &= ~DTE_11DB;
          if (dte_dev.flags & TYPE_RSX20) {
@@ -1528,6 +1546,7 @@ dte_input()
            }
            if ((word & SMASK) == 0) {
                M[ITS_DTEODN] = word;
+               MEM_DIRTY(ITS_DTEODN);
                /* Tell 10 something is ready */
                uptr->STATUS |= DTE_10DB;
                set_interrupt(DTE_DEVNUM, uptr->STATUS);
@@ -1563,6 +1582,7 @@ dte_input()
            }
            if ((word & SMASK) == 0) {
                M[ITS_DTETYI] = word;
+               MEM_DIRTY(ITS_DTETYI);
                /* Tell 10 something is ready */
                uptr->STATUS |= DTE_10DB;
                set_interrupt(DTE_DEVNUM, uptr->STATUS);
@@ -1588,6 +1608,7 @@ dte_input()
            /* Tell 10 something is ready */
            if ((word & SMASK) == 0) {
                M[ITS_DTEHNG] = word;
+               MEM_DIRTY(ITS_DTEHNG);
                uptr->STATUS |= DTE_10DB;
                set_interrupt(DTE_DEVNUM, uptr->STATUS);
                sim_debug(DEBUG_DETAIL, &dte_dev, "CTY ITS DTEHNG = %012llo\n",
@@ -1782,7 +1803,9 @@ t_stat dtei_svc (UNIT *uptr)
         ch = cty_in.buff[cty_in.out_ptr];
         inco(&cty_in);
         M[SEC_DTF11 + base] = ch;
+        MEM_DIRTY(SEC_DTF11 + base);
         M[SEC_DTMTI + base] = FMASK;
+        MEM_DIRTY(SEC_DTMTI + base);
         if (dte_dev.flags & TYPE_RSX20) {
             uptr->STATUS |= DTE_10DB;
             set_interrupt(DTE_DEVNUM, dte_unit[0].STATUS);
@@ -1832,6 +1855,7 @@ dtertc_srv(UNIT * uptr)
 #endif
             /* Set timer flag */
             M[SEC_DTCLK + base] = FMASK;
+            MEM_DIRTY(SEC_DTCLK + base);
             optr->STATUS |= DTE_10DB;
             set_interrupt(DTE_DEVNUM, optr->STATUS);
             sim_debug(DEBUG_EXP, &dte_dev, "CTY tick %x %x %06o\n",
@@ -1857,6 +1881,7 @@ dtertc_srv(UNIT * uptr)
             sim_debug(DEBUG_DETAIL, &dte_dev, "CTY ITS OFF\n");
         }
         M[ITS_DTECHK] = word;
+        MEM_DIRTY(ITS_DTECHK);
     } else
 #endif
 
@@ -1870,6 +1895,7 @@ dtertc_srv(UNIT * uptr)
         word = M[addr];
         word = (word + 1) & FMASK;
         M[addr] = word;
+        MEM_DIRTY(addr);
       sim_debug(DEBUG_EXP, &dte_dev, "CTY keepalive %06o %012llo %06o\n",
                           addr, word, optr->STATUS);
     }
@@ -93,6 +93,8 @@
 #define INTERR      07750
 #define EBSERR      07752
 
+#define NIA_BATCH   8                          /* Commands per service call */
+
 /* 12 Bit Shift */
 #define NIA_CMD_SND   0001                     /* Send a datagram */
 #define NIA_CMD_LMAC  0002                     /* Load Multicast table */
@@ -646,79 +648,92 @@ void nia_cpy_mac(uint64 word1, uint64 word2, ETH_MAC *mac)
     memcpy(mac, &m, sizeof(ETH_MAC));
 }
 
+/*
+ * Unpack n words into 4*n octets, each word holds 4 octets left justified.
+ */
+static void nia_unpack(const uint64 *src, uint8 *data, int n)
+{
+    uint32    w;
+
+    while (n-- > 0) {
+        w = (uint32)(*src++ >> 4);
+        data[0] = (uint8)(w >> 24);
+        data[1] = (uint8)(w >> 16);
+        data[2] = (uint8)(w >> 8);
+        data[3] = (uint8)w;
+        data += 4;
+    }
+}
+
+/*
+ * Pack 4*n octets into n words.
+ */
+static void nia_pack(uint64 *dst, const uint8 *data, int n)
+{
+    while (n-- > 0) {
+        *dst++ = ((uint64)((uint32)data[0] << 24 | (uint32)data[1] << 16 |
+                           (uint32)data[2] << 8 | (uint32)data[3])) << 4;
+        data += 4;
+    }
+}
+
 /*
  * Copy memory to a packet.
+ * Returns pointer past last octet, or NULL if buffer out of memory.
  */
 uint8 *nia_cpy_to(t_addr addr, uint8 *data, int len)
 {
-    uint64    word;
-    /* Copy full words */
-    while (len > 3) {
-        word = M[addr++];
-        *data++ = (uint8)((word >> 28) & 0xff);
-        *data++ = (uint8)((word >> 20) & 0xff);
-        *data++ = (uint8)((word >> 12) & 0xff);
-        *data++ = (uint8)((word >> 4) & 0xff);
-         len -= 4;
+    uint8     tail[4];
+    int       wc = len >> 2;
+
+    if (len <= 0)
+        return data;
+    if (addr + ((len + 3) >> 2) > MEMSIZE) {
+        nia_error(EBSERR);
+        return NULL;
     }
+    /* Copy full words */
+    nia_unpack(&M[addr], data, wc);
+    data += wc << 2;
+    len &= 3;
     /* Grab last partial word */
     if (len) {
-        word = M[addr++];
-        switch (len) {
-        case 3:
-                *data++ = (uint8)((word >> 28) & 0xff);
-                *data++ = (uint8)((word >> 20) & 0xff);
-                *data++ = (uint8)((word >> 12) & 0xff);
-                break;
-        case 2:
-                *data++ = (uint8)((word >> 28) & 0xff);
-                *data++ = (uint8)((word >> 20) & 0xff);
-                break;
-        case 1:
-                *data++ = (uint8)((word >> 28) & 0xff);
-                break;
-        }
+        nia_unpack(&M[addr + wc], tail, 1);
+        memcpy(data, tail, len);
+        data += len;
     }
     return data;
 }
 
 /*
  * Copy a packet to memory.
+ * Returns pointer past last octet, or NULL if buffer out of memory.
  */
 uint8 *nia_cpy_from(t_addr addr, uint8 *data, int len)
 {
-    uint64    word;
+    uint8     tail[4];
+    int       wc = (len + 3) >> 2;
+    t_addr    a;
 
-    /* Copy full words */
-    while (len > 3) {
-        word =  (uint64)(*data++) << 28;
-        word |= (uint64)(*data++) << 20;
-        word |= (uint64)(*data++) << 12;
-        word |= (uint64)(*data++) << 4;
-        M[addr++] = word;
-        len -= 4;
-    }
-    /* Copy last partial word */
-    if (len) {
-        switch (len) {
-        case 3:
-                word =  (uint64)(*data++) << 28;
-                word |= (uint64)(*data++) << 20;
-                word |= (uint64)(*data++) << 12;
-                break;
-        case 2:
-                word =  (uint64)(*data++) << 28;
-                word |= (uint64)(*data++) << 20;
-                break;
-        case 1:
-                word =  (uint64)(*data++) << 28;
-                break;
-        default:
-                word = 0;
-                break;
-        }
-        M[addr++] = word;
+    if (len <= 0)
+        return data;
+    if (addr + wc > MEMSIZE) {
+        nia_error(EBSERR);
+        return NULL;
     }
+    /* Copy full words */
+    nia_pack(&M[addr], data, len >> 2);
+    data += len & ~3;
+    /* Copy last partial word, zero filled */
+    if (len & 3) {
+        memset(tail, 0, sizeof(tail));
+        memcpy(tail, data, len & 3);
+        nia_pack(&M[addr + wc - 1], tail, 1);
+        data += len & 3;
+    }
+    for (a = addr; a < addr + wc; a += SIM_DIRTY_PAGE)
+        MEM_DIRTY(a);
+    MEM_DIRTY(addr + wc - 1);
     return data;
 }
 
@@ -1172,6 +1187,8 @@ int nia_send_pkt(uint64 cmd)
             }
             blen = (int)(tlen & 0177777);
             data = nia_cpy_to((t_addr)(word2 & AMASK), data, blen);
+            if (data == NULL)
+                return 0;
             len -= blen;
             if (Mem_read_word((t_addr)((word1 + 1) & AMASK), &word1, 0)) {
                 nia_error(EBSERR);
@@ -1180,6 +1197,8 @@ int nia_send_pkt(uint64 cmd)
         }
     } else {
         data = nia_cpy_to(nia_data.cmd_entry + 9, data, len);
+        if (data == NULL)
+            return 0;
     }
     if (((cmd & (NIA_FLG_PAD << 8)) != 0) &&
                nia_data.snd_buff.len < ETH_MIN_PACKET) {
@@ -1199,48 +1218,20 @@ int nia_send_pkt(uint64 cmd)
 }
 
 /*
- * Process commands.
+ * Perform command in cmd_entry and set cmd_rply to queue to return it on.
+ * Returns 0 if memory error.
  */
-t_stat nia_cmd_srv(UNIT * uptr)
+static int nia_do_cmd()
 {
     uint64    word1, word2;
     uint32    cmd;
     int       len, i;
     int       err;
 
-    /* See if we have command that we could not respond too */
-    if (nia_data.cmd_entry != 0) {
-       /* Have to put this either on response queue or free queue */
-       if (nia_putq(nia_data.cmd_rply, &nia_data.cmd_entry) == 0){
-           sim_activate(uptr, 200); /* Reschedule ourselves to deal with it */
-           return SCPE_OK;
-       }
-       nia_data.cmd_rply = 0;
-    }
-
-    /* Check if we are running */
-    if ((nia_data.status & NIA_MRN) == 0 || (nia_data.status & NIA_CQA) == 0) {
-        return SCPE_OK;
-    }
-
-    /* or no commands pending, just idle out */
-    /* Try to get command off queue */
-    if (nia_getq(nia_data.cmd_hdr, &nia_data.cmd_entry) == 0) {
-       sim_activate(uptr, 200); /* Reschedule ourselves to deal with it */
-       return SCPE_OK;
-    }
-
-    /* Check if we got one */
-    if (nia_data.cmd_entry == 0) {
-       /* Nothing to do */
-       nia_data.status &= ~NIA_CQA;
-       return SCPE_OK;
-    }
-
     /* Get command */
     if (Mem_read_word(nia_data.cmd_entry + 3, &word1, 0)) {
         nia_error(EBSERR);
-        return SCPE_OK;
+        return 0;
     }
     cmd = (uint32)(word1 >> 12);
     /* Save initial status */
@@ -1268,7 +1259,7 @@ t_stat nia_cmd_srv(UNIT * uptr)
              word1 = nia_data.pcnt[i];
              if (Mem_write_word(nia_data.cnt_addr + i, &word1, 0)) {
                  nia_error(EBSERR);
-                 return SCPE_OK;
+                 return 0;
              }
              if ((cmd & (NIA_FLG_CLRC << 20)) != 0)
                 nia_data.pcnt[i] = 0;
@@ -1288,11 +1279,11 @@ t_stat nia_cmd_srv(UNIT * uptr)
          word2 |= ((uint64)nia_data.mac[5]) << 20;
          if (Mem_write_word(nia_data.cmd_entry + 4, &word1, 0)) {
              nia_error(EBSERR);
-             return SCPE_OK;
+             return 0;
          }
          if (Mem_write_word(nia_data.cmd_entry + 5, &word2, 0)) {
              nia_error(EBSERR);
-             return SCPE_OK;
+             return 0;
          }
          word1 = (uint64)((nia_data.amc << 2)| (nia_data.h4000 << 1)
                                              | nia_data.prmsc);
@@ -1300,31 +1291,31 @@ t_stat nia_cmd_srv(UNIT * uptr)
          word2 = (nia_data.uver[3] << 12) |(0xF << 6)|0xF;
          if (Mem_write_word(nia_data.cmd_entry + 6, &word1, 0)) {
              nia_error(EBSERR);
-             return SCPE_OK;
+             return 0;
          }
          if (Mem_write_word(nia_data.cmd_entry + 7, &word2, 0)) {
              nia_error(EBSERR);
-             return SCPE_OK;
+             return 0;
          }
          break;
     case NIA_CMD_WNSA: /* Write Station Address */
          len = 8;
          if (Mem_read_word(nia_data.cmd_entry + 4, &word1, 0)) {
              nia_error(EBSERR);
-             return SCPE_OK;
+             return 0;
          }
          if (Mem_read_word(nia_data.cmd_entry + 5, &word2, 0)) {
              nia_error(EBSERR);
-             return SCPE_OK;
+             return 0;
          }
          nia_cpy_mac(word1, word2, &nia_data.mac);
          if (Mem_read_word(nia_data.cmd_entry + 6, &word1, 0)) {
              nia_error(EBSERR);
-             return SCPE_OK;
+             return 0;
          }
          if (Mem_read_word(nia_data.cmd_entry + 7, &word2, 0)) {
              nia_error(EBSERR);
-             return SCPE_OK;
+             return 0;
          }
          nia_data.prmsc = (int)(word1 & 1);
          nia_data.h4000 = (int)((word1 & 2) != 0);
@@ -1345,21 +1336,68 @@ t_stat nia_cmd_srv(UNIT * uptr)
     word1 = ((uint64)cmd) << 12;
     if (Mem_write_word(nia_data.cmd_entry + 3, &word1, 0)) {
         nia_error(EBSERR);
-        return SCPE_OK;
+        return 0;
     }
     if (((cmd >> 16) & 1) != 0 || (cmd & (NIA_FLG_RESP << 8)) != 0) {
        nia_data.cmd_rply = nia_data.resp_hdr;
     } else if ((cmd & 0xff) == NIA_CMD_SND) {
        if (Mem_read_word(nia_data.cmd_entry + 5, &word1, 0)) {
            nia_error(EBSERR);
-           return SCPE_OK;
+           return 0;
        }
        nia_data.cmd_rply = (t_addr)(word1 & AMASK);
     }
     for(i = 0; i < len; i++)
         sim_debug(DEBUG_DETAIL, &nia_dev, "NIA rcmd: %d %09llx %012llo\n",
                 i, M[nia_data.cmd_entry + i], M[nia_data.cmd_entry + i]);
-    (void)nia_putq(nia_data.cmd_rply, &nia_data.cmd_entry);
+    return 1;
+}
+
+/*
+ * Process commands, up to NIA_BATCH per call.
+ */
+t_stat nia_cmd_srv(UNIT * uptr)
+{
+    int       n;
+
+    /* See if we have command that we could not respond too */
+    if (nia_data.cmd_entry != 0) {
+       /* Have to put this either on response queue or free queue */
+       if (nia_putq(nia_data.cmd_rply, &nia_data.cmd_entry) == 0){
+           sim_activate(uptr, 200); /* Reschedule ourselves to deal with it */
+           return SCPE_OK;
+       }
+       nia_data.cmd_rply = 0;
+    }
+
+    for (n = 0; n < NIA_BATCH; n++) {
+        /* Check if we are running */
+        if ((nia_data.status & NIA_MRN) == 0 ||
+            (nia_data.status & NIA_CQA) == 0)
+            return SCPE_OK;
+
+        /* or no commands pending, just idle out */
+        /* Try to get command off queue */
+        if (nia_getq(nia_data.cmd_hdr, &nia_data.cmd_entry) == 0) {
+           sim_activate(uptr, 200); /* Reschedule ourselves to deal with it */
+           return SCPE_OK;
+        }
+
+        /* Check if we got one */
+        if (nia_data.cmd_entry == 0) {
+           /* Nothing to do */
+           nia_data.status &= ~NIA_CQA;
+           return SCPE_OK;
+        }
+
+        if (nia_do_cmd() == 0)
+            return SCPE_OK;
+
+        /* If reply queue busy, retry it next time */
+        if (nia_putq(nia_data.cmd_rply, &nia_data.cmd_entry) == 0)
+            break;
+        nia_data.cmd_rply = 0;
+    }
     sim_activate(uptr, 500);
     return SCPE_OK;
 }
@@ -1433,10 +1471,12 @@ nia_rec_pkt()
         nia_error(EBSERR);
         return 0;
     }
-    (void)nia_cpy_from(nia_data.rec_entry + 5,
-                         (uint8 *)&hdr->dest, sizeof(ETH_MAC));
-    (void)nia_cpy_from(nia_data.rec_entry + 7,
-                         (uint8 *)&hdr->src, sizeof(ETH_MAC));
+    if (nia_cpy_from(nia_data.rec_entry + 5,
+                         (uint8 *)&hdr->dest, sizeof(ETH_MAC)) == NULL)
+        return 0;
+    if (nia_cpy_from(nia_data.rec_entry + 7,
+                         (uint8 *)&hdr->src, sizeof(ETH_MAC)) == NULL)
+        return 0;
     word = (uint64)(((type & 0xff00) >> 4) |
                            ((type & 0xff) << 12));
     if (Mem_write_word(nia_data.rec_entry + 9, &word, 0)) {
@@ -1464,6 +1504,8 @@ nia_rec_pkt()
             return 0;
         }
         data = nia_cpy_from((t_addr)(word & AMASK), data, blen);
+        if (data == NULL)
+            return 0;
         len -= blen;
         /* Get pointer to next segment */
         if (Mem_read_word(bsd+1, &word, 0)) {
@@ -357,6 +357,8 @@ MTAB                rp_mod[] = {
     {UNIT_DTYPE, (RM03_DTYPE << UNIT_V_DTYPE), "RM03", "RM03", &rp_set_type },
     {UNIT_DTYPE, (RM05_DTYPE << UNIT_V_DTYPE), "RM05", "RM05", &rp_set_type },
     {MTAB_XTD|MTAB_VUN, 0, "FORMAT", "FORMAT", NULL, &disk_show_fmt },
+    {MTAB_XTD|MTAB_VUN|MTAB_VALR, 0, "CACHE", "CACHE", &disk_set_cache,
+              &disk_show_cache, NULL, "Sets size of cylinder cache in words" },
     {MTAB_XTD|MTAB_VDV|MTAB_VALR, 0, "addr", "addr",  &uba_set_addr, uba_show_addr,
               NULL, "Sets address of RH11" },
     {MTAB_XTD|MTAB_VDV|MTAB_VALR, 0, "vect", "vect",  &uba_set_vect, uba_show_vect,
@@ -1216,6 +1218,8 @@ t_stat rp_attach (UNIT *uptr, CONST char *cptr)
     r = disk_attach (uptr, cptr);
     if (r != SCPE_OK)
         return r;
+    disk_set_cylinder(uptr, rp_drv_tab[GET_DTYPE (uptr->flags)].sect *
+                            rp_drv_tab[GET_DTYPE (uptr->flags)].surf);
     rptr = find_dev_from_unit(uptr);
     if (rptr == 0)
         return SCPE_OK;
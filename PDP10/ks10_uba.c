@@ -219,6 +219,7 @@ uba_write_npr(t_addr addr, uint16 ctl, uint64 data)
         data &= 0177777177777;
     sim_debug(DEBUG_DATA, &cpu_dev, "Wr NPR %08o %08o %012llo\n\r", oaddr, addr, data);
     M[addr] = data;
+    MEM_DIRTY(addr);
     return 1;
 }
 
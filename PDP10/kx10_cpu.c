@@ -106,7 +106,13 @@
 #define TMR_QUA         1
 
 
+#if PDP6
+static uint64 M_local[MAXMEMSIZE];            /* Memory when not shared */
+uint64  *M = M_local;                         /* Memory */
+#else
 uint64  M[MAXMEMSIZE];                        /* Memory */
+#endif
+uint8   mem_dirty[SIM_DIRTY_BYTES(MAXMEMSIZE)]; /* Pages written since SAVE */
 #if KL | KS
 uint64  FM[128];                              /* Fast memory register */
 #elif KI
@@ -302,6 +308,64 @@ int32   tmxr_poll = 10000;
 /* Physical address range for auxiliary PDP-6. */
 #define AUXCPURANGE(addr)  ((addr) >= auxcpu_base && (addr) < (auxcpu_base + 040000))
 
+/*
+ * Instruction fetch cache.
+ *
+ * Holds the translation of the 512 word virtual page instructions were
+ * last fetched from, so straight line code is fetched without going
+ * through Mem_read and page_lookup.  Only the mapping is cached, words
+ * are always read from M, so stores and DMA need no invalidation.
+ * page_lookup offers a mapping only when the lookup had no side effects.
+ * A hit needs the same page and mode flags and an unchanged TLB entry;
+ * I/O and pager instructions and entry to sim_instr flush it.
+ */
+#define FC_NONE         ((t_addr)~0)
+#if KL
+#define FC_PAGE(a)      ((((t_addr)sect) << 9) | (((a) & RMASK) >> 9))
+#else
+#define FC_PAGE(a)      (((a) & RMASK) >> 9)
+#endif
+#if ITS
+#define FC_MODE         (USER|PURE)
+#else
+#define FC_MODE         (USER|PUBLIC)
+#endif
+#define FC_OFFER(tlb, loc)  if (!flag && (fetch || xct_flag == 0)) { \
+                                fc_new_tlb = (tlb); fc_new_loc = (loc); fc_new_wr = wr; }
+
+uint32  fc_direct = 0;                        /* Stands in for TLB of unmapped pages */
+t_addr  fc_page = FC_NONE;                    /* Virtual page in fetch cache */
+uint32  fc_mode;                              /* FLAGS & FC_MODE when loaded */
+uint64  *fc_mem;                              /* Start of physical page in M */
+uint32  *fc_tlb = &fc_direct;                 /* TLB entry mapping came from */
+uint32  fc_tlb_val;                           /* Value of TLB entry when loaded */
+uint32  *fc_new_tlb;                          /* Mapping offered by page_lookup */
+t_addr  fc_new_loc;                           /* Physical address offered */
+int     fc_new_wr;                            /* Offered mapping was checked for write */
+
+/*
+ * Data translation cache.
+ *
+ * Same idea for ordinary loads and stores: a direct mapped table indexed
+ * by virtual page giving the start of the physical page in M.  Entries
+ * are only made and used for accesses in the current context (no PI
+ * cycle or XCT mapping), a write needs an entry made by a write or
+ * read-modify-write lookup.  Entries are checked against their TLB entry
+ * like the fetch cache, fc_flush() drops them all by bumping dt_gen.
+ */
+#define DT_SIZE         512
+
+struct dt_entry {
+    t_addr   page;                            /* Virtual page */
+    uint32   mode;                            /* FLAGS & FC_MODE when loaded */
+    uint32   gen;                             /* dt_gen when loaded */
+    int      wr;                              /* Writes allowed */
+    uint64   *mem;                            /* Start of physical page in M */
+    uint32   *tlb;                            /* TLB entry mapping came from */
+    uint32   tlb_val;                         /* Value of TLB entry when loaded */
+} dt_cache[DT_SIZE];
+uint32  dt_gen = 1;                           /* Current generation of dt_cache */
+
 #if (NUM_DEVS_RP + NUM_DEVS_RS + NUM_DEVS_TU) > 0
 #if KA | KI | KL
 /* List of RH10 & RH20 devices */
@@ -565,6 +629,9 @@ REG cpu_reg[] = {
 MTAB cpu_mod[] = {
     { MTAB_XTD|MTAB_VDV, 0, "IDLE", "IDLE", &sim_set_idle, &sim_show_idle },
     { MTAB_XTD|MTAB_VDV, 0, NULL, "NOIDLE", &sim_clr_idle, NULL },
+    { MTAB_XTD|MTAB_VDV|MTAB_VALR|MTAB_NMO, 0, "PROFILE", "PROFILE",
+      &sim_set_profile, &sim_show_profile },
+    { MTAB_XTD|MTAB_VDV, 0, NULL, "NOPROFILE", &sim_clr_profile, NULL },
     { UNIT_MSIZE, 1, "16K", "16K", &cpu_set_size },
     { UNIT_MSIZE, 2, "32K", "32K", &cpu_set_size },
     { UNIT_MSIZE, 3, "48K", "48K", &cpu_set_size },
@@ -651,6 +718,40 @@ DEVICE cpu_dev = {
     NULL, NULL, &cpu_help, NULL, NULL, &cpu_description
     };
 
+/* Main memory as seen by SAVE/RESTORE; 0-17 are the fast registers */
+static MEMREGION cpu_mem_region = {
+#if PDP6
+    &cpu_dev, &cpu_unit[0], M_local, sizeof (uint64), 1, 020, FMASK, mem_dirty
+#else
+    &cpu_dev, &cpu_unit[0], M, sizeof (uint64), 1, 020, FMASK, mem_dirty
+#endif
+    };
+
+#if PDP6
+/*
+ * Move main memory to mem, or back to the private array if mem is NULL.
+ * Used by SLAVE to place memory where the PDP-10 can reach it directly.
+ * The PDP-10 stores into shared memory without marking mem_dirty, so
+ * page tracking is off while it is shared and SAVE -I writes it all.
+ */
+void cpu_set_memory(uint64 *mem)
+{
+    if (mem == NULL)
+        mem = M_local;
+    if (mem == M)
+        return;
+    memcpy(mem, M, sizeof(M_local));
+    M = mem;
+    cpu_mem_region.mem = M;
+    if (M == M_local) {
+        memset(mem_dirty, 0xFF, sizeof(mem_dirty));  /* Changed while shared */
+        cpu_mem_region.dirty = mem_dirty;
+    } else
+        cpu_mem_region.dirty = NULL;
+    fc_page = FC_NONE;                        /* fc_mem points into old M */
+}
+#endif
+
 /* Data arrays */
 #define FCE     000001   /* Fetch memory into AR */
 #define FCEPSE  000002   /* Fetch and store memory into AR */
@@ -687,6 +788,20 @@ DEVICE cpu_dev = {
 #define AOB(x)          (x + 01000001LL)
 #define SOB(x)          (x + 0777776777777LL)
 #endif
+
+/*
+ * Opcode dispatch.  With PDP10_THREADED on GCC or Clang each case of the
+ * instruction switch also records its address in op_disp when it is
+ * first reached, later executions of that opcode jump to it directly.
+ * Opcodes not yet seen go through the switch.
+ */
+#if defined(PDP10_THREADED) && PDP10_THREADED && defined(__GNUC__)
+#define THREADED        1
+#define CASE(n)         case n: op_disp[n] = &&op_##n; op_##n
+#else
+#define THREADED        0
+#define CASE(n)         case n
+#endif
 #if ITS
 #define QITS            (cpu_unit[0].flags & UNIT_ITSPAGE)
 #define QTEN11          (ten11_unit[0].flags & UNIT_ATT)
@@ -762,6 +877,21 @@ struct _byte {
 };
 #endif
 
+/*
+ * Byte pointer decode tables, filled in by byte_init().
+ *
+ * byte_inc is indexed by the P and S fields of a byte pointer and gives
+ * the 9 bit position after an increment, with BYTE_NXT set if the
+ * pointer moves to the next word.  byte_msk gives the mask for a size.
+ */
+#define BYTE_NXT        01000
+uint16  byte_inc[010000];
+uint64  byte_msk[0100];
+#if KL
+uint8   owg_inc[26];                   /* Next one word global pointer, */
+                                       /* 0100 set if next word */
+#endif
+
 #if ITS
 /*
  * Set quantum clock to qua_time.
@@ -1097,11 +1227,13 @@ update_times(int tim)
         if (temp & SMASK)
            M[eb_ptr + 0510] = (M[eb_ptr+0510] + 1) & FMASK;
         M[eb_ptr + 0511] = temp & CMASK;
+        MEM_DIRTY(eb_ptr + 0511);
         if (FLAGS & USER) {
             temp = (M[ub_ptr + 0506] & CMASK) + (tim << 12);
             if (temp & SMASK)
                M[ub_ptr + 0505] = (M[ub_ptr+0505] + 1) & FMASK;
             M[ub_ptr + 0506] = temp & CMASK;
+            MEM_DIRTY(ub_ptr + 0506);
         }
     }
 }
@@ -1740,6 +1872,97 @@ sim_debug(DEBUG_DATAIO, &cpu_dev, "Rl=%06o Pl=%06o, Rh=%06o, Ph=%06o\n", Rl, Pl,
 }
 #endif
 
+/*
+ * Drop all cached translations.
+ */
+void fc_flush() {
+    int      i;
+
+    fc_page = FC_NONE;
+    if (++dt_gen == 0) {
+        for (i = 0; i < DT_SIZE; i++)
+            dt_cache[i].gen = 0;
+        dt_gen = 1;
+    }
+}
+
+/*
+ * Look up AB in the data translation cache.
+ *
+ * Returns 1 and the physical address in loc on a hit.  On a miss clears
+ * the offer so the following page_lookup can make a new one.
+ */
+int dt_lookup(int flag, int fetch, int wr, t_addr *loc) {
+    t_addr   page = FC_PAGE(AB);
+    struct dt_entry *dt = &dt_cache[page & (DT_SIZE - 1)];
+
+    fc_new_tlb = NULL;
+    if (flag || fetch || xct_flag != 0 || sim_brk_summ
+#if KI | KL | KS
+        || page_fault
+#endif
+        )
+        return 0;
+    if (dt->page != page || dt->gen != dt_gen || (wr && !dt->wr) ||
+        dt->mode != (FLAGS & FC_MODE) || *dt->tlb != dt->tlb_val)
+        return 0;
+    *loc = (t_addr)(&dt->mem[AB & 0777] - M);
+    return 1;
+}
+
+/*
+ * Load the mapping offered by the last page_lookup into the data
+ * translation cache.
+ */
+void dt_fill(int fetch) {
+    t_addr   page = FC_PAGE(AB);
+    struct dt_entry *dt = &dt_cache[page & (DT_SIZE - 1)];
+
+    if (fetch || fc_new_tlb == NULL || (fc_new_loc | 0777) >= MEMSIZE ||
+        (fc_new_tlb != &fc_direct && *fc_new_tlb == 0))
+        return;
+    dt->page = page;
+    dt->mode = FLAGS & FC_MODE;
+    dt->gen = dt_gen;
+    dt->wr = fc_new_wr;
+    dt->mem = &M[fc_new_loc & ~0777];
+    dt->tlb = fc_new_tlb;
+    dt->tlb_val = *fc_new_tlb;
+}
+
+/*
+ * Return a pointer into M for AB if its page is in the data translation
+ * cache, for block moves.  AC addresses are never mapped.
+ */
+uint64 *dt_block(int wr) {
+    t_addr   loc;
+
+    if (AB < 020 || !dt_lookup(0, 0, wr, &loc))
+        return NULL;
+    return &M[loc];
+}
+
+/*
+ * Copy n words of a block move going up (or down) in memory.  A move
+ * that overlaps in the direction of transfer must smear words like the
+ * word at a time loop does, others give the same result as memmove.
+ */
+void dt_move(uint64 *dst, uint64 *src, int n, int up) {
+    int      i;
+
+    if (up && dst > src && dst < src + n) {
+        for (i = 0; i < n; i++)
+            dst[i] = src[i];
+    } else if (!up && dst < src && dst + n > src) {
+        for (i = n - 1; i >= 0; i--)
+            dst[i] = src[i];
+    } else {
+        memmove(dst, src, n * sizeof(uint64));
+    }
+    MEM_DIRTY(dst - M);
+    MEM_DIRTY(dst + n - 1 - M);
+}
+
 #if KS
 
 /*
@@ -1784,6 +2007,7 @@ load_tlb(int uf, int page, int wr)
         else
             data &= ~0020000LL;
         M[dbr + pg] = data;
+        MEM_DIRTY(dbr + pg);
         if ((page & 02) == 0)
             data >>= 18;
         data &= RMASK;
@@ -1901,6 +2125,7 @@ sect_loop:
                 return 0;
             }
             M[(cst & PG_MASK) + pg] = (cst_val & cst_msk) | cst_dat;
+            MEM_DIRTY((cst & PG_MASK) + pg);
         }
 
         /* Get address of page */
@@ -1970,6 +2195,7 @@ pg_loop:
                return 0;
            }
            M[(cst & PG_MASK) + pg] = (cst_val  & cst_msk) | cst_dat;
+           MEM_DIRTY((cst & PG_MASK) + pg);
         } else {
            if (acc_bits & PG_WRT) {
                cst_val = 1;
@@ -2034,6 +2260,7 @@ int page_lookup(t_addr addr, int flag, t_addr *loc, int wr, int cur_context, int
     /* If paging is not enabled, address is direct */
     if (!page_enable) {
         *loc = addr;
+        FC_OFFER(&fc_direct, addr);
         return 1;
     }
 
@@ -2097,6 +2324,7 @@ int page_lookup(t_addr addr, int flag, t_addr *loc, int wr, int cur_context, int
            sim_interval--;
            cst_val = M[(cst & PG_MASK) + pg];
            M[(cst & PG_MASK) + pg] = (cst_msk & cst_val) | cst_dat | 1;
+           MEM_DIRTY((cst & PG_MASK) + pg);
         }
         data |= KL_PAG_W;
         /* Map the page */
@@ -2161,6 +2389,7 @@ int page_lookup(t_addr addr, int flag, t_addr *loc, int wr, int cur_context, int
         return 0;
     }
 
+    FC_OFFER((uf || upmp) ? &u_tlb[page] : &e_tlb[page], *loc);
     return 1;
 }
 
@@ -2199,8 +2428,11 @@ int Mem_read(int flag, int cur_context, int fetch, int mod) {
         /* Check if invalid section */
         MB = get_reg(AB);
     } else {
-        if (!page_lookup(AB, flag, &addr, mod, cur_context, fetch))
-            return 1;
+        if (!dt_lookup(flag, fetch, mod, &addr)) {
+            if (!page_lookup(AB, flag, &addr, mod, cur_context, fetch))
+                return 1;
+            dt_fill(fetch);
+        }
         if (addr >= MEMSIZE) {
             irq_flags |= NXM_MEM;
             check_apr_irq();
@@ -2238,12 +2470,16 @@ int Mem_write(int flag, int cur_context) {
             if (sim_brk_summ && sim_brk_test(last_addr, SWMASK('W')))
                 watch_stop = 1;
             M[last_addr] = MB;
+            MEM_DIRTY(last_addr);
             modify = 0;
             return 0;
         }
 
-        if (!page_lookup(AB, flag, &addr, 1, cur_context, 0))
-            return 1;
+        if (!dt_lookup(flag, 0, 1, &addr)) {
+            if (!page_lookup(AB, flag, &addr, 1, cur_context, 0))
+                return 1;
+            dt_fill(0);
+        }
         if (addr >= MEMSIZE) {
             irq_flags |= NXM_MEM;
             check_apr_irq();
@@ -2253,6 +2489,7 @@ int Mem_write(int flag, int cur_context) {
             watch_stop = 1;
         sim_interval--;
         M[addr] = MB;
+        MEM_DIRTY(addr);
     }
     return 0;
 }
@@ -2279,6 +2516,7 @@ load_tlb(int uf, int page, int wr)
         else
             data &= ~0160000LL;
         M[dbr + pg] = data;
+        MEM_DIRTY(dbr + pg);
         if ((page & 02) == 0)
             data >>= 18;
         data &= RMASK;
@@ -2395,6 +2633,7 @@ sect_loop:
                 return 0;
             }
             M[(cst & PG_MASK) + pg] = (cst_val & cst_msk) | cst_dat;
+            MEM_DIRTY((cst & PG_MASK) + pg);
         }
 
         /* Get address of page */
@@ -2464,6 +2703,7 @@ pg_loop:
                return 0;
            }
            M[(cst & PG_MASK) + pg] = (cst_val  & cst_msk) | cst_dat;
+           MEM_DIRTY((cst & PG_MASK) + pg);
         } else {
            if (acc_bits & PG_WRT) {
                cst_val = 1;
@@ -2534,6 +2774,7 @@ int page_lookup(t_addr addr, int flag, t_addr *loc, int wr, int cur_context, int
     /* If paging is not enabled, address is direct */
     if (!page_enable) {
         *loc = addr;
+        FC_OFFER(&fc_direct, addr);
         return 1;
     }
 
@@ -2627,6 +2868,7 @@ int page_lookup(t_addr addr, int flag, t_addr *loc, int wr, int cur_context, int
            sim_interval--;
            cst_val = M[(cst & PG_MASK) + pg];
            M[(cst & PG_MASK) + pg] = (cst_msk & cst_val) | cst_dat | 1;
+           MEM_DIRTY((cst & PG_MASK) + pg);
         }
         data |= KL_PAG_W;
         /* Map the page */
@@ -2700,6 +2942,11 @@ int page_lookup(t_addr addr, int flag, t_addr *loc, int wr, int cur_context, int
     /* If fetching from public page, set public flag */
     if (fetch && ((data & KL_PAG_P) != 0))
         FLAGS |= PUBLIC;
+    /* Can't cache a portal entry or a page holding the address break */
+    if ((!pub || (data & KL_PAG_P) != 0) &&
+        ((brk_flags & 016) == 0 || ((brk_addr ^ addr) & 0777000) != 0)) {
+        FC_OFFER((uf || upmp) ? &u_tlb[page] : &e_tlb[page], *loc);
+    }
     return 1;
 }
 
@@ -2746,8 +2993,11 @@ int Mem_read(int flag, int cur_context, int fetch, int mod) {
         }
         MB = get_reg(AB);
     } else {
-        if (!page_lookup(AB, flag, &addr, mod, cur_context, fetch))
-            return 1;
+        if (!dt_lookup(flag, fetch, mod, &addr)) {
+            if (!page_lookup(AB, flag, &addr, mod, cur_context, fetch))
+                return 1;
+            dt_fill(fetch);
+        }
         if (addr >= MEMSIZE) {
             irq_flags |= NXM_MEM;
             return 1;
@@ -2793,11 +3043,15 @@ int Mem_write(int flag, int cur_context) {
             if (sim_brk_summ && sim_brk_test(last_addr, SWMASK('W')))
                 watch_stop = 1;
             M[last_addr] = MB;
+            MEM_DIRTY(last_addr);
             modify = 0;
             return 0;
         }
-        if (!page_lookup(AB, flag, &addr, 1, cur_context, 0))
-            return 1;
+        if (!dt_lookup(flag, 0, 1, &addr)) {
+            if (!page_lookup(AB, flag, &addr, 1, cur_context, 0))
+                return 1;
+            dt_fill(0);
+        }
         if (addr >= MEMSIZE) {
             irq_flags |= NXM_MEM;
             return 1;
@@ -2806,6 +3060,7 @@ int Mem_write(int flag, int cur_context) {
             watch_stop = 1;
         sim_interval--;
         M[addr] = MB;
+        MEM_DIRTY(addr);
     }
     return 0;
 }
@@ -2876,6 +3131,7 @@ int Mem_deposit_word(int n, int wrd, uint64 *data) {
     if (exec_page_lookup(addr, 1, &addr))
         return 1;
     M[addr] = *data;
+    MEM_DIRTY(addr);
     return 0;
 }
 
@@ -2906,6 +3162,7 @@ int Mem_read_byte(int n, uint16 *data, int byte) {
         val &= PMASK;
         val |= (uint64)(np) << 30;
         M[addr] = val;
+        MEM_DIRTY(addr);
         addr = val & RMASK;
         if (exec_page_lookup((int)(val & RMASK), 0, &addr))
             return 0;
@@ -2950,6 +3207,7 @@ int Mem_write_byte(int n, uint16 *data) {
         val &= PMASK;
         val |= (uint64)(np) << 30;
         M[addr] = val;
+        MEM_DIRTY(addr);
         addr = val & RMASK;
         if (exec_page_lookup((int)(val & RMASK), 1, &addr))
             return 0;
@@ -2961,6 +3219,7 @@ int Mem_write_byte(int n, uint16 *data) {
         val &= CM(msk);
         val |= msk & (((uint64)(dat >> (need - s))) << p);
         M[addr] = val;
+        MEM_DIRTY(addr);
         need -= s;
     }
     return s;
@@ -3040,6 +3299,7 @@ int page_lookup(t_addr addr, int flag, t_addr *loc, int wr, int cur_context, int
     /* If paging is not enabled, address is direct */
     if (!page_enable) {
         *loc = addr;
+        FC_OFFER(&fc_direct, addr);
         return 1;
     }
 
@@ -3079,8 +3339,11 @@ int page_lookup(t_addr addr, int flag, t_addr *loc, int wr, int cur_context, int
             page_fault = 1;
             return !wr;
         }
+        if (!pub)
+            FC_OFFER(&fc_direct, addr);
         return 1;
     }
+    /* Mapped pages are not cached, load_tlb reads the page table each time */
     data = load_tlb(uf, page);
     *loc = ((data & 017777) << 9) + (addr & 0777);
 
@@ -3149,8 +3412,11 @@ int Mem_read(int flag, int cur_context, int fetch, int mod) {
         MB = get_reg(AB);
     } else {
 read:
-        if (!page_lookup(AB, flag, &addr, 0, cur_context, fetch, mod))
-            return 1;
+        if (!dt_lookup(flag, fetch, mod, &addr)) {
+            if (!page_lookup(AB, flag, &addr, 0, cur_context, fetch, mod))
+                return 1;
+            dt_fill(fetch);
+        }
         if (addr >= MEMSIZE) {
             nxm_flag = 1;
             check_apr_irq();
@@ -3187,6 +3453,7 @@ int Mem_write(int flag, int cur_context) {
                       FM[fm_sel|AB] = MB;
                 } else {
                    M[ub_ptr + ac_stack + AB] = MB;
+                   MEM_DIRTY(ub_ptr + ac_stack + AB);
                 }
                 return 0;
             }
@@ -3197,12 +3464,16 @@ int Mem_write(int flag, int cur_context) {
             if (sim_brk_summ && sim_brk_test(last_addr, SWMASK('W')))
                 watch_stop = 1;
             M[last_addr] = MB;
+            MEM_DIRTY(last_addr);
             modify = 0;
             return 0;
         }
 write:
-        if (!page_lookup(AB, flag, &addr, 1, cur_context, 0, 0))
-            return 1;
+        if (!dt_lookup(flag, 0, 1, &addr)) {
+            if (!page_lookup(AB, flag, &addr, 1, cur_context, 0, 0))
+                return 1;
+            dt_fill(0);
+        }
         if (addr >= MEMSIZE) {
             nxm_flag = 1;
             check_apr_irq();
@@ -3212,6 +3483,7 @@ write:
             watch_stop = 1;
          sim_interval--;
         M[addr] = MB;
+        MEM_DIRTY(addr);
     }
     return 0;
 }
@@ -3251,6 +3523,7 @@ int its_load_tlb(uint32 reg, int page, uint32 *tlb) {
         data |= ((uint64)(age & 017)) << (10+18);
     }
     M[entry] = data;
+    MEM_DIRTY(entry);
     if ((page & 1) == 0)
         data >>= 18;
     data &= RMASK;
@@ -3269,11 +3542,12 @@ int page_lookup_its(t_addr addr, int flag, t_addr *loc, int wr, int cur_context,
     int      acc;
     int      uf = (FLAGS & USER) != 0;
     int      ofd = (int)fault_data;
+    uint32   *tlb = &fc_direct;
 
     /* If paging is not enabled, address is direct */
     if (!page_enable) {
         *loc = addr;
-        return 1;
+        goto offer;
     }
 
     /* Figure out if this is a user space access */
@@ -3321,8 +3595,9 @@ int page_lookup_its(t_addr addr, int flag, t_addr *loc, int wr, int cur_context,
         if ((page & 0200) == 0 || (fault_data & 04) == 0) {
         /* Direct map 0-377 or all if bit 2 off */
             *loc = addr;
-            return 1;
+            goto offer;
         }
+        tlb = &e_tlb[page - 0200];
         data = e_tlb[page - 0200];
         if (data == 0) {
             if (its_load_tlb(dbr3, page - 0200, &e_tlb[page - 0200]))
@@ -3330,6 +3605,7 @@ int page_lookup_its(t_addr addr, int flag, t_addr *loc, int wr, int cur_context,
             data = e_tlb[page - 0200];
         }
     } else {
+        tlb = &u_tlb[page];
         data = u_tlb[page];
         if (data == 0) {
             if (page & 0200) {
@@ -3352,7 +3628,7 @@ int page_lookup_its(t_addr addr, int flag, t_addr *loc, int wr, int cur_context,
            break;
     case 1:                     /* Read Only Access */
            if (!wr)
-               return 1;
+               goto offer;
            if ((fault_data & 00770) == 0)
                fault_data |= 0100;
            break;
@@ -3362,7 +3638,7 @@ int page_lookup_its(t_addr addr, int flag, t_addr *loc, int wr, int cur_context,
                break;
            }
            if (!wr)            /* Read is OK */
-               return 1;
+               goto offer;
            if ((fault_data & 00770) == 0)
                fault_data |= 040;
            break;
@@ -3371,7 +3647,7 @@ int page_lookup_its(t_addr addr, int flag, t_addr *loc, int wr, int cur_context,
                fault_data |= 0020;
                break;
            }
-           return 1;
+           goto offer;
     }
 fault:
     /* Update fault data, fault address only if new fault */
@@ -3385,6 +3661,20 @@ fault:
     }
     check_apr_irq();
     return 0;
+offer:
+    /* Can't cache a page holding the MAR or the 10-11 or PDP-6 windows */
+    if ((mar & 03000000) != 0 && ((mar ^ addr) & 0777000) == 0)
+        return 1;
+#if NUM_DEVS_TEN11 > 0
+    if (QTEN11 && T11RANGE(*loc | 0777))
+        return 1;
+#endif
+#if NUM_DEVS_AUXCPU > 0
+    if (QAUXCPU && (AUXCPURANGE(*loc & ~0777) || AUXCPURANGE(*loc | 0777)))
+        return 1;
+#endif
+    FC_OFFER(tlb, *loc);
+    return 1;
 }
 
 /*
@@ -3405,8 +3695,11 @@ int Mem_read_its(int flag, int cur_context, int fetch, int mod) {
         }
         MB = get_reg(AB);
     } else {
-        if (!page_lookup_its(AB, flag, &addr, 0, cur_context, fetch, mod))
-            return 1;
+        if (!dt_lookup(flag, fetch, mod, &addr)) {
+            if (!page_lookup_its(AB, flag, &addr, 0, cur_context, fetch, mod))
+                return 1;
+            dt_fill(fetch);
+        }
 #if NUM_DEVS_TEN11 > 0
         if (T11RANGE(addr) && QTEN11) {
             if (ten11_read (addr, &MB)) {
@@ -3424,6 +3717,7 @@ int Mem_read_its(int flag, int cur_context, int fetch, int mod) {
                 check_apr_irq();
                 return 1;
             }
+            return 0;
         }
 #endif
         if (addr >= MEMSIZE) {
@@ -3455,6 +3749,7 @@ int Mem_write_its(int flag, int cur_context) {
     if (AB < 020) {
         if ((xct_flag & 2) != 0 && !cur_context) {
             M[(ac_stack & 01777777) + AB] = MB;
+            MEM_DIRTY((ac_stack & 01777777) + AB);
             return 0;
         }
         set_reg(AB, MB);
@@ -3463,11 +3758,15 @@ int Mem_write_its(int flag, int cur_context) {
             if (sim_brk_summ && sim_brk_test(last_addr, SWMASK('W')))
                 watch_stop = 1;
             M[last_addr] = MB;
+            MEM_DIRTY(last_addr);
             modify = 0;
             return 0;
         }
-        if (!page_lookup_its(AB, flag, &addr, 1, cur_context, 0, 0))
-            return 1;
+        if (!dt_lookup(flag, 0, 1, &addr)) {
+            if (!page_lookup_its(AB, flag, &addr, 1, cur_context, 0, 0))
+                return 1;
+            dt_fill(0);
+        }
 #if NUM_DEVS_TEN11 > 0
         if (T11RANGE(addr) && QTEN11) {
             if (ten11_write (addr, MB)) {
@@ -3485,6 +3784,7 @@ int Mem_write_its(int flag, int cur_context) {
                 check_apr_irq();
                 return 1;
             }
+            return 0;
         }
 #endif
         if (addr >= MEMSIZE) {
@@ -3496,6 +3796,7 @@ int Mem_write_its(int flag, int cur_context) {
             watch_stop = 1;
         sim_interval--;
         M[addr] = MB;
+        MEM_DIRTY(addr);
     }
     return 0;
 }
@@ -3716,6 +4017,7 @@ access:
        data |= 00000400000000LL; /* Set modify */
     data |= pur;
     M[04000 + (tlb_data & 03777)] = data;
+    MEM_DIRTY(04000 + (tlb_data & 03777));
     goto access;
       /* Handle fault */
 fault_bbn:
@@ -3749,6 +4051,7 @@ fault_bbn:
        fault_data |= 040;
     page_fault = 1;
     M[mon_base_reg | 0571] = ((uint64)fault_data) << 18 | addr;
+    MEM_DIRTY(mon_base_reg | 0571);
     if (wr)
         M[mon_base_reg | 0572] = MB;
     return 0;
@@ -3813,6 +4116,7 @@ int Mem_write_bbn(int flag, int cur_context) {
         if (sim_brk_summ && sim_brk_test(last_addr, SWMASK('W')))
             watch_stop = 1;
         M[last_addr] = MB;
+        MEM_DIRTY(last_addr);
         modify = 0;
         return 0;
     }
@@ -3831,6 +4135,7 @@ int Mem_write_bbn(int flag, int cur_context) {
         watch_stop = 1;
     sim_interval--;
     M[addr] = MB;
+    MEM_DIRTY(addr);
     return 0;
 }
 #endif
@@ -3857,11 +4162,13 @@ int page_lookup_waits(t_addr addr, int flag, t_addr *loc, int wr, int cur_contex
     if (uf) {
         if (addr <= Pl) {
            *loc = (addr + Rl) & RMASK;
+           FC_OFFER(&fc_direct, *loc);
            return 1;
         }
         if ((addr & 0400000) != 0 && (addr <= Ph)) {
            if ((Pflag == 0) || (Pflag == 1 && wr == 0)) {
               *loc = (addr + Rh) & RMASK;
+              FC_OFFER(&fc_direct, *loc);
               return 1;
            }
         }
@@ -3871,6 +4178,7 @@ int page_lookup_waits(t_addr addr, int flag, t_addr *loc, int wr, int cur_contex
     } else {
         *loc = addr;
     }
+    FC_OFFER(&fc_direct, *loc);
     return 1;
 }
 
@@ -3884,8 +4192,11 @@ int Mem_read_waits(int flag, int cur_context, int fetch, int mod) {
         }
         return 0;
     }
-    if (!page_lookup_waits(AB, flag, &addr, mod, cur_context, fetch))
-        return 1;
+    if (!dt_lookup(flag, fetch, mod, &addr)) {
+        if (!page_lookup_waits(AB, flag, &addr, mod, cur_context, fetch))
+            return 1;
+        dt_fill(fetch);
+    }
     if (addr >= MEMSIZE) {
         nxm_flag = 1;
         check_apr_irq();
@@ -3921,11 +4232,15 @@ int Mem_write_waits(int flag, int cur_context) {
         if (sim_brk_summ && sim_brk_test(last_addr, SWMASK('W')))
             watch_stop = 1;
         M[last_addr] = MB;
+        MEM_DIRTY(last_addr);
         modify = 0;
         return 0;
     }
-    if (!page_lookup_waits(AB, flag, &addr, 1, cur_context, 0))
-        return 1;
+    if (!dt_lookup(flag, 0, 1, &addr)) {
+        if (!page_lookup_waits(AB, flag, &addr, 1, cur_context, 0))
+            return 1;
+        dt_fill(0);
+    }
     if (addr >= MEMSIZE) {
         nxm_flag = 1;
         check_apr_irq();
@@ -3935,6 +4250,7 @@ int Mem_write_waits(int flag, int cur_context) {
         watch_stop = 1;
     sim_interval--;
     M[addr] = MB;
+    MEM_DIRTY(addr);
     return 0;
 }
 #endif
@@ -3943,12 +4259,14 @@ int page_lookup_ka(t_addr addr, int flag, t_addr *loc, int wr, int cur_context,
       if (!flag && (FLAGS & USER) != 0) {
           if (addr <= Pl) {
              *loc = (addr + Rl) & RMASK;
+             FC_OFFER(&fc_direct, *loc);
              return 1;
           }
           if (cpu_unit[0].flags & UNIT_TWOSEG &&
              (addr & 0400000) != 0 && (addr <= Ph)) {
              if ((Pflag == 0) || (Pflag == 1 && wr == 0)) {
                 *loc = (addr + Rh) & RMASK;
+                FC_OFFER(&fc_direct, *loc);
                 return 1;
              }
           }
@@ -3958,6 +4276,7 @@ int page_lookup_ka(t_addr addr, int flag, t_addr *loc, int wr, int cur_context,
       } else {
           *loc = addr;
       }
+      FC_OFFER(&fc_direct, *loc);
       return 1;
 }
 
@@ -3967,8 +4286,11 @@ int Mem_read_ka(int flag, int cur_context, int fetch, int mod) {
     if (AB < 020) {
         MB = get_reg(AB);
     } else {
-        if (!page_lookup_ka(AB, flag, &addr, mod, cur_context, fetch))
-            return 1;
+        if (!dt_lookup(flag, fetch, mod, &addr)) {
+            if (!page_lookup_ka(AB, flag, &addr, mod, cur_context, fetch))
+                return 1;
+            dt_fill(fetch);
+        }
         if (addr >= MEMSIZE) {
             nxm_flag = 1;
             check_apr_irq();
@@ -3997,8 +4319,11 @@ int Mem_write_ka(int flag, int cur_context) {
     if (AB < 020) {
         set_reg(AB, MB);
     } else {
-        if (!page_lookup_ka(AB, flag, &addr, 1, cur_context, 0))
-            return 1;
+        if (!dt_lookup(flag, 0, 1, &addr)) {
+            if (!page_lookup_ka(AB, flag, &addr, 1, cur_context, 0))
+                return 1;
+            dt_fill(0);
+        }
         if (addr >= MEMSIZE) {
             nxm_flag = 1;
             check_apr_irq();
@@ -4008,6 +4333,7 @@ int Mem_write_ka(int flag, int cur_context) {
             watch_stop = 1;
         sim_interval--;
         M[addr] = MB;
+        MEM_DIRTY(addr);
     }
     return 0;
 }
@@ -4120,6 +4446,7 @@ int page_lookup(t_addr addr, int flag, t_addr *loc, int wr, int cur_context, int
       if (!flag && (FLAGS & USER) != 0) {
           if (addr <= Pl) {
              *loc = (addr + Rl) & RMASK;
+             FC_OFFER(&fc_direct, *loc);
              return 1;
           }
           mem_prot = 1;
@@ -4127,6 +4454,7 @@ int page_lookup(t_addr addr, int flag, t_addr *loc, int wr, int cur_context, int
       } else {
          *loc = addr;
       }
+      FC_OFFER(&fc_direct, *loc);
       return 1;
 }
 
@@ -4137,8 +4465,11 @@ int Mem_read(int flag, int cur_context, int fetch, int mod) {
     if (AB < 020) {
         MB = get_reg(AB);
     } else {
-        if (!page_lookup(AB, flag, &addr, 0, cur_context, fetch))
-            return 1;
+        if (!dt_lookup(flag, fetch, 0, &addr)) {
+            if (!page_lookup(AB, flag, &addr, 0, cur_context, fetch))
+                return 1;
+            dt_fill(fetch);
+        }
         if (addr >= MEMSIZE) {
             nxm_flag = 1;
             return 1;
@@ -4166,8 +4497,11 @@ int Mem_write(int flag, int cur_context) {
     if (AB < 020) {
         set_reg(AB, MB);
     } else {
-        if (!page_lookup(AB, flag, &addr, 1, cur_context, 0))
-            return 1;
+        if (!dt_lookup(flag, 0, 1, &addr)) {
+            if (!page_lookup(AB, flag, &addr, 1, cur_context, 0))
+                return 1;
+            dt_fill(0);
+        }
         if (addr >= MEMSIZE) {
             nxm_flag = 1;
             return 1;
@@ -4175,6 +4509,7 @@ int Mem_write(int flag, int cur_context) {
         if (sim_brk_summ && sim_brk_test(AB, SWMASK('W')))
             watch_stop = 1;
         M[addr] = MB;
+        MEM_DIRTY(addr);
     }
     return 0;
 }
@@ -4224,6 +4559,7 @@ int Mem_write_nopage() {
         }
         sim_interval--;
         M[AB] = MB;
+        MEM_DIRTY(AB);
     }
     return 0;
 }
@@ -4253,6 +4589,7 @@ int Mem_write_word(t_addr addr, uint64 *data, int ept)
     if (addr >= MEMSIZE)
         return 1;
     M[addr] = *data;
+    MEM_DIRTY(addr);
     return 0;
 }
 
@@ -4272,7 +4609,68 @@ int nlzero(uint64 w) {
     return n;
 }
 
+#if KA
+/*
+ * The KA10 picks its pager at reset through the Mem_read and Mem_write
+ * pointers.  The instruction loop is built once for each pager instead,
+ * so that its memory references are direct calls the compiler can
+ * inline.  Code outside the loop still goes through the pointers.
+ */
+#define PAGER_KA        0
+#define PAGER_ITS       1
+#define PAGER_BBN       2
+#define PAGER_WAITS     3
+
+static inline int
+Mem_read_pager(int pager, int flag, int cur_context, int fetch, int mod)
+{
+    switch (pager) {
+#if ITS
+    case PAGER_ITS:    return Mem_read_its(flag, cur_context, fetch, mod);
+#endif
+#if BBN
+    case PAGER_BBN:    return Mem_read_bbn(flag, cur_context, fetch, mod);
+#endif
+#if WAITS
+    case PAGER_WAITS:  return Mem_read_waits(flag, cur_context, fetch, mod);
+#endif
+    default:           return Mem_read_ka(flag, cur_context, fetch, mod);
+    }
+}
+
+static inline int
+Mem_write_pager(int pager, int flag, int cur_context)
+{
+    switch (pager) {
+#if ITS
+    case PAGER_ITS:    return Mem_write_its(flag, cur_context);
+#endif
+#if BBN
+    case PAGER_BBN:    return Mem_write_bbn(flag, cur_context);
+#endif
+#if WAITS
+    case PAGER_WAITS:  return Mem_write_waits(flag, cur_context);
+#endif
+    default:           return Mem_write_ka(flag, cur_context);
+    }
+}
+
+/* The threaded dispatch table keeps GCC from making copies of the loop */
+#if defined(__GNUC__) && !THREADED
+#define PAGER_INLINE    static inline __attribute__((always_inline))
+#else
+#define PAGER_INLINE    static
+#endif
+
+#define Mem_read(flag, cur_context, fetch, mod) \
+                 Mem_read_pager(pager, flag, cur_context, fetch, mod)
+#define Mem_write(flag, cur_context) \
+                 Mem_write_pager(pager, flag, cur_context)
+
+PAGER_INLINE t_stat sim_instr_pager (int pager)
+#else
 t_stat sim_instr (void)
+#endif
 {
 t_stat reason;
 int     pi_rq;                   /* Interrupt request */
@@ -4284,22 +4682,27 @@ int     f_inst_fetch;            /* Fetch new instruction */
 int     f_pc_inh;                /* Inhibit PC increment after instruction */
 int     nrf;                     /* Normalize flag */
 int     fxu_hold_set;            /* Negitive exponent */
-int     f;                       /* Temporary variables */
+int     f = 0;                   /* Temporary variables */
 int     flag1;
 int     flag3;
+uint64  *blk_src;                /* Source and destination of block moves */
+uint64  *blk_dst;
 int     instr_count = 0;         /* Number of instructions to execute */
 t_addr  IA;                      /* Initial address of first fetch */
 #if ITS | KL_ITS | KS_ITS
 char    one_p_arm = 0;           /* One proceed arm */
 #endif
+#if THREADED
+static void *op_disp[01000] = { [0 ... 0777] = &&op_switch };
+#endif
 
 if (sim_step != 0) {
     instr_count = sim_step;
     sim_cancel_step();
 }
 
-#if KS
-reason = SCPE_OK;
+#if KS | KA
+reason = SCPE_OK;                /* KA10 sim_instr builds it before entry */
 #else
 /* Build device table */
 if ((reason = build_dev_tab ()) != SCPE_OK)            /* build, chk dib_tab */
@@ -4332,6 +4735,7 @@ if ((reason = build_dev_tab ()) != SCPE_OK)            /* build, chk dib_tab */
        one_p_arm = 0;
 #endif
    watch_stop = 0;
+   fc_flush();                                           /* pager may have been changed */
 
    while ( reason == 0) {                                /* loop until ABORT */
       AIO_CHECK_EVENT;                                   /* queue async events */
@@ -4380,6 +4784,11 @@ if ((reason = build_dev_tab ()) != SCPE_OK)            /* build, chk dib_tab */
         AB = PC;
         uuo_cycle = 0;
         f_pc_inh = 0;
+#if KL
+        SIM_PROFILE((pc_sect << 18) | PC, FLAGS & USER);
+#else
+        SIM_PROFILE(PC, FLAGS & USER);
+#endif
     }
 
     if (f_inst_fetch) {
@@ -4395,18 +4804,40 @@ fetch:
            }
         }
 #endif
-       if (Mem_read(pi_cycle | uuo_cycle, 1, 1, 0)) {
+       if (FC_PAGE(AB) == fc_page && (FLAGS & FC_MODE) == fc_mode &&
+           *fc_tlb == fc_tlb_val && (pi_cycle | uuo_cycle) == 0 &&
+           AB >= 020 && !sim_brk_summ
+#if KI | KL | KS
+           && !page_fault
+#endif
+           ) {
+           /* Same page as the last fetch, skip the translation */
+           sim_interval--;
+           MB = fc_mem[AB & 0777];
+       } else {
+           fc_new_tlb = NULL;
+           if (Mem_read(pi_cycle | uuo_cycle, 1, 1, 0)) {
 #if KA | PDP6
-           pi_rq = check_irq_level();
-           if (pi_rq)
-              goto st_pi;
+               pi_rq = check_irq_level();
+               if (pi_rq)
+                  goto st_pi;
 #endif
 #if KL
-           /* Handling for PUBLIC violation */
-           if (((fault_data >> 30) & 037) == 021)
-              PC = (PC + 1) & RMASK;
+               /* Handling for PUBLIC violation */
+               if (((fault_data >> 30) & 037) == 021)
+                  PC = (PC + 1) & RMASK;
 #endif
-           goto last;
+               goto last;
+           }
+           /* Remember the mapping if page_lookup offered it */
+           if (fc_new_tlb != NULL && (fc_new_loc | 0777) < MEMSIZE &&
+               (fc_new_tlb == &fc_direct || *fc_new_tlb != 0)) {
+               fc_page = FC_PAGE(AB);
+               fc_mode = FLAGS & FC_MODE;
+               fc_mem = &M[fc_new_loc & ~0777];
+               fc_tlb = fc_new_tlb;
+               fc_tlb_val = *fc_new_tlb;
+           }
        }
 
 no_fetch:
@@ -4736,10 +5167,14 @@ st_pi:
     BR = get_reg(AC);
 
     /* Process the instruction */
+#if THREADED
+    goto *op_disp[IR];
+op_switch:
+#endif
     switch (IR) {
 #if KL
-    case 0052:  /* PMOVE */
-    case 0053:  /* PMOVEM */
+    CASE(0052):  /* PMOVE */
+    CASE(0053):  /* PMOVEM */
          if (QKLB && t20_page && (FLAGS & USER) == 0) {
              if (Mem_read(0, 0, 0, 0))
                 goto last;
@@ -4757,35 +5192,35 @@ st_pi:
           }
           /* Fall through */
 #else
-    case 0052: case 0053:
+    CASE(0052): CASE(0053):
           /* Fall through */
 #endif
 muuo:
-    case 0000: /* UUO */
-    case 0040: case 0041: case 0042: case 0043:
-    case 0044: case 0045: case 0046: case 0047:
-    case 0050: case 0051:
-    case 0054: case 0055: case 0056: case 0057:
-    case 0060: case 0061: case 0062: case 0063:
-    case 0064: case 0065: case 0066: case 0067:
-    case 0070: case 0071: case 0072: case 0073:
+    CASE(0000): /* UUO */
+    CASE(0040): CASE(0041): CASE(0042): CASE(0043):
+    CASE(0044): CASE(0045): CASE(0046): CASE(0047):
+    CASE(0050): CASE(0051):
+    CASE(0054): CASE(0055): CASE(0056): CASE(0057):
+    CASE(0060): CASE(0061): CASE(0062): CASE(0063):
+    CASE(0064): CASE(0065): CASE(0066): CASE(0067):
+    CASE(0070): CASE(0071): CASE(0072): CASE(0073):
 #if !KL_ITS
-    case 0074: case 0075: case 0076: case 0077:
+    CASE(0074): CASE(0075): CASE(0076): CASE(0077):
 #endif
 
               /* MUUO */
 
 #if KI | KL | KS
-    case 0100:  /* UJEN */
-    case 0101:
+    CASE(0100):  /* UJEN */
+    CASE(0101):
 #if !KS_ITS
-    case 0102: case 0103:
+    CASE(0102): CASE(0103):
 #endif
-    case 0104:  /* JSYS */
-    case 0106:
-    case 0107:
+    CASE(0104):  /* JSYS */
+    CASE(0106):
+    CASE(0107):
 #if !(KL_ITS | KS_ITS)
-    case 0247: /* UUO  */
+    CASE(0247): /* UUO  */
 #endif
 unasign:
               /* Save Opcode */
@@ -4923,14 +5358,14 @@ unasign:
 #endif
 
               /* LUUO */
-    case 0001: case 0002: case 0003:
-    case 0004: case 0005: case 0006: case 0007:
-    case 0010: case 0011: case 0012: case 0013:
-    case 0014: case 0015: case 0016: case 0017:
-    case 0020: case 0021: case 0022: case 0023:
-    case 0024: case 0025: case 0026: case 0027:
-    case 0030: case 0031: case 0032: case 0033:
-    case 0034: case 0035: case 0036: case 0037:
+    CASE(0001): CASE(0002): CASE(0003):
+    CASE(0004): CASE(0005): CASE(0006): CASE(0007):
+    CASE(0010): CASE(0011): CASE(0012): CASE(0013):
+    CASE(0014): CASE(0015): CASE(0016): CASE(0017):
+    CASE(0020): CASE(0021): CASE(0022): CASE(0023):
+    CASE(0024): CASE(0025): CASE(0026): CASE(0027):
+    CASE(0030): CASE(0031): CASE(0032): CASE(0033):
+    CASE(0034): CASE(0035): CASE(0036): CASE(0037):
 #if KL
               /* LUUO's in non-zero section are different */
               if (QKLB && t20_page && pc_sect != 0) {
@@ -4997,8 +5432,8 @@ unasign:
               f_pc_inh = 1;
               break;
 #if KL_ITS
-    case 0074:     /* XCTR */
-    case 0075:     /* XCTRI */
+    CASE(0074):     /* XCTR */
+    CASE(0075):     /* XCTRI */
               if (QITS && (FLAGS & USER) == 0) {
                    f_load_pc = 0;
                    f_pc_inh = 1;
@@ -5007,7 +5442,7 @@ unasign:
               }
               goto unasign;
 
-    case 0076:     /* LMR */
+    CASE(0076):     /* LMR */
               if (QITS && (FLAGS & USER) == 0) {
                   /* Load store ITS pager info */
                   if ((AB + 8) >= MEMSIZE) {
@@ -5030,36 +5465,42 @@ unasign:
                   dbr2 = MB;
                   for (f = 0; f < 512; f++)
                       u_tlb[f] = 0;
+                  fc_flush();
                   break;
               }
               goto unasign;
-    case 0077:     /* SPM */
+    CASE(0077):     /* SPM */
               if (QITS && (FLAGS & USER) == 0) {
                   if ((AB + 8) >= MEMSIZE) {
                      break;
                   }
                   MB = (uint64)jpc;
                   M[AB] = MB;                 /* WD 0 */
+                  MEM_DIRTY(AB);
                   AB = (AB + 1) & RMASK;
                   MB = (uint64)brk_addr;
                   MB |= ((uint64)brk_flags) << 23;
                   M[AB] = MB;                 /* WD 1 */
+                  MEM_DIRTY(AB);
                   AB = (AB + 1) & RMASK;
                   MB = FM[(6<<4)|0];
                   M[AB] = MB;                 /* WD 2 */
+                  MEM_DIRTY(AB);
                   AB = (AB + 1) & RMASK;
                   MB = dbr1;
                   M[AB] = MB;                 /* WD 3 */
+                  MEM_DIRTY(AB);
                   AB = (AB + 1) & RMASK;
                   MB = dbr2;
                   M[AB] = MB;                 /* WD 4 */
+                  MEM_DIRTY(AB);
                   break;
               }
               goto unasign;
 #endif
 #if KS_ITS
-    case 0102: /* XCT */
-    case 0103: /* XCTI */
+    CASE(0102): /* XCT */
+    CASE(0103): /* XCTI */
               if (QITS && (FLAGS & USER) == 0) {
                    f_load_pc = 0;
                    f_pc_inh = 1;
@@ -5072,7 +5513,7 @@ unasign:
 
 #if KI | KL | KS
 #if KL | KS
-    case 0105:       /* ADJSP */
+    CASE(0105):       /* ADJSP */
               AR &= RMASK;
 #if KL
               if (QKLB && t20_page && pc_sect != 0 && (BR & SMASK) == 0 && (BR & SECTM) != 0) {
@@ -5092,8 +5533,8 @@ unasign:
               break;
 #endif
 
-    case 0110:       /* DFAD */
-    case 0111:       /* DFSB */
+    CASE(0110):       /* DFAD */
+    CASE(0111):       /* DFSB */
               /* On Load AR,MQ has memory operand */
               /* AR,MQ = AC  BR,MB  = mem */
                     /* AR High */
@@ -5212,7 +5653,7 @@ dpnorm:
               set_reg(AC+1, MQ);
               break;
 
-    case 0112: /* DFMP */
+    CASE(0112): /* DFMP */
               /* On Load AR,MQ has memory operand */
               /* AR,MQ = AC  BR,MB  = mem */
                     /* AR High */
@@ -5342,7 +5783,7 @@ dpnorm:
               set_reg(AC+1, MQ);
               break;
 
-    case 0113: /* DFDV */
+    CASE(0113): /* DFDV */
               /* On Load AR,MQ has memory operand */
               /* AR,MQ = AC  BR,MB  = mem */
                     /* AR High */
@@ -5450,7 +5891,7 @@ dpnorm:
               break;
 
 #if KL | KS
-    case 0114: /* DADD */
+    CASE(0114): /* DADD */
               flag1 = flag3 = 0;
               /* AR,ARX = AC  BR,BX  = mem */
                     /* AR High */
@@ -5487,7 +5928,7 @@ dpnorm:
               set_reg(AC+1, ARX);
               break;
 
-    case 0115: /* DSUB */
+    CASE(0115): /* DSUB */
               flag1 = flag3 = 0;
               /* AR,AX = AC  BR,BX  = mem */
                     /* AR High */
@@ -5524,7 +5965,7 @@ dpnorm:
               set_reg(AC+1, ARX);
               break;
 
-    case 0116: /* DMUL */
+    CASE(0116): /* DMUL */
               flag1 = flag3 = 0;
               /* AR,ARX = AC  BR,BRX  = mem */
                     /* AR High */
@@ -5617,7 +6058,7 @@ dpnorm:
               set_reg(AC+3, BRX);
               break;
 
-    case 0117: /* DDIV */
+    CASE(0117): /* DDIV */
               flag1 = flag3 = 0;
               /* AR,ARX = AC  BR,BRX  = mem */
                     /* AR High */
@@ -5726,14 +6167,14 @@ dpnorm:
               break;
 
 #else
-    case 0114: /* DADD */
-    case 0115: /* DSUB */
-    case 0116: /* DMUL */
-    case 0117: /* DDIV */
+    CASE(0114): /* DADD */
+    CASE(0115): /* DSUB */
+    CASE(0116): /* DMUL */
+    CASE(0117): /* DDIV */
               goto unasign;
 #endif
 
-    case 0120: /* DMOVE */
+    CASE(0120): /* DMOVE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -5745,7 +6186,7 @@ dpnorm:
               set_reg(AC+1, MQ);
               break;
 
-    case 0121: /* DMOVN */
+    CASE(0121): /* DMOVN */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -5779,7 +6220,7 @@ dpnorm:
               set_reg(AC+1, MQ);
               break;
 
-    case 0123:  /* Extend */
+    CASE(0123):  /* Extend */
 #if KL | KS
               /* Handle like xct */
               f_load_pc = 0;
@@ -5794,7 +6235,7 @@ dpnorm:
               goto unasign;
 #endif
 
-    case 0124: /* DMOVEM */
+    CASE(0124): /* DMOVEM */
 #if KS
               MQ = get_reg(AC + 1);
               if ((FLAGS & BYTI) == 0) {
@@ -5834,7 +6275,7 @@ dpnorm:
 #endif
               break;
 
-    case 0125: /* DMOVNM */
+    CASE(0125): /* DMOVNM */
               AR = get_reg(AC);
               MQ = get_reg(AC + 1);
               /* Handle each half as seperate instruction */
@@ -5896,8 +6337,8 @@ dpnorm:
               }
               break;
 
-    case 0122: /* FIX */
-    case 0126: /* FIXR */
+    CASE(0122): /* FIX */
+    CASE(0126): /* FIXR */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -5931,7 +6372,7 @@ dpnorm:
               set_reg(AC, AR & FMASK);
               break;
 
-    case 0127: /* FLTR */
+    CASE(0127): /* FLTR */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -5944,7 +6385,7 @@ dpnorm:
               SC = 162;
               goto fnorm;
 #else
-    case 0100: /* TENEX UMOVE */
+    CASE(0100): /* TENEX UMOVE */
 #if BBN
               if (QBBN) {
                    if (Mem_read(0, 0, 0, 0)) {
@@ -5958,7 +6399,7 @@ dpnorm:
               }
 #endif
               goto unasign;
-    case 0101: /* TENEX UMOVEI */
+    CASE(0101): /* TENEX UMOVEI */
 #if BBN
               if (QBBN) {
                    set_reg(AC, AR);
@@ -5967,7 +6408,7 @@ dpnorm:
               }
 #endif
               goto unasign;
-    case 0102: /* TENEX UMOVEM */ /* ITS LPM */
+    CASE(0102): /* TENEX UMOVEM */ /* ITS LPM */
 #if ITS
               if (QITS && (FLAGS & USER) == 0) {
                   /* Load store ITS pager info */
@@ -5982,29 +6423,37 @@ dpnorm:
                             ((uint64)fault_addr & 0777) << 18 |
                             (uint64)jpc;
                       M[AB] = MB;
+                      MEM_DIRTY(AB);
                       AB = (AB + 1) & RMASK;
                       MB = opc;
                       M[AB] = MB;
+                      MEM_DIRTY(AB);
                       AB = (AB + 1) & RMASK;
                       MB = (mar & 00777607777777LL) | ((uint64)pag_reload) << 21;
                       M[AB] = MB;
+                      MEM_DIRTY(AB);
                       AB = (AB + 1) & RMASK;
                       MB = ((uint64)get_quantum()) | ((uint64)fault_data) << 18;
                       M[AB] = MB;
+                      MEM_DIRTY(AB);
                       AB = (AB + 1) & RMASK;
                       MB = ((uint64)fault_addr & 00760000) << 13 |
                             (uint64)dbr1;
                       M[AB] = MB;
+                      MEM_DIRTY(AB);
                       AB = (AB + 1) & RMASK;
                       MB = ((uint64)fault_addr & 00037000) << 17 |
                             (uint64)dbr2;
                       M[AB] = MB;
+                      MEM_DIRTY(AB);
                       AB = (AB + 1) & RMASK;
                       MB = (uint64)dbr3;
                       M[AB] = MB;
+                      MEM_DIRTY(AB);
                       AB = (AB + 1) & RMASK;
                       MB = (uint64)ac_stack;
                       M[AB] = MB;
+                      MEM_DIRTY(AB);
                   } else {
                       if ((AB + 8) >= MEMSIZE) {
                          fault_data |= 0400;
@@ -6046,6 +6495,7 @@ dpnorm:
                       MB = M[AB];                /* WD 7 */
                       ac_stack = (uint32)MB;
                       page_enable = 1;
+                      fc_flush();
                   }
                   /* AC & 2 = Clear TLB */
                   if (AC & 2) {
@@ -6073,7 +6523,7 @@ dpnorm:
 #endif
               goto unasign;
 
-    case 0103: /* TENEX UMOVES */ /* ITS XCTR */
+    CASE(0103): /* TENEX UMOVES */ /* ITS XCTR */
 #if ITS
               if (QITS && (FLAGS & USER) == 0) {
                    /* AC & 1 = Read User */
@@ -6103,7 +6553,7 @@ dpnorm:
               goto unasign;
 
               /* MUUO */
-    case 0104: /* TENEX JSYS */
+    CASE(0104): /* TENEX JSYS */
 #if BBN
               if (QBBN) {
                    BR = ((uint64)(FLAGS) << 23) | ((PC + !pi_cycle) & RMASK);
@@ -6130,7 +6580,7 @@ dpnorm:
 #endif
               goto unasign;
 
-    case 0247: /* UUO  or ITS CIRC instruction */
+    CASE(0247): /* UUO  or ITS CIRC instruction */
 #if ITS | KL_ITS | KS_ITS
               if (QITS) {
                   BR = AR & RMASK;
@@ -6171,13 +6621,13 @@ dpnorm:
 #endif
 
                /* UUO */
-    case 0105: case 0106: case 0107:
-    case 0110: case 0111: case 0112: case 0113:
-    case 0114: case 0115: case 0116: case 0117:
-    case 0120: case 0121: case 0122: case 0123:
-    case 0124: case 0125: case 0126: case 0127:
+    CASE(0105): CASE(0106): CASE(0107):
+    CASE(0110): CASE(0111): CASE(0112): CASE(0113):
+    CASE(0114): CASE(0115): CASE(0116): CASE(0117):
+    CASE(0120): CASE(0121): CASE(0122): CASE(0123):
+    CASE(0124): CASE(0125): CASE(0126): CASE(0127):
 #if PDP6
-    case 0130:  /* UFA */
+    CASE(0130):  /* UFA */
 #endif
 
 unasign:
@@ -6198,7 +6648,7 @@ unasign:
               break;
 #endif
 
-    case 0133: /* IBP/ADJBP */
+    CASE(0133): /* IBP/ADJBP */
 #if KL | KS
               if (AC != 0) { /* ADJBP */
                   if (Mem_read(0, 0, 0, 0))
@@ -6282,8 +6732,8 @@ unasign:
                   break;
               }
 #endif
-    case 0134: /* ILDB */
-    case 0136: /* IDPB */
+    CASE(0134): /* ILDB */
+    CASE(0136): /* IDPB */
               if ((FLAGS & BYTI) == 0) {      /* BYF6 */
 #if KL | KS
                   if (Mem_read(0, 0, 0, 1)) {
@@ -6305,16 +6755,10 @@ unasign:
                       if (SCAD == 077)
                           goto muuo;
                       SC = _byte_adj[f].s;
-                      SCAD = (_byte_adj[f].p + (0777 ^ SC) + 1) & 0777;
-                      f++;
-                      if (SCAD & 0400) {
-                          SCAD = ((0777 ^ SC) + 044 + 1) & 0777;
+                      if (owg_inc[f] & 0100)
                           AR++;
-                          for(f = 0; f < 28; f++) {
-                             if (_byte_adj[f].s == SC && _byte_adj[f].p == SCAD)
-                                 break;
-                          }
-                      }
+                      f = owg_inc[f] & 077;
+                      SCAD = _byte_adj[f].p;
                       AR &= (SECTM|RMASK);
                       AR |= ((uint64)(f + 37)) << 30;
                       MB = AR;
@@ -6326,9 +6770,9 @@ unasign:
                   }
 #endif
                   SC = (AR >> 24) & 077;
-                  SCAD = (SCAD + (0777 ^ SC) + 1) & 0777;
-                  if (SCAD & 0400) {
-                      SCAD = ((0777 ^ SC) + 044 + 1) & 0777;
+                  SCAD = byte_inc[(AR >> 24) & 07777];
+                  if (SCAD & BYTE_NXT) {
+                      SCAD &= 0777;
 #if KL
                       if (QKLB && t20_page && pc_sect != 0 && (AR & BIT12) != 0) { /* Full pointer */
                           AB = (AB + 1) & RMASK;
@@ -6372,8 +6816,8 @@ unasign:
               }
               /* Fall through */
 
-    case 0135:/* LDB */
-    case 0137:/* DPB */
+    CASE(0135):/* LDB */
+    CASE(0137):/* DPB */
               if ((FLAGS & BYTI) == 0 || !BYF5) {
 #if KL | KS
                   if (Mem_read(0, 0, 0, 0))
@@ -6447,8 +6891,7 @@ ld_exe:
                       f = 1;
 #endif
                   AB = AR & RMASK;
-                  MQ = (uint64)(1) << SC;
-                  MQ -= 1;
+                  MQ = byte_msk[SC];
                   if (Mem_read(0, 0, 0, f))
                       goto last;
                   AR = MB;
@@ -6471,7 +6914,7 @@ ld_exe:
               }
               break;
 
-    case 0131:/* DFN FCE|FAC */
+    CASE(0131):/* DFN FCE|FAC */
 
 #if !PDP6
               if (Mem_read(0, 0, 0, 0))
@@ -6494,7 +6937,7 @@ ld_exe:
 #endif
               break;
 
-    case 0132:/* FSC FAC|SAC */
+    CASE(0132):/* FSC FAC|SAC */
               BR = AR & RMASK;
               AR = get_reg(AC);
               SC = ((AB & RSIGN) ? 0400 : 0) | (AB & 0377);
@@ -6537,14 +6980,14 @@ ld_exe:
 #endif
 
 
-    case 0150:  /* FSB */   /* SAC|FCE|FBR */
-    case 0151:  /* FSBL */  /* SAC|SAC2|FCE|FBR */
-    case 0152:  /* FSBM */  /* FCEPSE|FBR */
-    case 0153:  /* FSBB */  /* SAC|FBR|FCEPSE */
-    case 0154:  /* FSBR */  /* SAC|FCE|FBR */
-    case 0155:  /* FSBRI, FSBRL on PDP6 */ /* SAC|SWAR|FBR  SAC|SAC2|FCE|FBR */
-    case 0156:  /* FSBRM */ /* FBR|FCEPSE */
-    case 0157:  /* FSBRB */ /* SAC|FBR|FCEPSE */
+    CASE(0150):  /* FSB */   /* SAC|FCE|FBR */
+    CASE(0151):  /* FSBL */  /* SAC|SAC2|FCE|FBR */
+    CASE(0152):  /* FSBM */  /* FCEPSE|FBR */
+    CASE(0153):  /* FSBB */  /* SAC|FBR|FCEPSE */
+    CASE(0154):  /* FSBR */  /* SAC|FCE|FBR */
+    CASE(0155):  /* FSBRI, FSBRL on PDP6 */ /* SAC|SWAR|FBR  SAC|SAC2|FCE|FBR */
+    CASE(0156):  /* FSBRM */ /* FBR|FCEPSE */
+    CASE(0157):  /* FSBRB */ /* SAC|FBR|FCEPSE */
 
               switch (IR & 07) {
               case 5:
@@ -6577,19 +7020,19 @@ ld_exe:
               /* Fall through */
 
 #if !PDP6
-    case 0130:  /* UFA */  /* FCE|FBR */
+    CASE(0130):  /* UFA */  /* FCE|FBR */
 #endif
 #if WAITS
 ufa:
 #endif
-    case 0140:  /* FAD */ /* SAC|FCE|FBR */
-    case 0141:  /* FADL */ /* SAC|SAC2|FCE|FBR */
-    case 0142:  /* FADM */ /* FCEPSE|FBR */
-    case 0143:  /* FADB */ /* SAC|FBR|FCEPSE */
-    case 0144:  /* FADR */ /* SAC|FCE|FBR */
-    case 0145:  /* FADRI FADRL on PDP6 */ /* SAC|SWAR|FBR  SAC|SAC2|FCE|FBR */
-    case 0146:  /* FADRM*/ /* FBR|FCEPSE */
-    case 0147:  /* FADRB*/ /* SAC|FBR|FCEPSE */
+    CASE(0140):  /* FAD */ /* SAC|FCE|FBR */
+    CASE(0141):  /* FADL */ /* SAC|SAC2|FCE|FBR */
+    CASE(0142):  /* FADM */ /* FCEPSE|FBR */
+    CASE(0143):  /* FADB */ /* SAC|FBR|FCEPSE */
+    CASE(0144):  /* FADR */ /* SAC|FCE|FBR */
+    CASE(0145):  /* FADRI FADRL on PDP6 */ /* SAC|SWAR|FBR  SAC|SAC2|FCE|FBR */
+    CASE(0146):  /* FADRM*/ /* FBR|FCEPSE */
+    CASE(0147):  /* FADRB*/ /* SAC|FBR|FCEPSE */
               switch (IR & 07) {
               case 5:
 #if !PDP6
@@ -6838,14 +7281,14 @@ fnormx:
               }
               break;
 
-    case 0160:      /* FMP */ /* SAC|FCE|FBR */
-    case 0161:      /* FMPL */ /* SAC|SAC2|FCE|FBR */
-    case 0162:      /* FMPM */ /* FCEPSE|FBR */
-    case 0163:      /* FMPB */ /* SAC|FBR|FCEPSE */
-    case 0164:      /* FMPR */ /* SAC|FCE|FBR */
-    case 0165:      /* FMPRI FMPRL on PDP6 */ /* SAC|SWAR|FBR  SAC|SAC2|FCE|FBR */
-    case 0166:      /* FMPRM */ /* FBR|FCEPSE */
-    case 0167:      /* FMPRB */ /* SAC|FBR|FCEPSE */
+    CASE(0160):      /* FMP */ /* SAC|FCE|FBR */
+    CASE(0161):      /* FMPL */ /* SAC|SAC2|FCE|FBR */
+    CASE(0162):      /* FMPM */ /* FCEPSE|FBR */
+    CASE(0163):      /* FMPB */ /* SAC|FBR|FCEPSE */
+    CASE(0164):      /* FMPR */ /* SAC|FCE|FBR */
+    CASE(0165):      /* FMPRI FMPRL on PDP6 */ /* SAC|SWAR|FBR  SAC|SAC2|FCE|FBR */
+    CASE(0166):      /* FMPRM */ /* FBR|FCEPSE */
+    CASE(0167):      /* FMPRB */ /* SAC|FBR|FCEPSE */
               switch (IR & 07) {
               case 5:
 #if !PDP6
@@ -6913,15 +7356,15 @@ fnormx:
 #endif
               goto fnorm;
 
-    case 0170:      /* FDV */ /* SAC|FCE|FBR */
-    case 0172:      /* FDVM */ /* FCEPSE|FBR */
-    case 0173:      /* FDVB */ /* SAC|FCEPSE|FBR */
-    case 0174:      /* FDVR */ /* SAC|FBR|FCE */
+    CASE(0170):      /* FDV */ /* SAC|FCE|FBR */
+    CASE(0172):      /* FDVM */ /* FCEPSE|FBR */
+    CASE(0173):      /* FDVB */ /* SAC|FCEPSE|FBR */
+    CASE(0174):      /* FDVR */ /* SAC|FBR|FCE */
 #if !PDP6
-    case 0175:      /* FDVR FDVL on PDP6 */ /* SAC|SWAR|FBR */
+    CASE(0175):      /* FDVR FDVL on PDP6 */ /* SAC|SWAR|FBR */
 #endif
-    case 0176:      /* FDVRM*/ /* FBR|FCEPSE */
-    case 0177:      /* FDVRB */ /* SAC|FBR|FCEPSE */
+    CASE(0176):      /* FDVRM*/ /* FBR|FCEPSE */
+    CASE(0177):      /* FDVRB */ /* SAC|FBR|FCEPSE */
               switch (IR & 07) {
               case 5:
 #if !PDP6
@@ -7132,11 +7575,11 @@ fnormx:
               }
               break;
 
-    case 0171:      /* FDVL */ /* SAC|SAC2|FAC2|FCE|FBR */
+    CASE(0171):      /* FDVL */ /* SAC|SAC2|FAC2|FCE|FBR */
 #if KS
               goto muuo;
 #elif PDP6
-    case 0175:      /* FDVRL */ /* SAC|SAC2|FAC2||FCE|FBR */
+    CASE(0175):      /* FDVRL */ /* SAC|SAC2|FAC2||FCE|FBR */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -7360,7 +7803,7 @@ left:
               break;
 
                    /* FWT */
-    case 0200:     /* MOVE */   /* SAC|FCE */
+    CASE(0200):     /* MOVE */   /* SAC|FCE */
               if (Mem_read(0, 0, 0, 0)) {
                   goto last;
               }
@@ -7368,19 +7811,19 @@ left:
               set_reg(AC, AR);
               break;
 
-    case 0201:     /* MOVEI */  /* SAC */
+    CASE(0201):     /* MOVEI */  /* SAC */
               AR &= RMASK;
               set_reg(AC, AR);
               break;
 
-    case 0202:     /* MOVEM */  /* FAC|SCE */
+    CASE(0202):     /* MOVEM */  /* FAC|SCE */
               MB = BR;
               if (Mem_write(0, 0)) {
                  goto last;
               }
               break;
 
-    case 0203:     /* MOVES */  /* SACZ|FCEPSE */
+    CASE(0203):     /* MOVES */  /* SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1)) {
                   goto last;
               }
@@ -7392,7 +7835,7 @@ left:
                   set_reg(AC, AR);
               break;
 
-    case 0204:     /* MOVS */   /* SWAR|SAC|FCE */
+    CASE(0204):     /* MOVS */   /* SWAR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0)) {
                   goto last;
               }
@@ -7401,13 +7844,13 @@ left:
               set_reg(AC, AR);
               break;
 
-    case 0205:     /* MOVSI */  /* SWAR|SAC */
+    CASE(0205):     /* MOVSI */  /* SWAR|SAC */
               AR &= RMASK;
               AR = SWAP_AR;
               set_reg(AC, AR);
               break;
 
-    case 0206:     /* MOVSM */  /* SWAR|FAC|SCE */
+    CASE(0206):     /* MOVSM */  /* SWAR|FAC|SCE */
               AR = get_reg(AC);
               AR = SWAP_AR;
               MB = AR;
@@ -7416,7 +7859,7 @@ left:
               }
               break;
 
-    case 0207:     /* MOVSS */  /* SWAR|SACZ|FCEPSE */
+    CASE(0207):     /* MOVSS */  /* SWAR|SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1)) {
                   goto last;
               }
@@ -7460,7 +7903,7 @@ left:
               AR = AD & FMASK;
 #endif
 
-    case 0214:     /* MOVM */  /* SAC|FCE */
+    CASE(0214):     /* MOVM */  /* SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -7478,12 +7921,12 @@ left:
               set_reg(AC, AR);
               break;
 
-    case 0215:     /* MOVMI */ /* SAC */
+    CASE(0215):     /* MOVMI */ /* SAC */
               AR &= RMASK;
               set_reg(AC, AR);
               break;
 
-    case 0216:     /* MOVMM */ /* FAC|SCE */
+    CASE(0216):     /* MOVMM */ /* FAC|SCE */
               AR = get_reg(AC);
               if ((AR & SMASK) != 0) {
                        NEG;
@@ -7502,7 +7945,7 @@ left:
               }
               break;
 
-    case 0217:     /* MOVMS */ /* SACZ|FCEPSE */
+    CASE(0217):     /* MOVMS */ /* SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -7525,7 +7968,7 @@ left:
                   set_reg(AC, AR);
               break;
 
-    case 0210:     /* MOVN */   /* SAC|FCE */
+    CASE(0210):     /* MOVN */   /* SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -7541,7 +7984,7 @@ left:
               set_reg(AC, AR);
               break;
 
-    case 0211:     /* MOVNI */  /* SAC */
+    CASE(0211):     /* MOVNI */  /* SAC */
               AR &= RMASK;
               NEG;
 #if PDP6 | KA
@@ -7555,7 +7998,7 @@ left:
               set_reg(AC, AR);
               break;
 
-    case 0212:     /* MOVNM */  /* SCE|FAC */
+    CASE(0212):     /* MOVNM */  /* SCE|FAC */
               AR = get_reg(AC);
               NEG;
 #if PDP6 | KA
@@ -7572,7 +8015,7 @@ left:
               }
               break;
 
-    case 0213:     /* MOVNS */  /* SACZ|FCEPSE */
+    CASE(0213):     /* MOVNS */  /* SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -7593,14 +8036,14 @@ left:
                   set_reg(AC, AR);
               break;
 
-    case 0220:      /* IMUL */   /* SAC|FCE|FBR */
-    case 0221:      /* IMULI */  /* SAC|FBR */
-    case 0222:      /* IMULM */  /* FCEPSE|FBR */
-    case 0223:      /* IMULB */  /* SAC|FCEPSE|FBR */
-    case 0224:      /* MUL */    /* SAC2|SAC|FCE|FBR */
-    case 0225:      /* MULI */   /* SAC2|SAC|FBR */
-    case 0226:      /* MULM */   /* FCEPSE|FBR */
-    case 0227:      /* MULB */   /* SAC2|SAC|FCEPSR|FBR */
+    CASE(0220):      /* IMUL */   /* SAC|FCE|FBR */
+    CASE(0221):      /* IMULI */  /* SAC|FBR */
+    CASE(0222):      /* IMULM */  /* FCEPSE|FBR */
+    CASE(0223):      /* IMULB */  /* SAC|FCEPSE|FBR */
+    CASE(0224):      /* MUL */    /* SAC2|SAC|FCE|FBR */
+    CASE(0225):      /* MULI */   /* SAC2|SAC|FBR */
+    CASE(0226):      /* MULM */   /* FCEPSE|FBR */
+    CASE(0227):      /* MULB */   /* SAC2|SAC|FCEPSR|FBR */
               switch (IR & 07) {
               case 1:
               case 5:
@@ -7721,10 +8164,10 @@ mul_done:
               }
               break;
 
-    case 0230:       /* IDIV */ /* SAC2|SAC|FCE|FAC */
-    case 0231:       /* IDIVI */ /* SAC2|SAC|FAC */
-    case 0232:       /* IDIVM */ /* FCEPSE|FAC */
-    case 0233:       /* IDIVB */ /* SAC2|SAC|FCEPSE|FAC */
+    CASE(0230):       /* IDIV */ /* SAC2|SAC|FCE|FAC */
+    CASE(0231):       /* IDIVI */ /* SAC2|SAC|FAC */
+    CASE(0232):       /* IDIVM */ /* FCEPSE|FAC */
+    CASE(0233):       /* IDIVB */ /* SAC2|SAC|FCEPSE|FAC */
               switch (IR & 03) {
               case 0:
                       AR = BR;
@@ -7810,10 +8253,10 @@ mul_done:
               }
               break;
 
-    case 0234:       /* DIV */ /* SAC2|SAC|FCE|FAC|FAC2 */
-    case 0235:       /* DIVI */ /* SAC2|SAC|FAC|FAC2 */
-    case 0236:       /* DIVM */ /* FCEPSE|FAC|FAC2 */
-    case 0237:       /* DIVB */ /* SAC2|SAC|FCEPSE|FAC|FAC */
+    CASE(0234):       /* DIV */ /* SAC2|SAC|FCE|FAC|FAC2 */
+    CASE(0235):       /* DIVI */ /* SAC2|SAC|FAC|FAC2 */
+    CASE(0236):       /* DIVM */ /* FCEPSE|FAC|FAC2 */
+    CASE(0237):       /* DIVB */ /* SAC2|SAC|FCEPSE|FAC|FAC */
               switch (IR & 3) {
               case 0:
                      AR = BR;
@@ -7923,7 +8366,7 @@ mul_done:
               break;
 
                /* Shift */
-    case 0240: /* ASH */  /* FAC|SAC */
+    CASE(0240): /* ASH */  /* FAC|SAC */
               SC = ((AB & RSIGN) ? (0377 ^ AB) + 1 : AB) & 0377;
               if (SC == 0)
                   break;
@@ -7946,7 +8389,7 @@ mul_done:
               set_reg(AC, AR);
               break;
 
-    case 0241: /* ROT */ /* FAC|SAC */
+    CASE(0241): /* ROT */ /* FAC|SAC */
               SC = (AB & RSIGN) ?
                      ((AB & 0377) ? (((0377 ^ AB) + 1) & 0377) : 0400)
                    : (AB & 0377);
@@ -7959,7 +8402,7 @@ mul_done:
               set_reg(AC, AR);
               break;
 
-    case 0242: /* LSH */ /* FAC|SAC */
+    CASE(0242): /* LSH */ /* FAC|SAC */
               SC = ((AB & RSIGN) ? (0377 ^ AB) + 1 : AB) & 0377;
               if (SC != 0) {
                  if (SC > 36){
@@ -7974,7 +8417,7 @@ mul_done:
               set_reg(AC, AR);
               break;
 
-    case 0243:  /* JFFO */ /* FAC */
+    CASE(0243):  /* JFFO */ /* FAC */
 #if !PDP6
               SC = 0;
               if (BR != 0) {
@@ -7991,7 +8434,7 @@ mul_done:
 #endif
               break;
 
-    case 0244: /* ASHC */ /* FAC|SAC|SAC2|FAC2 */
+    CASE(0244): /* ASHC */ /* FAC|SAC|SAC2|FAC2 */
               AR = BR;
               MQ = get_reg(AC + 1);
               SC = ((AB & RSIGN) ? (0377 ^ AB) + 1 : AB) & 0377;
@@ -8040,7 +8483,7 @@ mul_done:
               set_reg(AC+1, MQ);
               break;
 
-    case 0245: /* ROTC */ /* FAC|SAC|SAC2|FAC2 */
+    CASE(0245): /* ROTC */ /* FAC|SAC|SAC2|FAC2 */
               AR = BR;
               MQ = get_reg(AC + 1);
               SC = (AB & RSIGN) ?
@@ -8064,7 +8507,7 @@ mul_done:
               set_reg(AC+1, MQ);
               break;
 
-    case 0246: /* LSHC */ /* FAC|SAC|SAC2|FAC2 */
+    CASE(0246): /* LSHC */ /* FAC|SAC|SAC2|FAC2 */
               AR = BR;
               MQ = get_reg(AC + 1);
               SC = ((AB & RSIGN) ? (0377 ^ AB) + 1 : AB) & 0377;
@@ -8097,7 +8540,7 @@ mul_done:
               break;
 
           /* Branch */
-    case 0250:  /* EXCH */ /* FAC|FCE */
+    CASE(0250):  /* EXCH */ /* FAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -8108,7 +8551,7 @@ mul_done:
               set_reg(AC, AR);
               break;
 
-    case 0251: /* BLT */ /* FAC */
+    CASE(0251): /* BLT */ /* FAC */
               AR = BR;
               BR = AB;
 #if KL | KS
@@ -8139,6 +8582,33 @@ mul_done:
                           }
                       }
                   }
+                  /* Move what stays on one source and destination page at once */
+                  AB = (AR >> 18) & RMASK;
+                  blk_src = dt_block(0);
+                  AB = AR & RMASK;
+                  blk_dst = dt_block(1);
+                  if (blk_src != NULL && blk_dst != NULL) {
+                      f = 01000 - (int)((AR >> 18) & 0777);
+                      if (f > 01000 - (int)(AR & 0777))
+                          f = 01000 - (int)(AR & 0777);
+                      if ((AR & RMASK) > BR)
+                          f = 1;
+                      else if (BR - (AR & RMASK) < (uint64)f)
+                          f = (int)(BR - (AR & RMASK)) + 1;
+                      /* Stop where the word loop would check for events */
+                      if (f > (sim_interval + 1) / 2)
+                          f = (sim_interval + 1) / 2;
+                      if (f > 0) {
+                          dt_move(blk_dst, blk_src, f, 1);
+                          sim_interval -= 2 * f;
+                          MB = blk_dst[f - 1];
+                          if (hst_lnt)
+                              hst[hst_p].mb = MB;
+                          AD = (AR & RMASK) + (f - 1) + CM(BR) + 1;
+                          AR = AR + f * 01000001LL;
+                          continue;
+                      }
+                  }
                   AB = (AR >> 18) & RMASK;
 #if KL | KS
                   BYF5 = 1;
@@ -8197,7 +8667,7 @@ mul_done:
               } while ((AD & C1) == 0);
               break;
 
-    case 0252: /* AOBJP */ /* FAC|SAC */
+    CASE(0252): /* AOBJP */ /* FAC|SAC */
               AR = AOB(BR);
               if ((AR & SMASK) == 0) {
 #if ITS | KL_ITS
@@ -8213,7 +8683,7 @@ mul_done:
               set_reg(AC, AR);
               break;
 
-    case 0253: /* AOBJN */ /* FAC|SAC */
+    CASE(0253): /* AOBJN */ /* FAC|SAC */
               AR = AOB(BR);
               if ((AR & SMASK) != 0) {
 #if ITS | KL_ITS
@@ -8229,7 +8699,7 @@ mul_done:
               set_reg(AC, AR);
               break;
 
-    case 0254: /* JRST */      /* AR Frm PC */
+    CASE(0254): /* JRST */      /* AR Frm PC */
 #if KL | KS
 #if KL_ITS | KS_ITS
               if (uuo_cycle | pi_cycle) {
@@ -8503,7 +8973,7 @@ jrstf:
               f_pc_inh = 1;
               break;
 
-    case 0255: /* JFCL */
+    CASE(0255): /* JFCL */
               if ((FLAGS >> 9) & AC) {
 #if ITS | KL_ITS
                   if (QITS && (FLAGS & USER)) {
@@ -8516,7 +8986,7 @@ jrstf:
               FLAGS &=  037777 ^ (AC << 9);
               break;
 
-    case 0256: /* XCT */
+    CASE(0256): /* XCT */
 
               f_load_pc = 0;
               f_pc_inh = 1;
@@ -8547,7 +9017,7 @@ jrstf:
 #endif
               break;
 
-    case 0257:  /* MAP */
+    CASE(0257):  /* MAP */
 #if KI | KL | KS
               f = AB >> 9;
               flag1 = (FLAGS & USER) != 0;
@@ -8674,7 +9144,7 @@ jrstf:
               break;
 
               /* Stack, JUMP */
-    case 0260:  /* PUSHJ */  /* FAC|SAC */
+    CASE(0260):  /* PUSHJ */  /* FAC|SAC */
 #if KL
               if (QKLB && t20_page && pc_sect != 0)
                   MB = ((uint64)pc_sect << 18) + (PC + !pi_cycle);
@@ -8750,7 +9220,7 @@ jrstf:
               set_reg(AC, AR);
               break;
 
-    case 0261: /* PUSH */ /* FAC|FCE|SAC */
+    CASE(0261): /* PUSH */ /* FAC|FCE|SAC */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -8787,7 +9257,7 @@ jrstf:
               set_reg(AC, AR);
               break;
 
-    case 0262: /* POP */ /*  FAC */
+    CASE(0262): /* POP */ /*  FAC */
 
 #if KL | KS
               BYF5 = 1;   /* Tell PXCT that this is stack */
@@ -8870,7 +9340,7 @@ jrstf:
               }
               break;
 
-    case 0263: /* POPJ */ /* FAC|SAC */
+    CASE(0263): /* POPJ */ /* FAC|SAC */
               AB = BR & RMASK;
 #if KL | KS
               BYF5 = 1;   /* Tell PXCT that this is stack */
@@ -8931,7 +9401,7 @@ jrstf:
               set_reg(AC, AR);
               break;
 
-    case 0264: /* JSR */
+    CASE(0264): /* JSR */
 	      AR &= RMASK;
 #if KL
               if (QKLB && t20_page && pc_sect != 0)
@@ -8980,7 +9450,7 @@ jrstf:
               f_pc_inh = 1;
               break;
 
-    case 0265: /* JSP */  /* SAC */
+    CASE(0265): /* JSP */  /* SAC */
 #if KL
               if (QKLB && t20_page && pc_sect != 0)
                   AD = ((uint64)pc_sect << 18) + (PC + !pi_cycle);
@@ -9019,7 +9489,7 @@ jrstf:
               set_reg(AC, AR);
               break;
 
-    case 0266: /* JSA */ /* FBR|SCE */
+    CASE(0266): /* JSA */ /* FBR|SCE */
 	      AR = ((AR & RMASK) << 18) | ((PC + 1) & RMASK);
 	      MB = BR;
               set_reg(AC, AR);
@@ -9044,7 +9514,7 @@ jrstf:
               }
               break;
 
-    case 0267: /* JRA */
+    CASE(0267): /* JRA */
               AD = AB;
               AB = (get_reg(AC) >> 18) & RMASK;
               if (Mem_read(uuo_cycle | pi_cycle, 0, 0, 0))
@@ -9060,10 +9530,10 @@ jrstf:
               f_pc_inh = 1;
               break;
 
-    case 0270: /* ADD */  /* FBR|SAC|FCE */
-    case 0271: /* ADDI */ /* FBR|SAC */
-    case 0272: /* ADDM */ /* FBR|FCEPSE */
-    case 0273: /* ADDB */ /* FBR|SAC|FCEPSE */
+    CASE(0270): /* ADD */  /* FBR|SAC|FCE */
+    CASE(0271): /* ADDI */ /* FBR|SAC */
+    CASE(0272): /* ADDM */ /* FBR|FCEPSE */
+    CASE(0273): /* ADDB */ /* FBR|SAC|FCEPSE */
               switch (IR & 3) {
               case 0:
                      if (Mem_read(0, 0, 0, 0))
@@ -9111,10 +9581,10 @@ jrstf:
                   set_reg(AC, AR);
               break;
 
-    case 0274: /* SUB */  /* FBR|SAC|FCE */
-    case 0275: /* SUBI */ /* FBR|SAC */
-    case 0276: /* SUBM */ /* FBR|FCEPSE */
-    case 0277: /* SUBB */ /* FBR|SAC|FCEPSE */
+    CASE(0274): /* SUB */  /* FBR|SAC|FCE */
+    CASE(0275): /* SUBI */ /* FBR|SAC */
+    CASE(0276): /* SUBM */ /* FBR|FCEPSE */
+    CASE(0277): /* SUBB */ /* FBR|SAC|FCEPSE */
               switch (IR & 3) {
               case 0:
                      if (Mem_read(0, 0, 0, 0))
@@ -9161,14 +9631,14 @@ jrstf:
                   set_reg(AC, AR);
               break;
 
-    case 0300:    /* CAI   */  /* FBR */
-    case 0301:    /* CAIL  */  /* FBR */
-    case 0302:    /* CAIE  */  /* FBR */
-    case 0303:    /* CAILE */  /* FBR */
-    case 0304:    /* CAIA  */  /* FBR */
-    case 0305:    /* CAIGE */  /* FBR */
-    case 0306:    /* CAIN  */  /* FBR */
-    case 0307:    /* CAIG  */  /* FBR */
+    CASE(0300):    /* CAI   */  /* FBR */
+    CASE(0301):    /* CAIL  */  /* FBR */
+    CASE(0302):    /* CAIE  */  /* FBR */
+    CASE(0303):    /* CAILE */  /* FBR */
+    CASE(0304):    /* CAIA  */  /* FBR */
+    CASE(0305):    /* CAIGE */  /* FBR */
+    CASE(0306):    /* CAIN  */  /* FBR */
+    CASE(0307):    /* CAIG  */  /* FBR */
               AR &= RMASK;
               f = 0;
               AD = (CM(AR) + BR) + 1;
@@ -9185,14 +9655,14 @@ jrstf:
                  f = 1;
               goto skip_op;
 
-    case 0310:    /* CAM   */  /* FBR|FCE */
-    case 0311:    /* CAML  */  /* FBR|FCE */
-    case 0312:    /* CAME  */  /* FBR|FCE */
-    case 0313:    /* CAMLE */  /* FBR|FCE */
-    case 0314:    /* CAMA  */  /* FBR|FCE */
-    case 0315:    /* CAMGE */  /* FBR|FCE */
-    case 0316:    /* CAMN  */  /* FBR|FCE */
-    case 0317:    /* CAMG  */  /* FBR|FCE */
+    CASE(0310):    /* CAM   */  /* FBR|FCE */
+    CASE(0311):    /* CAML  */  /* FBR|FCE */
+    CASE(0312):    /* CAME  */  /* FBR|FCE */
+    CASE(0313):    /* CAMLE */  /* FBR|FCE */
+    CASE(0314):    /* CAMA  */  /* FBR|FCE */
+    CASE(0315):    /* CAMGE */  /* FBR|FCE */
+    CASE(0316):    /* CAMN  */  /* FBR|FCE */
+    CASE(0317):    /* CAMG  */  /* FBR|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -9212,27 +9682,27 @@ jrstf:
                  f = 1;
               goto skip_op;
 
-    case 0320:    /* JUMP   */  /* FAC */
-    case 0321:    /* JUMPL  */  /* FAC */
-    case 0322:    /* JUMPE  */  /* FAC */
-    case 0323:    /* JUMPLE */  /* FAC */
-    case 0324:    /* JUMPA  */  /* FAC */
-    case 0325:    /* JUMPGE */  /* FAC */
-    case 0326:    /* JUMPN  */  /* FAC */
-    case 0327:    /* JUMPG  */  /* FAC */
+    CASE(0320):    /* JUMP   */  /* FAC */
+    CASE(0321):    /* JUMPL  */  /* FAC */
+    CASE(0322):    /* JUMPE  */  /* FAC */
+    CASE(0323):    /* JUMPLE */  /* FAC */
+    CASE(0324):    /* JUMPA  */  /* FAC */
+    CASE(0325):    /* JUMPGE */  /* FAC */
+    CASE(0326):    /* JUMPN  */  /* FAC */
+    CASE(0327):    /* JUMPG  */  /* FAC */
               AD = BR;
               BR = AR & RMASK;
               f = ((AD & SMASK) != 0);
               goto jump_op;                   /* JUMP, SKIP */
 
-    case 0330:    /* SKIP   */ /* SACZ|FCE */
-    case 0331:    /* SKIPL  */ /* SACZ|FCE */
-    case 0332:    /* SKIPE  */ /* SACZ|FCE */
-    case 0333:    /* SKIPLE */ /* SACZ|FCE */
-    case 0334:    /* SKIPA  */ /* SACZ|FCE */
-    case 0335:    /* SKIPGE */ /* SACZ|FCE */
-    case 0336:    /* SKIPN  */ /* SACZ|FCE */
-    case 0337:    /* SKIPG  */ /* SACZ|FCE */
+    CASE(0330):    /* SKIP   */ /* SACZ|FCE */
+    CASE(0331):    /* SKIPL  */ /* SACZ|FCE */
+    CASE(0332):    /* SKIPE  */ /* SACZ|FCE */
+    CASE(0333):    /* SKIPLE */ /* SACZ|FCE */
+    CASE(0334):    /* SKIPA  */ /* SACZ|FCE */
+    CASE(0335):    /* SKIPGE */ /* SACZ|FCE */
+    CASE(0336):    /* SKIPN  */ /* SACZ|FCE */
+    CASE(0337):    /* SKIPG  */ /* SACZ|FCE */
               if (Mem_read(0, 0, 0, 0))
                  goto last;
               AR = MB;
@@ -9240,22 +9710,22 @@ jrstf:
               f = ((AD & SMASK) != 0);
               goto skip_op;                   /* JUMP, SKIP */
 
-    case 0340:     /* AOJ   */ /* SAC|FAC */
-    case 0341:     /* AOJL  */ /* SAC|FAC */
-    case 0342:     /* AOJE  */ /* SAC|FAC */
-    case 0343:     /* AOJLE */ /* SAC|FAC */
-    case 0344:     /* AOJA  */ /* SAC|FAC */
-    case 0345:     /* AOJGE */ /* SAC|FAC */
-    case 0346:     /* AOJN  */ /* SAC|FAC */
-    case 0347:     /* AOJG  */ /* SAC|FAC */
-    case 0360:     /* SOJ   */ /* SAC|FAC */
-    case 0361:     /* SOJL  */ /* SAC|FAC */
-    case 0362:     /* SOJE  */ /* SAC|FAC */
-    case 0363:     /* SOJLE */ /* SAC|FAC */
-    case 0364:     /* SOJA  */ /* SAC|FAC */
-    case 0365:     /* SOJGE */ /* SAC|FAC */
-    case 0366:     /* SOJN  */ /* SAC|FAC */
-    case 0367:     /* SOJG  */ /* SAC|FAC */
+    CASE(0340):     /* AOJ   */ /* SAC|FAC */
+    CASE(0341):     /* AOJL  */ /* SAC|FAC */
+    CASE(0342):     /* AOJE  */ /* SAC|FAC */
+    CASE(0343):     /* AOJLE */ /* SAC|FAC */
+    CASE(0344):     /* AOJA  */ /* SAC|FAC */
+    CASE(0345):     /* AOJGE */ /* SAC|FAC */
+    CASE(0346):     /* AOJN  */ /* SAC|FAC */
+    CASE(0347):     /* AOJG  */ /* SAC|FAC */
+    CASE(0360):     /* SOJ   */ /* SAC|FAC */
+    CASE(0361):     /* SOJL  */ /* SAC|FAC */
+    CASE(0362):     /* SOJE  */ /* SAC|FAC */
+    CASE(0363):     /* SOJLE */ /* SAC|FAC */
+    CASE(0364):     /* SOJA  */ /* SAC|FAC */
+    CASE(0365):     /* SOJGE */ /* SAC|FAC */
+    CASE(0366):     /* SOJN  */ /* SAC|FAC */
+    CASE(0367):     /* SOJG  */ /* SAC|FAC */
               flag1 = flag3 = 0;
               AD = (IR & 020) ? FMASK : 1;
               if (((BR & CMASK) + (AD & CMASK)) & SMASK) {
@@ -9302,22 +9772,22 @@ jump_op:
                   set_reg(AC, AR);
               break;
 
-    case 0350:     /* AOS   */ /* SACZ|FCEPSE */
-    case 0351:     /* AOSL  */ /* SACZ|FCEPSE */
-    case 0352:     /* AOSE  */ /* SACZ|FCEPSE */
-    case 0353:     /* AOSLE */ /* SACZ|FCEPSE */
-    case 0354:     /* AOSA  */ /* SACZ|FCEPSE */
-    case 0355:     /* AOSGE */ /* SACZ|FCEPSE */
-    case 0356:     /* AOSN  */ /* SACZ|FCEPSE */
-    case 0357:     /* AOSG  */ /* SACZ|FCEPSE */
-    case 0370:     /* SOS   */ /* SACZ|FCEPSE */
-    case 0371:     /* SOSL  */ /* SACZ|FCEPSE */
-    case 0372:     /* SOSE  */ /* SACZ|FCEPSE */
-    case 0373:     /* SOSLE */ /* SACZ|FCEPSE */
-    case 0374:     /* SOSA  */ /* SACZ|FCEPSE */
-    case 0375:     /* SOSGE */ /* SACZ|FCEPSE */
-    case 0376:     /* SOSN  */ /* SACZ|FCEPSE */
-    case 0377:     /* SOSG  */ /* SACZ|FCEPSE */
+    CASE(0350):     /* AOS   */ /* SACZ|FCEPSE */
+    CASE(0351):     /* AOSL  */ /* SACZ|FCEPSE */
+    CASE(0352):     /* AOSE  */ /* SACZ|FCEPSE */
+    CASE(0353):     /* AOSLE */ /* SACZ|FCEPSE */
+    CASE(0354):     /* AOSA  */ /* SACZ|FCEPSE */
+    CASE(0355):     /* AOSGE */ /* SACZ|FCEPSE */
+    CASE(0356):     /* AOSN  */ /* SACZ|FCEPSE */
+    CASE(0357):     /* AOSG  */ /* SACZ|FCEPSE */
+    CASE(0370):     /* SOS   */ /* SACZ|FCEPSE */
+    CASE(0371):     /* SOSL  */ /* SACZ|FCEPSE */
+    CASE(0372):     /* SOSE  */ /* SACZ|FCEPSE */
+    CASE(0373):     /* SOSLE */ /* SACZ|FCEPSE */
+    CASE(0374):     /* SOSA  */ /* SACZ|FCEPSE */
+    CASE(0375):     /* SOSGE */ /* SACZ|FCEPSE */
+    CASE(0376):     /* SOSN  */ /* SACZ|FCEPSE */
+    CASE(0377):     /* SOSG  */ /* SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -9369,20 +9839,20 @@ skip_op:
               break;
 
               /* Bool */
-    case 0400:    /* SETZ  */ /* SAC */
-    case 0401:    /* SETZI */ /* SAC */
+    CASE(0400):    /* SETZ  */ /* SAC */
+    CASE(0401):    /* SETZI */ /* SAC */
               AR = 0;                   /* SETZ */
               set_reg(AC, AR);
               break;
 
-    case 0402:    /* SETZM */ /* SCE */
+    CASE(0402):    /* SETZM */ /* SCE */
               MB = AR = 0;              /* SETZ */
               if (Mem_write(0, 0)) {
                  goto last;
               }
               break;
 
-    case 0403:    /* SETZB */ /* SAC|SCE */
+    CASE(0403):    /* SETZB */ /* SAC|SCE */
               MB = AR = 0;              /* SETZ */
               if (Mem_write(0, 0)) {
                  goto last;
@@ -9390,17 +9860,17 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0404:    /* AND  */ /* FBR|SAC|FCE */
+    CASE(0404):    /* AND  */ /* FBR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB & BR;             /* AND */
               set_reg(AC, AR);
               break;
-    case 0405:    /* ANDI */ /* FBR|SAC */
+    CASE(0405):    /* ANDI */ /* FBR|SAC */
               AR = (AR & RMASK) & BR;   /* AND */
               set_reg(AC, AR);
               break;
-    case 0406:    /* ANDM */ /* FBR|FCEPSE */
+    CASE(0406):    /* ANDM */ /* FBR|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB & BR;             /* AND */
@@ -9409,7 +9879,7 @@ skip_op:
                  goto last;
               }
               break;
-    case 0407:    /* ANDB */ /* FBR|SAC|FCEPSE */
+    CASE(0407):    /* ANDB */ /* FBR|SAC|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB & BR;             /* AND */
@@ -9420,18 +9890,18 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0410:    /* ANDCA  */ /* FBR|SAC|FCE */
+    CASE(0410):    /* ANDCA  */ /* FBR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB & CM(BR);         /* ANDCA */
               set_reg(AC, AR);
               break;
-    case 0411:    /* ANDCAI */ /* FBR|SAC */
+    CASE(0411):    /* ANDCAI */ /* FBR|SAC */
               AR &= RMASK;
               AR = AR & CM(BR);         /* ANDCA */
               set_reg(AC, AR);
               break;
-    case 0412:    /* ANDCAM */ /* FBR|FCEPSE */
+    CASE(0412):    /* ANDCAM */ /* FBR|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB & CM(BR);         /* ANDCA */
@@ -9441,7 +9911,7 @@ skip_op:
               }
               break;
 
-    case 0413:    /* ANDCAB */ /* FBR|SAC|FCEPSE */
+    CASE(0413):    /* ANDCAB */ /* FBR|SAC|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB & CM(BR);         /* ANDCA */
@@ -9452,7 +9922,7 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0415:    /* SETMI */ /* SAC */
+    CASE(0415):    /* SETMI */ /* SAC */
               AR &= RMASK;
 #if KL
               /* XMOVEI for extended addressing */
@@ -9466,14 +9936,14 @@ skip_op:
              set_reg(AC, AR);
              break;
 
-    case 0414:    /* SETM  */ /* SAC|FCE */
+    CASE(0414):    /* SETM  */ /* SAC|FCE */
              if (Mem_read(0, 0, 0, 0))
                  goto last;
              AR = MB;
              set_reg(AC, AR);
              break;
 
-    case 0416:    /* SETMM */ /* FCEPSE */
+    CASE(0416):    /* SETMM */ /* FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               if (Mem_write(0, 0)) {
@@ -9482,27 +9952,27 @@ skip_op:
 	      AR = MB;
               break;
 
-    case 0417:    /* SETMB */ /* SAC|FCE */
+    CASE(0417):    /* SETMB */ /* SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
               set_reg(AC, AR);
               break;
 
-    case 0420:    /* ANDCM  */  /* FBR|SAC|FCE */
+    CASE(0420):    /* ANDCM  */  /* FBR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = CM(MB) & BR;         /* ANDCM */
               set_reg(AC, AR);
               break;
 
-    case 0421:    /* ANDCMI */  /* FBR|SAC */
+    CASE(0421):    /* ANDCMI */  /* FBR|SAC */
               AR &= RMASK;
               AR = CM(AR) & BR;         /* ANDCM */
               set_reg(AC, AR);
               break;
 
-    case 0422:    /* ANDCMM */  /* FBR|FECPSE */
+    CASE(0422):    /* ANDCMM */  /* FBR|FECPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = CM(MB) & BR;         /* ANDCM */
@@ -9512,7 +9982,7 @@ skip_op:
               }
               break;
 
-    case 0423:    /* ANDCMB */  /* FBR|SAC|FECPSE */
+    CASE(0423):    /* ANDCMB */  /* FBR|SAC|FECPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = CM(MB) & BR;         /* ANDCM */
@@ -9523,22 +9993,22 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0424:    /* SETA  */ /* FBR|SAC */
+    CASE(0424):    /* SETA  */ /* FBR|SAC */
               AR = BR;                  /* SETA */
               set_reg(AC, AR);
               break;
-    case 0425:    /* SETAI */ /* FBR|SAC */
+    CASE(0425):    /* SETAI */ /* FBR|SAC */
               AR = BR;                  /* SETA */
               set_reg(AC, AR);
               break;
-    case 0426:    /* SETAM */ /* FBR|SCE */
+    CASE(0426):    /* SETAM */ /* FBR|SCE */
               AR = BR;                  /* SETA */
               MB = AR;
               if (Mem_write(0, 0)) {
                  goto last;
               }
               break;
-    case 0427:    /* SETAB */ /* FBR|SAC|SCE */
+    CASE(0427):    /* SETAB */ /* FBR|SAC|SCE */
               AR = BR;                  /* SETA */
               MB = AR;
               if (Mem_write(0, 0)) {
@@ -9547,18 +10017,18 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0430:    /* XOR  */ /* FBR|SAC|FCE */
+    CASE(0430):    /* XOR  */ /* FBR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB ^ BR;             /* XOR */
               set_reg(AC, AR);
               break;
-    case 0431:    /* XORI */ /* FBR|SAC */
+    CASE(0431):    /* XORI */ /* FBR|SAC */
               AR &= RMASK;
               AR = AR ^ BR;             /* XOR */
               set_reg(AC, AR);
               break;
-    case 0432:    /* XORM */ /* FBR|FCEPSE */
+    CASE(0432):    /* XORM */ /* FBR|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB ^ BR;             /* XOR */
@@ -9567,7 +10037,7 @@ skip_op:
                  goto last;
               }
               break;
-    case 0433:    /* XORB */ /* FBR|SAC|FCEPSE */
+    CASE(0433):    /* XORB */ /* FBR|SAC|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB ^ BR;             /* XOR */
@@ -9578,20 +10048,20 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0434:    /* IOR  */ /* FBR|SAC|FCE */
+    CASE(0434):    /* IOR  */ /* FBR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = CM(CM(MB) & CM(BR)); /* IOR */
               set_reg(AC, AR);
               break;
 
-    case 0435:    /* IORI */ /* FBR|SAC */
+    CASE(0435):    /* IORI */ /* FBR|SAC */
               AR &= RMASK;
               AR = CM(CM(AR) & CM(BR)); /* IOR */
               set_reg(AC, AR);
               break;
 
-    case 0436:    /* IORM */ /* FBR|FCEPSE */
+    CASE(0436):    /* IORM */ /* FBR|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = CM(CM(MB) & CM(BR)); /* IOR */
@@ -9600,7 +10070,7 @@ skip_op:
                  goto last;
               }
               break;
-    case 0437:    /* IORB */ /* FBR|SAC|FCEPSE */
+    CASE(0437):    /* IORB */ /* FBR|SAC|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = CM(CM(MB) & CM(BR)); /* IOR */
@@ -9611,19 +10081,19 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0440:    /* ANDCB  */ /* FBR|SAC|FCE */
+    CASE(0440):    /* ANDCB  */ /* FBR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
               AR = CM(AR) & CM(BR);     /* ANDCB */
               set_reg(AC, AR);
               break;
-    case 0441:    /* ANDCBI */ /* FBR|SAC */
+    CASE(0441):    /* ANDCBI */ /* FBR|SAC */
               AR &= RMASK;
               AR = CM(AR) & CM(BR);     /* ANDCB */
               set_reg(AC, AR);
               break;
-    case 0442:    /* ANDCBM */ /* FBR|FCEPSE */
+    CASE(0442):    /* ANDCBM */ /* FBR|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -9633,7 +10103,7 @@ skip_op:
                   goto last;
               }
               break;
-    case 0443:    /* ANDCBB */ /* FBR|SAC|FCEPSE */
+    CASE(0443):    /* ANDCBB */ /* FBR|SAC|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -9645,19 +10115,19 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0444:    /* EQV  */ /* FBR|SAC|FCE */
+    CASE(0444):    /* EQV  */ /* FBR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
               AR = CM(AR ^ BR);         /* EQV */
               set_reg(AC, AR);
               break;
-    case 0445:    /* EQVI */ /* FBR|SAC */
+    CASE(0445):    /* EQVI */ /* FBR|SAC */
               AR &= RMASK;
               AR = CM(AR ^ BR);         /* EQV */
               set_reg(AC, AR);
               break;
-    case 0446:    /* EQVM */ /* FBR|FCEPSE */
+    CASE(0446):    /* EQVM */ /* FBR|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -9667,7 +10137,7 @@ skip_op:
                   goto last;
               }
               break;
-    case 0447:    /* EQVB */ /* FBR|SAC|FCEPSE */
+    CASE(0447):    /* EQVB */ /* FBR|SAC|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -9679,17 +10149,17 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0450:    /* SETCA  */ /* FBR|SAC */
+    CASE(0450):    /* SETCA  */ /* FBR|SAC */
               AR = CM(BR);              /* SETCA */
               set_reg(AC, AR);
               break;
 
-    case 0451:    /* SETCAI */ /* FBR|SAC */
+    CASE(0451):    /* SETCAI */ /* FBR|SAC */
               AR = CM(BR);              /* SETCA */
               set_reg(AC, AR);
               break;
 
-    case 0452:    /* SETCAM */ /* FBR|SCE */
+    CASE(0452):    /* SETCAM */ /* FBR|SCE */
               AR = CM(BR);              /* SETCA */
               MB = AR;
               if (Mem_write(0, 0)) {
@@ -9697,7 +10167,7 @@ skip_op:
               }
               break;
 
-    case 0453:    /* SETCAB */ /* FBR|SAC|SCE */
+    CASE(0453):    /* SETCAB */ /* FBR|SAC|SCE */
               AR = CM(BR);              /* SETCA */
               MB = AR;
               if (Mem_write(0, 0)) {
@@ -9706,19 +10176,19 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0454:    /* ORCA  */ /* FBR|SAC|FCE */
+    CASE(0454):    /* ORCA  */ /* FBR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
               AR = CM(CM(AR) & BR);     /* ORCA */
               set_reg(AC, AR);
               break;
-    case 0455:    /* ORCAI */ /* FBR|SAC */
+    CASE(0455):    /* ORCAI */ /* FBR|SAC */
               AR &= RMASK;
               AR = CM(CM(AR) & BR);     /* ORCA */
               set_reg(AC, AR);
               break;
-    case 0456:    /* ORCAM */ /* FBR|FCEPSE */
+    CASE(0456):    /* ORCAM */ /* FBR|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -9728,7 +10198,7 @@ skip_op:
                  goto last;
               }
               break;
-    case 0457:    /* ORCAB */ /* FBR|SAC|FCEPSE */
+    CASE(0457):    /* ORCAB */ /* FBR|SAC|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -9740,7 +10210,7 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0460:    /* SETCM  */  /* SAC|FCE */
+    CASE(0460):    /* SETCM  */  /* SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -9748,12 +10218,12 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0461:    /* SETCMI */  /* SAC */
+    CASE(0461):    /* SETCMI */  /* SAC */
               AR &= RMASK;
               AR = CM(AR);              /* SETCM */
               set_reg(AC, AR);
               break;
-    case 0462:    /* SETCMM */  /* FCEPSE */
+    CASE(0462):    /* SETCMM */  /* FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -9763,7 +10233,7 @@ skip_op:
                  goto last;
               }
               break;
-    case 0463:    /* SETCMB */  /* SAC|FCEPSE */
+    CASE(0463):    /* SETCMB */  /* SAC|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -9775,7 +10245,7 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0464:    /* ORCM  */ /* FBR|SAC|FCE */
+    CASE(0464):    /* ORCM  */ /* FBR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -9783,12 +10253,12 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0465:    /* ORCMI */ /* FBR|SAC */
+    CASE(0465):    /* ORCMI */ /* FBR|SAC */
               AR &= RMASK;
               AR = CM(AR & CM(BR));     /* ORCM */
               set_reg(AC, AR);
               break;
-    case 0466:    /* ORCMM */ /* FBR|FCEPSE */
+    CASE(0466):    /* ORCMM */ /* FBR|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -9798,7 +10268,7 @@ skip_op:
                  goto last;
               }
               break;
-    case 0467:    /* ORCMB */ /* FBR|SAC|FCEPSE */
+    CASE(0467):    /* ORCMB */ /* FBR|SAC|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -9810,19 +10280,19 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0470:    /* ORCB  */ /* FBR|SAC|FCE */
+    CASE(0470):    /* ORCB  */ /* FBR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
               AR = CM(AR & BR);         /* ORCB */
               set_reg(AC, AR);
               break;
-    case 0471:    /* ORCBI */ /* FBR|SAC */
+    CASE(0471):    /* ORCBI */ /* FBR|SAC */
               AR &= RMASK;
               AR = CM(AR & BR);         /* ORCB */
               set_reg(AC, AR);
               break;
-    case 0472:    /* ORCBM */ /* FBR|FCEPSE */
+    CASE(0472):    /* ORCBM */ /* FBR|FCEPSE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -9832,7 +10302,7 @@ skip_op:
                  goto last;
               }
               break;
-    case 0473:    /* ORCBB */ /* FBR|SAC|FCEPSE */
+    CASE(0473):    /* ORCBB */ /* FBR|SAC|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -9844,23 +10314,23 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0474:    /* SETO  */  /* SAC */
+    CASE(0474):    /* SETO  */  /* SAC */
               AR = FMASK;               /* SETO */
               set_reg(AC, AR);
               break;
 
-    case 0475:    /* SETOI */  /* SAC */
+    CASE(0475):    /* SETOI */  /* SAC */
               AR = FMASK;               /* SETO */
               set_reg(AC, AR);
               break;
 
-    case 0476:    /* SETOM */  /* SCE */
+    CASE(0476):    /* SETOM */  /* SCE */
               MB = AR = FMASK;          /* SETO */
               if (Mem_write(0, 0)) {
                  goto last;
               }
               break;
-    case 0477:    /* SETOB */  /* SAC|SCE */
+    CASE(0477):    /* SETOB */  /* SAC|SCE */
               MB = AR = FMASK;          /* SETO */
               if (Mem_write(0, 0)) {
                   goto last;
@@ -9868,7 +10338,7 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0500:    /* HLL  */ /* FBR|SAC|FCE */
+    CASE(0500):    /* HLL  */ /* FBR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0)) {
                   goto last;
               }
@@ -9877,7 +10347,7 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0501:    /* HLLI */ /* FBR|SAC */
+    CASE(0501):    /* HLLI */ /* FBR|SAC */
               AR &= RMASK;
 #if KL
               /* XHLLI for extended addressing */
@@ -9892,7 +10362,7 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0502:    /* HLLM */ /* FAC|FCEPSE */
+    CASE(0502):    /* HLLM */ /* FAC|FCEPSE */
               AR = BR;
               if (Mem_read(0, 0, 0, 1))
                   goto last;
@@ -9903,8 +10373,8 @@ skip_op:
               }
               break;
 
-    case 0503:     /* HLLS */ /* SACZ|FCEPSE */
-    case 0543:     /* HRRS */ /* SACZ|FCEPSE */
+    CASE(0503):     /* HLLS */ /* SACZ|FCEPSE */
+    CASE(0543):     /* HRRS */ /* SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -9915,7 +10385,7 @@ skip_op:
                   set_reg(AC, AR);
               break;
 
-    case 0547:    /* HLRS */ /* SACZ|FCEPSE */
+    CASE(0547):    /* HLRS */ /* SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -9929,7 +10399,7 @@ skip_op:
                   set_reg(AC, AR);
               break;
 
-    case 0504:    /* HRL  */ /* SWAR|FBR|SAC|FCE */
+    CASE(0504):    /* HRL  */ /* SWAR|FBR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -9938,14 +10408,14 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0505:    /* HRLI */ /* SWAR|FBR|SAC */
+    CASE(0505):    /* HRLI */ /* SWAR|FBR|SAC */
               AR &= RMASK;
               AR = SWAP_AR;
               AR = (AR & LMASK) | (BR & RMASK);
               set_reg(AC, AR);
               break;
 
-    case 0506:    /* HRLM */ /* SWAR|FAC|FCEPSE */
+    CASE(0506):    /* HRLM */ /* SWAR|FAC|FCEPSE */
               AR = BR;
               if (Mem_read(0, 0, 0, 1))
                   goto last;
@@ -9958,7 +10428,7 @@ skip_op:
               }
               break;
 
-    case 0507:    /* HRLS */ /* SACZ|FCEPSE */
+    CASE(0507):    /* HRLS */ /* SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -9972,7 +10442,7 @@ skip_op:
                   set_reg(AC, AR);
               break;
 
-    case 0510:    /* HLLZ  */ /* SAC|FCE */
+    CASE(0510):    /* HLLZ  */ /* SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -9980,13 +10450,13 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0511:    /* HLLZI */ /* SAC */
+    CASE(0511):    /* HLLZI */ /* SAC */
               AR &= RMASK;
               AR = (AR & LMASK);
               set_reg(AC, AR);
               break;
 
-    case 0512:    /* HLLZM */ /* FAC|SCE */
+    CASE(0512):    /* HLLZM */ /* FAC|SCE */
               AR &= RMASK;
 
               BR = AR;
@@ -9998,7 +10468,7 @@ skip_op:
               }
               break;
 
-    case 0513:    /* HLLZS */ /* SACZ|FCEPSE */
+    CASE(0513):    /* HLLZS */ /* SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -10011,7 +10481,7 @@ skip_op:
                   set_reg(AC, AR);
               break;
 
-    case 0514:    /* HRLZ  */ /* SWAR|SAC|FCE */
+    CASE(0514):    /* HRLZ  */ /* SWAR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -10020,14 +10490,14 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0515:    /* HRLZI */ /* SWAR|SAC */
+    CASE(0515):    /* HRLZI */ /* SWAR|SAC */
               AR &= RMASK;
               AR = SWAP_AR;
               AR = (AR & LMASK);
               set_reg(AC, AR);
               break;
 
-    case 0516:    /* HRLZM */ /* SWAR|FAC|SCE */
+    CASE(0516):    /* HRLZM */ /* SWAR|FAC|SCE */
               BR = AR;
               AR = get_reg(AC);
               AR = SWAP_AR;
@@ -10038,7 +10508,7 @@ skip_op:
               }
               break;
 
-    case 0517:    /* HRLZS */ /* SWAR|SACZ|FCEPSE */
+    CASE(0517):    /* HRLZS */ /* SWAR|SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -10053,7 +10523,7 @@ skip_op:
                   set_reg(AC, AR);
               break;
 
-    case 0520:    /* HLLO  */  /* SAC|FCE */
+    CASE(0520):    /* HLLO  */  /* SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -10061,13 +10531,13 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0521:    /* HLLOI */  /* SAC */
+    CASE(0521):    /* HLLOI */  /* SAC */
               AR &= RMASK;
               AR = (AR & LMASK) | RMASK;
               set_reg(AC, AR);
               break;
 
-    case 0522:    /* HLLOM */  /* FAC|SCE */
+    CASE(0522):    /* HLLOM */  /* FAC|SCE */
               BR = AR;
               AR = get_reg(AC);
               AR = (AR & LMASK) | RMASK;
@@ -10077,7 +10547,7 @@ skip_op:
               }
               break;
 
-    case 0523:    /* HLLOS */  /* SACZ|FCEPSE */
+    CASE(0523):    /* HLLOS */  /* SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -10090,7 +10560,7 @@ skip_op:
                   set_reg(AC, AR);
               break;
 
-    case 0524:    /* HRLO  */  /* SWAR|SAC|FCE */
+    CASE(0524):    /* HRLO  */  /* SWAR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -10099,14 +10569,14 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0525:    /* HRLOI */  /* SWAR|SAC */
+    CASE(0525):    /* HRLOI */  /* SWAR|SAC */
               AR &= RMASK;
               AR = SWAP_AR;
               AR = (AR & LMASK) | RMASK;
               set_reg(AC, AR);
               break;
 
-    case 0526:    /* HRLOM */  /* SWAR|FAC|SCE */
+    CASE(0526):    /* HRLOM */  /* SWAR|FAC|SCE */
               BR = AR & RMASK;
               AR = get_reg(AC);
               AR = SWAP_AR;
@@ -10117,7 +10587,7 @@ skip_op:
               }
               break;
 
-    case 0527:    /* HRLOS */  /* SWAR|SACZ|FCEPSE */
+    CASE(0527):    /* HRLOS */  /* SWAR|SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -10131,7 +10601,7 @@ skip_op:
                   set_reg(AC, AR);
               break;
 
-    case 0530:    /* HLLE  */ /* SAC|FCE */
+    CASE(0530):    /* HLLE  */ /* SAC|FCE */
               AR &= RMASK;
               if (Mem_read(0, 0, 0, 0))
                   goto last;
@@ -10141,14 +10611,14 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0531:    /* HLLEI */ /* SAC */
+    CASE(0531):    /* HLLEI */ /* SAC */
               AR &= RMASK;
               AD = ((AR & SMASK) != 0) ? RMASK : 0;
               AR = (AR & LMASK) | AD;
               set_reg(AC, AR);
               break;
 
-    case 0532:    /* HLLEM */ /* FAC|SCE */
+    CASE(0532):    /* HLLEM */ /* FAC|SCE */
               BR = AR & RMASK;
               AR = get_reg(AC);
               AD = ((AR & SMASK) != 0) ? RMASK : 0;
@@ -10159,7 +10629,7 @@ skip_op:
               }
               break;
 
-    case 0533:    /* HLLES */ /* SAZC|FCEPSE */
+    CASE(0533):    /* HLLES */ /* SAZC|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -10173,7 +10643,7 @@ skip_op:
                   set_reg(AC, AR);
               break;
 
-    case 0534:    /* HRLE  */ /* SAC|SWAR|FCE */
+    CASE(0534):    /* HRLE  */ /* SAC|SWAR|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -10183,7 +10653,7 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0535:    /* HRLEI */ /* SAC|SWAR*/
+    CASE(0535):    /* HRLEI */ /* SAC|SWAR*/
               AR &= RMASK;
               AR = SWAP_AR;
               AD = ((AR & SMASK) != 0) ? RMASK : 0;
@@ -10191,7 +10661,7 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0536:    /* HRLEM */ /* FAC|SWAR|SCE */
+    CASE(0536):    /* HRLEM */ /* FAC|SWAR|SCE */
               BR = AR & RMASK;
               AR = get_reg(AC);
               AR = SWAP_AR;
@@ -10203,7 +10673,7 @@ skip_op:
               }
               break;
 
-    case 0537:    /* HRLES */ /* SACZ|SWAR|FCEPSE */
+    CASE(0537):    /* HRLES */ /* SACZ|SWAR|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -10218,7 +10688,7 @@ skip_op:
                   set_reg(AC, AR);
               break;
 
-    case 0540:    /* HRR  */ /* FBR|SAC|FCE */
+    CASE(0540):    /* HRR  */ /* FBR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -10226,13 +10696,13 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0541:    /* HRRI */ /* FBR|SAC */
+    CASE(0541):    /* HRRI */ /* FBR|SAC */
               AR &= RMASK;
               AR = (BR & LMASK) | (AR & RMASK);
               set_reg(AC, AR);
               break;
 
-    case 0542:    /* HRRM */ /* FAC|FCEPSE */
+    CASE(0542):    /* HRRM */ /* FAC|FCEPSE */
               AR = BR;
               if (Mem_read(0, 0, 0, 1))
                   goto last;
@@ -10244,7 +10714,7 @@ skip_op:
               }
               break;
 
-    case 0544:    /* HLR  */ /* SWAR|FBR|SAC|FCE */
+    CASE(0544):    /* HLR  */ /* SWAR|FBR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -10254,14 +10724,14 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0545:    /* HLRI */ /* SWAR|FBR|SAC */
+    CASE(0545):    /* HLRI */ /* SWAR|FBR|SAC */
               AR &= RMASK;
               AR = SWAP_AR;
               AR = (BR & LMASK) | (AR & RMASK);
               set_reg(AC, AR);
               break;
 
-    case 0546:    /* HLRM */ /* SWAR|FAC|FCEPSE */
+    CASE(0546):    /* HLRM */ /* SWAR|FAC|FCEPSE */
               AR = BR;
               if (Mem_read(0, 0, 0, 1))
                   goto last;
@@ -10274,7 +10744,7 @@ skip_op:
               }
               break;
 
-    case 0550:    /* HRRZ  */ /* SAC|FCE */
+    CASE(0550):    /* HRRZ  */ /* SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -10282,13 +10752,13 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0551:    /* HRRZI */ /* SAC */
+    CASE(0551):    /* HRRZI */ /* SAC */
               AR &= RMASK;
               AR = (AR & RMASK);
               set_reg(AC, AR);
               break;
 
-    case 0552:    /* HRRZM */ /* FAC|SCE */
+    CASE(0552):    /* HRRZM */ /* FAC|SCE */
               BR = AR;
               AR = get_reg(AC);
               AR = (AR & RMASK);
@@ -10298,7 +10768,7 @@ skip_op:
               }
               break;
 
-    case 0553:    /* HRRZS */ /* SACZ|FCEPSE */
+    CASE(0553):    /* HRRZS */ /* SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -10311,7 +10781,7 @@ skip_op:
                   set_reg(AC, AR);
               break;
 
-    case 0554:    /* HLRZ  */ /* SWAR|SAC|FCE */
+    CASE(0554):    /* HLRZ  */ /* SWAR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -10320,14 +10790,14 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0555:    /* HLRZI */ /* SWAR|SAC */
+    CASE(0555):    /* HLRZI */ /* SWAR|SAC */
               AR &= RMASK;
               AR = SWAP_AR;
               AR = (AR & RMASK);
               set_reg(AC, AR);
               break;
 
-    case 0556:    /* HLRZM */ /* SWAR|FAC|SCE */
+    CASE(0556):    /* HLRZM */ /* SWAR|FAC|SCE */
               BR = AR;
               AR = get_reg(AC);
               AR = SWAP_AR;
@@ -10338,7 +10808,7 @@ skip_op:
               }
               break;
 
-    case 0557:    /* HLRZS */ /* SWAR|SACZ|FCEPSE */
+    CASE(0557):    /* HLRZS */ /* SWAR|SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -10353,7 +10823,7 @@ skip_op:
 
               break;
 
-    case 0560:    /* HRRO  */  /* SAC|FCE */
+    CASE(0560):    /* HRRO  */  /* SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -10361,13 +10831,13 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0561:    /* HRROI */  /* SAC */
+    CASE(0561):    /* HRROI */  /* SAC */
               AR &= RMASK;
               AR = LMASK | (AR & RMASK);
               set_reg(AC, AR);
               break;
 
-    case 0562:    /* HRROM */  /* FAC|SCE */
+    CASE(0562):    /* HRROM */  /* FAC|SCE */
               AR &= RMASK;
               BR = AR;
               AR = get_reg(AC);
@@ -10378,7 +10848,7 @@ skip_op:
               }
               break;
 
-    case 0563:    /* HRROS */  /* SACZ|FCEPSE */
+    CASE(0563):    /* HRROS */  /* SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -10391,7 +10861,7 @@ skip_op:
                   set_reg(AC, AR);
               break;
 
-    case 0564:    /* HLRO  */  /* SWAR|SAC|FCE */
+    CASE(0564):    /* HLRO  */  /* SWAR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -10400,14 +10870,14 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0565:    /* HLROI */  /* SWAR|SAC */
+    CASE(0565):    /* HLROI */  /* SWAR|SAC */
               AR &= RMASK;
               AR = SWAP_AR;
               AR = LMASK | (AR & RMASK);
               set_reg(AC, AR);
               break;
 
-    case 0566:    /* HLROM */  /* SWAR|FAC|SCE */
+    CASE(0566):    /* HLROM */  /* SWAR|FAC|SCE */
               AR = BR;
               if (Mem_read(0, 0, 0, 0))
                   goto last;
@@ -10420,7 +10890,7 @@ skip_op:
               }
               break;
 
-    case 0567:    /* HLROS */  /* SWAR|SACZ|FCEPSE */
+    CASE(0567):    /* HLROS */  /* SWAR|SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -10434,7 +10904,7 @@ skip_op:
                   set_reg(AC, AR);
               break;
 
-    case 0570:    /* HRRE  */  /* SAC|FCE */
+    CASE(0570):    /* HRRE  */  /* SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -10443,14 +10913,14 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0571:    /* HRREI */  /* SAC */
+    CASE(0571):    /* HRREI */  /* SAC */
               AR &= RMASK;
               AD = ((AR & RSIGN) != 0) ? LMASK: 0;
               AR = AD | (AR & RMASK);
               set_reg(AC, AR);
               break;
 
-    case 0572:    /* HRREM */  /* FAC|SCE */
+    CASE(0572):    /* HRREM */  /* FAC|SCE */
               AR &= RMASK;
               BR = AR;
               AR = get_reg(AC);
@@ -10462,7 +10932,7 @@ skip_op:
               }
               break;
 
-    case 0573:    /* HRRES */  /* SACZ|FCEPSE */
+    CASE(0573):    /* HRRES */  /* SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -10476,7 +10946,7 @@ skip_op:
                   set_reg(AC, AR);
               break;
 
-    case 0574:    /* HLRE  */  /* SWAR|SAC|FCE */
+    CASE(0574):    /* HLRE  */  /* SWAR|SAC|FCE */
               if (Mem_read(0, 0, 0, 0))
                   goto last;
               AR = MB;
@@ -10486,7 +10956,7 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0575:    /* HLREI */  /* SWAR|SAC */
+    CASE(0575):    /* HLREI */  /* SWAR|SAC */
               AR &= RMASK;
               AR = SWAP_AR;
               AD = ((AR & RSIGN) != 0) ? LMASK: 0;
@@ -10494,7 +10964,7 @@ skip_op:
               set_reg(AC, AR);
               break;
 
-    case 0576:    /* HLREM */  /* SWAR|FAC|SCE */
+    CASE(0576):    /* HLREM */  /* SWAR|FAC|SCE */
               AR &= RMASK;
               BR = AR;
               AR = get_reg(AC);
@@ -10507,7 +10977,7 @@ skip_op:
               }
               break;
 
-    case 0577:    /* HLRES */  /* SWAR|SACZ|FCEPSE */
+    CASE(0577):    /* HLRES */  /* SWAR|SACZ|FCEPSE */
               if (Mem_read(0, 0, 0, 1))
                   goto last;
               AR = MB;
@@ -10522,70 +10992,70 @@ skip_op:
                   set_reg(AC, AR);
               break;
 
-    case 0600:     /* TRN  */ /* FBR */
-    case 0601:     /* TLN  */ /* FBR|SWAR */
-    case 0602:     /* TRNE */ /* FBR */
-    case 0603:     /* TLNE */ /* FBR|SWAR */
-    case 0604:     /* TRNA */ /* FBR */
-    case 0605:     /* TLNA */ /* FBR|SWAR */
-    case 0606:     /* TRNN */ /* FBR */
-    case 0607:     /* TLNN */ /* FBR|SWAR */
-    case 0610:     /* TDN  */ /* FBR|FCE */
-    case 0611:     /* TSN  */ /* FBR|SWAR|FCE */
-    case 0612:     /* TDNE */ /* FBR|FCE */
-    case 0613:     /* TSNE */ /* FBR|SWAR|FCE */
-    case 0614:     /* TDNA */ /* FBR|FCE */
-    case 0615:     /* TSNA */ /* FBR|SWAR|FCE */
-    case 0616:     /* TDNN */ /* FBR|FCE */
-    case 0617:     /* TSNN */ /* FBR|SWAR|FCE */
-    case 0620:     /* TRZ  */ /* FBR|SAC */
-    case 0621:     /* TLZ  */ /* FBR|SWAR|SAC */
-    case 0622:     /* TRZE */ /* FBR|SAC */
-    case 0623:     /* TLZE */ /* FBR|SWAR|SAC */
-    case 0624:     /* TRZA */ /* FBR|SAC */
-    case 0625:     /* TLZA */ /* FBR|SWAR|SAC */
-    case 0626:     /* TRZN */ /* FBR|SAC */
-    case 0627:     /* TLZN */ /* FBR|SWAR|SAC */
-    case 0630:     /* TDZ  */ /* FBR|SAC|FCE */
-    case 0631:     /* TSZ  */ /* FBR|SWAR|SAC|FCE */
-    case 0632:     /* TDZE */ /* FBR|SAC|FCE */
-    case 0633:     /* TSZE */ /* FBR|SWAR|SAC|FCE */
-    case 0634:     /* TDZA */ /* FBR|SAC|FCE */
-    case 0635:     /* TSZA */ /* FBR|SWAR|SAC|FCE */
-    case 0636:     /* TDZN */ /* FBR|SAC|FCE */
-    case 0637:     /* TSZN */ /* FBR|SWAR|SAC|FCE */
-    case 0640:     /* TRC  */ /* FBR|SAC */
-    case 0641:     /* TLC  */ /* FBR|SWAR|SAC */
-    case 0642:     /* TRCE */ /* FBR|SAC */
-    case 0643:     /* TLCE */ /* FBR|SWAR|SAC */
-    case 0644:     /* TRCA */ /* FBR|SAC */
-    case 0645:     /* TLCA */ /* FBR|SWAR|SAC */
-    case 0646:     /* TRCN */ /* FBR|SAC */
-    case 0647:     /* TLCN */ /* FBR|SWAR|SAC */
-    case 0650:     /* TDC  */ /* FBR|SAC|FCE */
-    case 0651:     /* TSC  */ /* FBR|SWAR|SAC|FCE */
-    case 0652:     /* TDCE */ /* FBR|SAC|FCE */
-    case 0653:     /* TSCE */ /* FBR|SWAR|SAC|FCE */
-    case 0654:     /* TDCA */ /* FBR|SAC|FCE */
-    case 0655:     /* TSCA */ /* FBR|SWAR|SAC|FCE */
-    case 0656:     /* TDCN */ /* FBR|SAC|FCE */
-    case 0657:     /* TSCN */ /* FBR|SWAR|SAC|FCE */
-    case 0660:     /* TRO  */ /* FBR|SAC */
-    case 0661:     /* TLO  */ /* FBR|SWAR|SAC */
-    case 0662:     /* TROE */ /* FBR|SAC */
-    case 0663:     /* TLOE */ /* FBR|SWAR|SAC */
-    case 0664:     /* TROA */ /* FBR|SAC */
-    case 0665:     /* TLOA */ /* FBR|SWAR|SAC */
-    case 0666:     /* TRON */ /* FBR|SAC */
-    case 0667:     /* TLON */ /* FBR|SWAR|SAC */
-    case 0670:     /* TDO  */ /* FBR|SAC|FCE */
-    case 0671:     /* TSO  */ /* FBR|SWAR|SAC|FCE */
-    case 0672:     /* TDOE */ /* FBR|SAC|FCE */
-    case 0673:     /* TSOE */ /* FBR|SWAR|SAC|FCE */
-    case 0674:     /* TDOA */ /* FBR|SAC|FCE */
-    case 0675:     /* TSOA */ /* FBR|SWAR|SAC|FCE */
-    case 0676:     /* TDON */ /* FBR|SAC|FCE */
-    case 0677:     /* TSON */ /* FBR|SWAR|SAC|FCE */
+    CASE(0600):     /* TRN  */ /* FBR */
+    CASE(0601):     /* TLN  */ /* FBR|SWAR */
+    CASE(0602):     /* TRNE */ /* FBR */
+    CASE(0603):     /* TLNE */ /* FBR|SWAR */
+    CASE(0604):     /* TRNA */ /* FBR */
+    CASE(0605):     /* TLNA */ /* FBR|SWAR */
+    CASE(0606):     /* TRNN */ /* FBR */
+    CASE(0607):     /* TLNN */ /* FBR|SWAR */
+    CASE(0610):     /* TDN  */ /* FBR|FCE */
+    CASE(0611):     /* TSN  */ /* FBR|SWAR|FCE */
+    CASE(0612):     /* TDNE */ /* FBR|FCE */
+    CASE(0613):     /* TSNE */ /* FBR|SWAR|FCE */
+    CASE(0614):     /* TDNA */ /* FBR|FCE */
+    CASE(0615):     /* TSNA */ /* FBR|SWAR|FCE */
+    CASE(0616):     /* TDNN */ /* FBR|FCE */
+    CASE(0617):     /* TSNN */ /* FBR|SWAR|FCE */
+    CASE(0620):     /* TRZ  */ /* FBR|SAC */
+    CASE(0621):     /* TLZ  */ /* FBR|SWAR|SAC */
+    CASE(0622):     /* TRZE */ /* FBR|SAC */
+    CASE(0623):     /* TLZE */ /* FBR|SWAR|SAC */
+    CASE(0624):     /* TRZA */ /* FBR|SAC */
+    CASE(0625):     /* TLZA */ /* FBR|SWAR|SAC */
+    CASE(0626):     /* TRZN */ /* FBR|SAC */
+    CASE(0627):     /* TLZN */ /* FBR|SWAR|SAC */
+    CASE(0630):     /* TDZ  */ /* FBR|SAC|FCE */
+    CASE(0631):     /* TSZ  */ /* FBR|SWAR|SAC|FCE */
+    CASE(0632):     /* TDZE */ /* FBR|SAC|FCE */
+    CASE(0633):     /* TSZE */ /* FBR|SWAR|SAC|FCE */
+    CASE(0634):     /* TDZA */ /* FBR|SAC|FCE */
+    CASE(0635):     /* TSZA */ /* FBR|SWAR|SAC|FCE */
+    CASE(0636):     /* TDZN */ /* FBR|SAC|FCE */
+    CASE(0637):     /* TSZN */ /* FBR|SWAR|SAC|FCE */
+    CASE(0640):     /* TRC  */ /* FBR|SAC */
+    CASE(0641):     /* TLC  */ /* FBR|SWAR|SAC */
+    CASE(0642):     /* TRCE */ /* FBR|SAC */
+    CASE(0643):     /* TLCE */ /* FBR|SWAR|SAC */
+    CASE(0644):     /* TRCA */ /* FBR|SAC */
+    CASE(0645):     /* TLCA */ /* FBR|SWAR|SAC */
+    CASE(0646):     /* TRCN */ /* FBR|SAC */
+    CASE(0647):     /* TLCN */ /* FBR|SWAR|SAC */
+    CASE(0650):     /* TDC  */ /* FBR|SAC|FCE */
+    CASE(0651):     /* TSC  */ /* FBR|SWAR|SAC|FCE */
+    CASE(0652):     /* TDCE */ /* FBR|SAC|FCE */
+    CASE(0653):     /* TSCE */ /* FBR|SWAR|SAC|FCE */
+    CASE(0654):     /* TDCA */ /* FBR|SAC|FCE */
+    CASE(0655):     /* TSCA */ /* FBR|SWAR|SAC|FCE */
+    CASE(0656):     /* TDCN */ /* FBR|SAC|FCE */
+    CASE(0657):     /* TSCN */ /* FBR|SWAR|SAC|FCE */
+    CASE(0660):     /* TRO  */ /* FBR|SAC */
+    CASE(0661):     /* TLO  */ /* FBR|SWAR|SAC */
+    CASE(0662):     /* TROE */ /* FBR|SAC */
+    CASE(0663):     /* TLOE */ /* FBR|SWAR|SAC */
+    CASE(0664):     /* TROA */ /* FBR|SAC */
+    CASE(0665):     /* TLOA */ /* FBR|SWAR|SAC */
+    CASE(0666):     /* TRON */ /* FBR|SAC */
+    CASE(0667):     /* TLON */ /* FBR|SWAR|SAC */
+    CASE(0670):     /* TDO  */ /* FBR|SAC|FCE */
+    CASE(0671):     /* TSO  */ /* FBR|SWAR|SAC|FCE */
+    CASE(0672):     /* TDOE */ /* FBR|SAC|FCE */
+    CASE(0673):     /* TSOE */ /* FBR|SWAR|SAC|FCE */
+    CASE(0674):     /* TDOA */ /* FBR|SAC|FCE */
+    CASE(0675):     /* TSOA */ /* FBR|SWAR|SAC|FCE */
+    CASE(0676):     /* TDON */ /* FBR|SAC|FCE */
+    CASE(0677):     /* TSON */ /* FBR|SWAR|SAC|FCE */
 
               /* Load pseudo registers based on Opcode */
               if (IR & 010) {
@@ -10625,22 +11095,23 @@ skip_op:
               break;
 
             /* IOT */
-    case 0700: case 0701: case 0702: case 0703:
-    case 0704: case 0705: case 0706: case 0707:
-    case 0710: case 0711: case 0712: case 0713:
-    case 0714: case 0715: case 0716: case 0717:
-    case 0720: case 0721: case 0722: case 0723:
-    case 0724: case 0725: case 0726: case 0727:
-    case 0730: case 0731: case 0732: case 0733:
-    case 0734: case 0735: case 0736: case 0737:
-    case 0740: case 0741: case 0742: case 0743:
-    case 0744: case 0745: case 0746: case 0747:
-    case 0750: case 0751: case 0752: case 0753:
-    case 0754: case 0755: case 0756: case 0757:
-    case 0760: case 0761: case 0762: case 0763:
-    case 0764: case 0765: case 0766: case 0767:
-    case 0770: case 0771: case 0772: case 0773:
-    case 0774: case 0775: case 0776: case 0777:
+    CASE(0700): CASE(0701): CASE(0702): CASE(0703):
+    CASE(0704): CASE(0705): CASE(0706): CASE(0707):
+    CASE(0710): CASE(0711): CASE(0712): CASE(0713):
+    CASE(0714): CASE(0715): CASE(0716): CASE(0717):
+    CASE(0720): CASE(0721): CASE(0722): CASE(0723):
+    CASE(0724): CASE(0725): CASE(0726): CASE(0727):
+    CASE(0730): CASE(0731): CASE(0732): CASE(0733):
+    CASE(0734): CASE(0735): CASE(0736): CASE(0737):
+    CASE(0740): CASE(0741): CASE(0742): CASE(0743):
+    CASE(0744): CASE(0745): CASE(0746): CASE(0747):
+    CASE(0750): CASE(0751): CASE(0752): CASE(0753):
+    CASE(0754): CASE(0755): CASE(0756): CASE(0757):
+    CASE(0760): CASE(0761): CASE(0762): CASE(0763):
+    CASE(0764): CASE(0765): CASE(0766): CASE(0767):
+    CASE(0770): CASE(0771): CASE(0772): CASE(0773):
+    CASE(0774): CASE(0775): CASE(0776): CASE(0777):
+              fc_flush();               /* Pager state may change */
 #if KI | KL
               if (!pi_cycle && ((((FLAGS & (USER|USERIO)) == USER) && (IR & 040) == 0)
                     || ((FLAGS & (USER|PUBLIC)) == PUBLIC))) {
@@ -11861,6 +12332,59 @@ if (QITS)
 return reason;
 }
 
+#if KA
+#undef Mem_read
+#undef Mem_write
+
+static t_stat sim_instr_ka (void)
+{
+    return sim_instr_pager(PAGER_KA);
+}
+
+#if ITS
+static t_stat sim_instr_its (void)
+{
+    return sim_instr_pager(PAGER_ITS);
+}
+#endif
+
+#if BBN
+static t_stat sim_instr_bbn (void)
+{
+    return sim_instr_pager(PAGER_BBN);
+}
+#endif
+
+#if WAITS
+static t_stat sim_instr_waits (void)
+{
+    return sim_instr_pager(PAGER_WAITS);
+}
+#endif
+
+/* Run the copy of the instruction loop for the pager build_dev_tab chose */
+t_stat sim_instr (void)
+{
+    t_stat reason;
+
+    if ((reason = build_dev_tab ()) != SCPE_OK)        /* build, chk dib_tab */
+        return reason;
+#if ITS
+    if (Mem_read == &Mem_read_its)
+        return sim_instr_its();
+#endif
+#if BBN
+    if (Mem_read == &Mem_read_bbn)
+        return sim_instr_bbn();
+#endif
+#if WAITS
+    if (Mem_read == &Mem_read_waits)
+        return sim_instr_waits();
+#endif
+    return sim_instr_ka();
+}
+#endif
+
 #if KL | KS
 
 /* Handle indirection for extended byte instructions */
@@ -12087,8 +12611,7 @@ ptr_flg = 1;
 
 ptr_flg = 0;
     /* Generate mask for given size */
-    msk = (uint64)(1) << s;
-    msk--;
+    msk = byte_msk[s];
     *data = (MB >> p) & msk;
     if (cnt) {
         /* Decrement count */
@@ -12121,9 +12644,7 @@ store_byte(int n, uint64 data, int cnt)
         goto back;
 
     /* Generate mask for given size */
-    msk = (uint64)(1) << s;
-    msk--;
-    msk <<= p;
+    msk = byte_msk[s] << p;
     MB &= CM(msk);
     MB |= msk & ((uint64)(data) << p);
     if (Mem_write(0, 0))
@@ -12159,7 +12680,7 @@ get_mask(int n, uint64 *msk)
     s = (val >> 24) & 077;
 
     /* Generate mask for given size */
-    *msk = ((uint64)(1) << s) - 1;
+    *msk = byte_msk[s];
 }
 
 /* Adjust a pointer to be valid */
@@ -12310,6 +12831,96 @@ bak_byte(int n, int cnt)
     set_reg(n+1, val);
 }
 
+/*
+ * Byte runs for the string instructions.
+ *
+ * A one word local byte pointer with no index or indirection is stepped
+ * straight through M while its words stay on pages in the data
+ * translation cache.  The count and pointer are kept in the str_run and
+ * written back by str_end, leaving them as load_byte and store_byte
+ * would have after the same bytes.
+ */
+struct str_run {
+    int       n;                    /* AC holding count, pointer in n+1 */
+    int       wr;                   /* Bytes will be stored */
+    uint64    cnt;                  /* Byte count */
+    uint64    ptr;                  /* Byte pointer */
+    t_addr    addr;                 /* Word holding current byte */
+    int       p;                    /* Position of current byte */
+    int       s;                    /* Byte size */
+    uint64    msk;                  /* Byte mask */
+    t_addr    page;                 /* Page mem points to */
+    uint64    *mem;                 /* Start of that page in M */
+};
+
+/* Start a run on the pointer at n+1, returns 0 if it can't be done */
+int
+str_start(struct str_run *r, int n, int wr)
+{
+    uint64    ptr = get_reg(n+1);
+
+    r->s = (ptr >> 24) & 077;
+    r->p = (ptr >> 30) & 077;
+    if (r->s == 0 || r->s > 36 || r->p > 36 || (ptr & BIT12) != 0 ||
+        GET_XR(ptr) != 0 || TST_IND(ptr) != 0)
+        return 0;
+    r->n = n;
+    r->wr = wr;
+    r->cnt = get_reg(n);
+    r->ptr = ptr;
+    r->addr = ptr & RMASK;
+    r->msk = byte_msk[r->s];
+    r->page = FC_NONE;
+    return 1;
+}
+
+/* Advance to next byte, returns word holding it or NULL if not mapped */
+uint64 *
+str_next(struct str_run *r)
+{
+    t_addr    a = r->addr;
+    int       p = r->p - r->s;
+    uint64    *m;
+
+    if (p < 0) {
+        p = 36 - r->s;
+        a = (a + 1) & RMASK;
+    }
+    if ((a & ~0777) != r->page) {
+        AB = a;
+#if KL
+        sect = cur_sect;
+#endif
+        if ((m = dt_block(r->wr)) == NULL)
+            return NULL;
+        r->page = a & ~0777;
+        r->mem = m - (a & 0777);
+    }
+    r->addr = a;
+    r->p = p;
+    return &r->mem[a & 0777];
+}
+
+/* Store data into the byte just advanced to */
+void
+str_put(struct str_run *r, uint64 *w, uint64 data)
+{
+    *w = (*w & CM(r->msk << r->p)) | ((data & r->msk) << r->p);
+    MEM_DIRTY(w - M);
+}
+
+/* Write back count and pointer */
+void
+str_end(struct str_run *r)
+{
+    set_reg(r->n, r->cnt);
+    set_reg(r->n+1, (r->ptr & PMASK & LMASK) | ((uint64)(r->p) << 30) | r->addr);
+#if KL
+    sect = cur_sect;
+    glb_sect = 0;
+#endif
+}
+
 /* Preform a table lookup operation */
 int
 do_xlate(uint32 tbl, uint64 val, int mask)
@@ -12405,7 +13016,12 @@ do_extend(uint32 ia)
     uint64     reg;
 #if KL
     int        xlat_sect;
+    uint64     *blk_src, *blk_dst;
 #endif
+    struct str_run src, dst;
+    uint64     *sw, *dw;
+    t_addr     sa;
+    int        sp;
     int        f, i;
 
 
@@ -12431,6 +13047,38 @@ do_extend(uint32 ia)
               /* Compare the strings */
               f = 2;
               while (((get_reg(ext_ac) | get_reg(ext_ac+3)) & MANT) != 0) {
+                  /* Compare directly in memory while both have bytes */
+                  if (str_start(&src, ext_ac, 0) && str_start(&dst, ext_ac+3, 0)) {
+                      for (i = 0; (src.cnt & MANT) != 0 && (dst.cnt & MANT) != 0; i++) {
+                          sa = src.addr;
+                          sp = src.p;
+                          if ((sw = str_next(&src)) == NULL)
+                              break;
+                          if ((dw = str_next(&dst)) == NULL) {
+                              src.addr = sa;
+                              src.p = sp;
+                              break;
+                          }
+                          src.cnt--;
+                          dst.cnt--;
+                          val1 = (*sw >> src.p) & src.msk;
+                          val2 = (*dw >> dst.p) & dst.msk;
+                          MB = *dw;
+                          if (val1 != val2) {
+                              f = (val1 < val2) ? 1: 0;
+                              i++;
+                              break;
+                          }
+                      }
+                      if (i != 0) {
+                          str_end(&src);
+                          str_end(&dst);
+                          sim_interval -= 2 * i;
+                          if (f != 2)
+                              break;
+                          continue;
+                      }
+                  }
                   if (!load_byte(ext_ac, &val1, fill1, 1)) {
                       return 0;
                   }
@@ -12944,6 +13592,45 @@ do_extend(uint32 ia)
               while ((get_reg(ext_ac) & MANT) != 0) {
                   if ((get_reg(ext_ac+3) & MANT) == 0)
                       return 0;
+                  /* Move directly in memory while both have bytes */
+                  if (IR != 015 && str_start(&src, ext_ac, 0) && str_start(&dst, ext_ac+3, 1)) {
+                      f = 0;
+                      for (i = 0; (src.cnt & MANT) != 0 && (dst.cnt & MANT) != 0; i++) {
+                          sa = src.addr;
+                          sp = src.p;
+                          if ((sw = str_next(&src)) == NULL)
+                              break;
+                          val1 = (*sw >> src.p) & src.msk;
+                          if (IR == 014) {
+                              val1 = (val1 + val2) & FMASK;
+                              /* Out of range ends with source advanced */
+                              if ((val1 & ~msk) != 0) {
+                                  src.cnt--;
+                                  sim_interval--;
+                                  MB = *sw;
+                                  f = 1;
+                                  break;
+                              }
+                          }
+                          if ((dw = str_next(&dst)) == NULL) {
+                              src.addr = sa;
+                              src.p = sp;
+                              break;
+                          }
+                          src.cnt--;
+                          dst.cnt--;
+                          str_put(&dst, dw, val1);
+                          MB = *dw;
+                      }
+                      if (i != 0 || f) {
+                          str_end(&src);
+                          str_end(&dst);
+                          sim_interval -= 2 * i;
+                          if (f)
+                              return 0;
+                          continue;
+                      }
+                  }
                   if (!load_byte(ext_ac, &val1, fill1, 1))
                       return 0;
                   if (IR == 014) {
@@ -12967,6 +13654,21 @@ do_extend(uint32 ia)
                   }
               }
               while ((get_reg(ext_ac+3) & MANT) != 0) {
+                  /* Fill directly in memory */
+                  if (str_start(&dst, ext_ac+3, 1)) {
+                      for (i = 0; (dst.cnt & MANT) != 0; i++) {
+                          if ((dw = str_next(&dst)) == NULL)
+                              break;
+                          dst.cnt--;
+                          str_put(&dst, dw, fill1);
+                          MB = *dw;
+                      }
+                      if (i != 0) {
+                          str_end(&dst);
+                          sim_interval -= i;
+                          continue;
+                      }
+                  }
                   if (!store_byte(ext_ac+3, fill1, 1))
                      return 0;
               }
@@ -13015,6 +13717,29 @@ do_extend(uint32 ia)
                   val2 = get_reg(ext_ac + 2);
                   while (reg != 0) {
                       if (reg & SMASK) {
+                          /* Move down to the start of a source or destination page */
+                          sect = ((val1 - 1) >> 18) & 00037;
+                          AB = (val1 - 1) & RMASK;
+                          blk_src = dt_block(0);
+                          f = (int)(AB & 0777) + 1;
+                          sect = ((val2 - 1) >> 18) & 00037;
+                          AB = (val2 - 1) & RMASK;
+                          blk_dst = dt_block(1);
+                          if (blk_src != NULL && blk_dst != NULL) {
+                              if (f > (int)(AB & 0777) + 1)
+                                  f = (int)(AB & 0777) + 1;
+                              if (((FMASK + 1 - reg) & FMASK) < (uint64)f)
+                                  f = (int)((FMASK + 1 - reg) & FMASK);
+                              dt_move(blk_dst - (f - 1), blk_src - (f - 1), f, 0);
+                              sim_interval -= 2 * f;
+                              MB = blk_dst[-(f - 1)];
+                              if (hst_lnt)
+                                  hst[hst_p].mb = MB;
+                              val1 = (val1 - f) & (SECTM|RMASK);
+                              val2 = (val2 - f) & (SECTM|RMASK);
+                              reg = (reg + f) & FMASK;
+                              continue;
+                          }
                           val1 = (val1 - 1) & (SECTM|RMASK);
                           sect = (val1 >> 18) & 00037;
                           AB = val1 & RMASK;
@@ -13036,6 +13761,29 @@ do_extend(uint32 ia)
                           BYF5 = 0;
                           reg = (reg + 1) & FMASK;
                       } else {
+                          /* Move up to the end of a source or destination page */
+                          sect = (val1 >> 18) & 00037;
+                          AB = val1 & RMASK;
+                          blk_src = dt_block(0);
+                          f = 01000 - (int)(AB & 0777);
+                          sect = (val2 >> 18) & 00037;
+                          AB = val2 & RMASK;
+                          blk_dst = dt_block(1);
+                          if (blk_src != NULL && blk_dst != NULL) {
+                              if (f > 01000 - (int)(AB & 0777))
+                                  f = 01000 - (int)(AB & 0777);
+                              if (reg < (uint64)f)
+                                  f = (int)reg;
+                              dt_move(blk_dst, blk_src, f, 1);
+                              sim_interval -= 2 * f;
+                              MB = blk_dst[f - 1];
+                              if (hst_lnt)
+                                  hst[hst_p].mb = MB;
+                              val1 = (val1 + f) & (SECTM|RMASK);
+                              val2 = (val2 + f) & (SECTM|RMASK);
+                              reg = (reg - f) & FMASK;
+                              continue;
+                          }
                           sect = (val1 >> 18) & 00037;
                           AB = val1 & RMASK;
                           ptr_flg = 1;
@@ -13156,10 +13904,46 @@ static const char *pdp10_clock_precalibrate_commands[] = {
 
 /* Reset routine */
 
+/* Build the byte pointer decode tables */
+void byte_init()
+{
+    int     p, sz, np;
+#if KL
+    int     f;
+#endif
+
+    for (sz = 0; sz < 0100; sz++) {
+        byte_msk[sz] = ((uint64)(1) << sz) - 1;
+        for (p = 0; p < 0100; p++) {
+            np = (p + (0777 ^ sz) + 1) & 0777;
+            if (np & 0400)
+                np = (((0777 ^ sz) + 044 + 1) & 0777) | BYTE_NXT;
+            byte_inc[(p << 6) | sz] = np;
+        }
+    }
+#if KL
+    for (f = 0; f < 26; f++) {
+        sz = _byte_adj[f].s;
+        np = _byte_adj[f].p - sz;
+        owg_inc[f] = f + 1;
+        if (np < 0) {
+            /* Find first byte of next word */
+            for (owg_inc[f] = 0; owg_inc[f] < 26; owg_inc[f]++) {
+                if (_byte_adj[owg_inc[f]].s == sz &&
+                    _byte_adj[owg_inc[f]].p == 36 - sz)
+                    break;
+            }
+            owg_inc[f] |= BYTE_NXT >> 3;
+        }
+    }
+#endif
+}
+
 t_stat cpu_reset (DEVICE *dptr)
 {
 int     i;
 sim_debug(DEBUG_CONO, dptr, "CPU reset\n");
+byte_init();
 BYF5 = uuo_cycle = 0;
 #if KA | PDP6
 Pl = Ph = 01777;
@@ -13203,6 +13987,7 @@ sim_brk_types = SWMASK('E') | SWMASK('W') | SWMASK('R');
 sim_brk_dflt = SWMASK ('E');
 sim_clock_precalibrate_commands = pdp10_clock_precalibrate_commands;
 sim_vm_initial_ips = 4 * SIM_INITIAL_IPS;
+sim_register_mem_region (&cpu_mem_region);
 sim_rtcn_init_unit (&cpu_unit[0], cpu_unit[0].wait, TMR_RTC);
 sim_activate(&cpu_unit[0], 1000);
 #if MPX_DEV
@@ -13289,6 +14074,7 @@ else {
     if (ea >= MEMSIZE)
         return SCPE_NXM;
     M[ea] = val & FMASK;
+    MEM_DIRTY(ea);
     }
 return SCPE_OK;
 }
@@ -325,6 +325,7 @@ extern DEBTAB crd_debug[];
 #define MAXMEMSIZE      1024 * 1024
 #endif
 #define MEMSIZE         (cpu_unit[0].capac)
+#define MEM_DIRTY(a)    SIM_SET_DIRTY(mem_dirty, (a))  /* Page changed since SAVE */
 
 #define ICWA            0000000000776
 #if KI_22BIT
@@ -599,6 +600,8 @@ void    rh_writecw(struct rh_if *rh, int nxm);
 void    rh_finish_op(struct rh_if *rh, int flags);
 int     rh_read(struct rh_if *rh);
 int     rh_write(struct rh_if *rh);
+int     rh_read_block(struct rh_if *rh, t_uint64 *buf, int n, int *cnt);
+int     rh_write_block(struct rh_if *rh, t_uint64 *buf, int n, int *cnt);
 #else
 extern t_stat (*dev_tab[128])(uint32 dev, t_uint64 *data);
 
@@ -694,6 +697,8 @@ void    rh_writecw(struct rh_if *rh, int nxm);
 void    rh_finish_op(struct rh_if *rh, int flags);
 int     rh_read(struct rh_if *rh);
 int     rh_write(struct rh_if *rh);
+int     rh_read_block(struct rh_if *rh, t_uint64 *buf, int n, int *cnt);
+int     rh_write_block(struct rh_if *rh, t_uint64 *buf, int n, int *cnt);
 
 
 int ten11_read (t_addr addr, t_uint64 *data);
@@ -790,11 +795,25 @@ extern t_bool sim_idle_enab;
 #if !KS
 extern struct rh_dev rh[];
 #endif
+#if PDP6
+extern t_uint64   *M;
+#else
 extern t_uint64   M[MAXMEMSIZE];
+#endif
+extern uint8      mem_dirty[];
 extern t_uint64   FM[];
 extern uint32   PC;
 extern uint32   FLAGS;
 
+/*
+ * Segment shared by SLAVE and AUXCPU when attached with -M.  A header
+ * holding the count of interrupt requests to the PDP-6 is followed by
+ * the whole PDP-6 memory, which the PDP-6 runs out of directly.
+ */
+#define SHM_IRQ         0                       /* Word holding int32 IRQ count */
+#define SHM_MEM         8                       /* Word offset of PDP-6 memory */
+#define SHM_WORDS       (SHM_MEM + 256 * 1024)  /* Segment size in words */
+
 #if NUM_DEVS_AUXCPU
 extern t_addr   auxcpu_base;
 int auxcpu_read (t_addr addr, uint64 *);
@@ -805,6 +824,7 @@ extern UNIT     auxcpu_unit[];
 //int slave_read (t_addr addr);
 //int slave_write (t_addr addr, uint64);
 //extern UNIT     slave_unit[];
+void cpu_set_memory (t_uint64 *mem);
 #endif
 
 #endif
@@ -66,15 +66,412 @@ static struct disk_formats fmts[] = {
     {0, 0},
 };
 
+static t_stat disk_cache_svc(UNIT *uptr);
+static t_stat disk_cache_reset(DEVICE *dptr);
+
+/* Write back timer, shared by all units with a cache */
+static UNIT disk_cache_unit = { UDATA (&disk_cache_svc, UNIT_IDLE, 0) };
+static DEVICE disk_cache_dev = {
+    "INT-DISK-CACHE", &disk_cache_unit, NULL, NULL,
+    1, 0, 0, 0, 0, 0,
+    NULL, NULL, &disk_cache_reset, NULL, NULL, NULL,
+    NULL, DEV_NOSAVE
+    };
+
+/*
+ * Optional cylinder cache, set with SET <unit> CACHE=n.  Whole cylinders
+ * are read with one transfer, the next cylinder is read ahead when a
+ * unit moves on to it in order, and written sectors are held until the
+ * line is reused, the unit is detached, the simulator stops or the
+ * write back event runs every DISK_FLUSH_MSEC.  Hung off up8 of the unit.
+ */
+
+#define DISK_FLUSH_MSEC 5000            /* Longest time sectors stay dirty */
+
+struct disk_line {
+    int         cyl;                    /* Cylinder held, -1 if none */
+    uint32      use;                    /* Last use, for replacement */
+    int         ndirty;                 /* Number of dirty sectors */
+    uint8       *dirty;                 /* Dirty flag per sector */
+    uint64      *data;                  /* Cylinder data */
+};
+
+struct disk_cache {
+    int32       size;                   /* Size in words, 0 if off */
+    int         spc;                    /* Sectors per cylinder */
+    int         wps;                    /* Words per sector */
+    int         nlines;                 /* Number of lines */
+    int         last;                   /* Last cylinder accessed */
+    uint32      stamp;                  /* Use counter */
+    uint8       *conv;                  /* Packing buffer, one cylinder */
+    struct disk_line *line;
+};
+
+/*
+ * Convert between words and the 9 byte pairs.  Each pair is handled as
+ * one 64 bit load or store of the first 8 bytes plus the odd byte, which
+ * the compiler turns into a single (byte swapped) memory access.
+ */
+static void
+dbd9_unpack(uint64 *buffer, const uint8 *conv, int wps)
+{
+    int      wp;
+    uint64   temp;
+
+    for (wp = 0; wp < wps; wp += 2, conv += 9) {
+        temp = ((uint64)conv[0] << 56) | ((uint64)conv[1] << 48) |
+               ((uint64)conv[2] << 40) | ((uint64)conv[3] << 32) |
+               ((uint64)conv[4] << 24) | ((uint64)conv[5] << 16) |
+               ((uint64)conv[6] << 8)  | ((uint64)conv[7]);
+        buffer[wp] = temp >> 28;
+        buffer[wp+1] = ((temp & 0xfffffff) << 8) | conv[8];
+    }
+}
+
+static void
+dld9_unpack(uint64 *buffer, const uint8 *conv, int wps)
+{
+    int      wp;
+    uint64   temp;
+
+    for (wp = 0; wp < wps; wp += 2, conv += 9) {
+        temp = ((uint64)conv[0])       | ((uint64)conv[1] << 8)  |
+               ((uint64)conv[2] << 16) | ((uint64)conv[3] << 24) |
+               ((uint64)conv[4] << 32) | ((uint64)conv[5] << 40) |
+               ((uint64)conv[6] << 48) | ((uint64)conv[7] << 56);
+        buffer[wp] = temp & FMASK;
+        buffer[wp+1] = (temp >> 36) | ((uint64)conv[8] << 28);
+    }
+}
+
+static void
+dbd9_pack(uint8 *conv, const uint64 *buffer, int wps)
+{
+    int      wp;
+    uint64   temp;
+
+    for (wp = 0; wp < wps; wp += 2, conv += 9) {
+        temp = (buffer[wp] << 28) | ((buffer[wp+1] >> 8) & 0xfffffff);
+        conv[0] = (uint8)(temp >> 56);
+        conv[1] = (uint8)(temp >> 48);
+        conv[2] = (uint8)(temp >> 40);
+        conv[3] = (uint8)(temp >> 32);
+        conv[4] = (uint8)(temp >> 24);
+        conv[5] = (uint8)(temp >> 16);
+        conv[6] = (uint8)(temp >> 8);
+        conv[7] = (uint8)(temp);
+        conv[8] = (uint8)(buffer[wp+1] & 0xff);
+    }
+}
+
+static void
+dld9_pack(uint8 *conv, const uint64 *buffer, int wps)
+{
+    int      wp;
+    uint64   temp;
+
+    for (wp = 0; wp < wps; wp += 2, conv += 9) {
+        temp = (buffer[wp] & FMASK) | (buffer[wp+1] << 36);
+        conv[0] = (uint8)(temp);
+        conv[1] = (uint8)(temp >> 8);
+        conv[2] = (uint8)(temp >> 16);
+        conv[3] = (uint8)(temp >> 24);
+        conv[4] = (uint8)(temp >> 32);
+        conv[5] = (uint8)(temp >> 40);
+        conv[6] = (uint8)(temp >> 48);
+        conv[7] = (uint8)(temp >> 56);
+        conv[8] = (uint8)((buffer[wp+1] >> 28) & 0xff);
+    }
+}
+
+/* Drop all lines, after writing back any dirty sectors */
+static void
+disk_cache_free(UNIT *uptr)
+{
+    struct disk_cache *dc = (struct disk_cache *)uptr->up8;
+    int      i;
+
+    if (dc == NULL || dc->line == NULL)
+        return;
+    disk_cache_flush(uptr);
+    for (i = 0; i < dc->nlines; i++) {
+        free(dc->line[i].data);
+        free(dc->line[i].dirty);
+    }
+    free(dc->line);
+    free(dc->conv);
+    dc->line = NULL;
+    dc->conv = NULL;
+    dc->nlines = 0;
+}
+
+/* Check if requests on the unit go through the cache, set it up if so */
+static int
+disk_cache_ok(UNIT *uptr, int wps)
+{
+    struct disk_cache *dc = (struct disk_cache *)uptr->up8;
+    int      i;
+
+    if (dc == NULL || dc->size == 0 || dc->spc == 0 || (wps & 1) != 0)
+        return 0;
+    if (dc->line != NULL) {
+        if (dc->wps == wps)
+            return 1;
+        disk_cache_free(uptr);
+    }
+    dc->wps = wps;
+    dc->nlines = dc->size / (dc->spc * wps);
+    if (dc->nlines == 0)
+        return 0;
+    dc->line = (struct disk_line *)calloc(dc->nlines, sizeof(struct disk_line));
+    dc->conv = (uint8 *)malloc(dc->spc * (wps / 2) * 9);
+    if (dc->line == NULL || dc->conv == NULL) {
+        free(dc->line);
+        free(dc->conv);
+        dc->line = NULL;
+        dc->conv = NULL;
+        dc->nlines = 0;
+        return 0;
+    }
+    for (i = 0; i < dc->nlines; i++)
+        dc->line[i].cyl = -1;
+    dc->last = -1;
+    return 1;
+}
+
+/*
+ * Write out dirty sectors of a line, one transfer per run of them.
+ * Sectors that could not be written stay dirty.
+ */
+static t_stat
+disk_cache_flush_line(UNIT *uptr, struct disk_cache *dc, struct disk_line *ln)
+{
+    int      s, e, i;
+    int      da;
+    int      bc;
+    size_t   n, wc;
+    t_stat   r = SCPE_OK;
+
+    for (s = 0; ln->ndirty != 0 && s < dc->spc; s = e) {
+        if (!ln->dirty[s]) {
+            e = s + 1;
+            continue;
+        }
+        for (e = s; e < dc->spc && ln->dirty[e]; e++);
+        da = ln->cyl * dc->spc + s;
+        switch(GET_FMT(uptr->flags)) {
+        case SIMH:
+        default:
+                n = (e - s) * dc->wps;
+                if (sim_fseek(uptr->fileref, da * dc->wps * sizeof(uint64), SEEK_SET) != 0)
+                    wc = 0;
+                else
+                    wc = sim_fwrite (&ln->data[s * dc->wps], sizeof(uint64), n,
+                                     uptr->fileref);
+                break;
+        case DBD9:
+        case DLD9:
+                bc = (dc->wps / 2) * 9;
+                n = (e - s) * bc;
+                if (GET_FMT(uptr->flags) == DBD9)
+                    dbd9_pack(dc->conv, &ln->data[s * dc->wps], (e - s) * dc->wps);
+                else
+                    dld9_pack(dc->conv, &ln->data[s * dc->wps], (e - s) * dc->wps);
+                if (sim_fseek(uptr->fileref, da * bc, SEEK_SET) != 0)
+                    wc = 0;
+                else
+                    wc = sim_fwrite (dc->conv, 1, n, uptr->fileref);
+                break;
+        }
+        if (wc != n) {
+            r = SCPE_IOERR;
+            continue;
+        }
+        for (i = s; i < e; i++)
+            ln->dirty[i] = 0;
+        ln->ndirty -= e - s;
+    }
+    return r;
+}
+
+/*
+ * Write back all dirty sectors and flush the file.  Called by SCP when
+ * the simulator stops, since it skips its own fflush for units with an
+ * io_flush routine, and by the write back event.
+ */
+void
+disk_cache_flush(UNIT *uptr)
+{
+    struct disk_cache *dc = (struct disk_cache *)uptr->up8;
+    t_stat   r = SCPE_OK;
+    int      i;
+
+    if (dc != NULL && dc->line != NULL) {
+        for (i = 0; i < dc->nlines; i++) {
+            if (disk_cache_flush_line(uptr, dc, &dc->line[i]) != SCPE_OK)
+                r = SCPE_IOERR;
+        }
+    }
+    if (uptr->fileref != NULL && fflush(uptr->fileref) != 0)
+        r = SCPE_IOERR;
+    if (r != SCPE_OK)
+        sim_printf("%s: error writing back cached sectors\n", sim_uname(uptr));
+}
+
+/* Check for units with a cache, writing them back if flush is set */
+static int
+disk_cache_scan(int flush)
+{
+    DEVICE  *dptr;
+    UNIT    *u;
+    uint32   i, j;
+    int      active = 0;
+
+    for (i = 0; (dptr = sim_devices[i]) != NULL; i++) {
+        for (j = 0; j < dptr->numunits; j++) {
+            u = dptr->units + j;
+            if ((u->flags & UNIT_ATT) && u->io_flush == &disk_cache_flush) {
+                if (flush)
+                    disk_cache_flush(u);
+                active = 1;
+            }
+        }
+    }
+    return active;
+}
+
+/* Write back every cache, run every DISK_FLUSH_MSEC while one is in use */
+static t_stat
+disk_cache_svc(UNIT *uptr)
+{
+    if (disk_cache_scan(1))
+        sim_activate_after(uptr, DISK_FLUSH_MSEC * 1000);
+    return SCPE_OK;
+}
+
+/* RUN empties the event queue, so start the timer again */
+static t_stat
+disk_cache_reset(DEVICE *dptr)
+{
+    if (disk_cache_scan(0) && !sim_is_active(&disk_cache_unit))
+        sim_activate_after(&disk_cache_unit, DISK_FLUSH_MSEC * 1000);
+    return SCPE_OK;
+}
+
+/* Hand write back of an attached unit to SCP and the event */
+static void
+disk_cache_start(UNIT *uptr)
+{
+    uptr->io_flush = &disk_cache_flush;
+    sim_register_internal_device(&disk_cache_dev);
+    if (!sim_is_active(&disk_cache_unit))
+        sim_activate_after(&disk_cache_unit, DISK_FLUSH_MSEC * 1000);
+}
+
+/* Find the line holding a cylinder, reading it in if need be */
+static struct disk_line *
+disk_cache_get(UNIT *uptr, int cyl)
+{
+    struct disk_cache *dc = (struct disk_cache *)uptr->up8;
+    struct disk_line  *ln = NULL;
+    int      words = dc->spc * dc->wps;
+    int      wc;
+    int      bc;
+    int      i;
+
+    for (i = 0; i < dc->nlines; i++) {
+        if (dc->line[i].cyl == cyl) {
+            dc->line[i].use = ++dc->stamp;
+            return &dc->line[i];
+        }
+        if (ln == NULL || dc->line[i].cyl < 0 ||
+            (ln->cyl >= 0 && dc->line[i].use < ln->use))
+            ln = &dc->line[i];
+    }
+    if (ln->data == NULL) {
+        ln->data = (uint64 *)malloc(words * sizeof(uint64));
+        ln->dirty = (uint8 *)calloc(dc->spc, sizeof(uint8));
+        if (ln->data == NULL || ln->dirty == NULL) {
+            free(ln->data);
+            free(ln->dirty);
+            ln->data = NULL;
+            ln->dirty = NULL;
+            return NULL;
+        }
+    } else if (disk_cache_flush_line(uptr, dc, ln) != SCPE_OK) {
+        return NULL;                      /* Keep the line, go direct */
+    }
+    switch(GET_FMT(uptr->flags)) {
+    case SIMH:
+            (void)sim_fseek(uptr->fileref, cyl * words * sizeof(uint64), SEEK_SET);
+            wc = sim_fread (ln->data, sizeof(uint64), words, uptr->fileref);
+            while (wc < words)
+                ln->data[wc++] = 0;
+            break;
+    case DBD9:
+    case DLD9:
+            bc = dc->spc * (dc->wps / 2) * 9;
+            (void)sim_fseek(uptr->fileref, cyl * bc, SEEK_SET);
+            wc = sim_fread (dc->conv, 1, bc, uptr->fileref);
+            while (wc < bc)
+                 dc->conv[wc++] = 0;
+            if (GET_FMT(uptr->flags) == DBD9)
+                dbd9_unpack(ln->data, dc->conv, words);
+            else
+                dld9_unpack(ln->data, dc->conv, words);
+            break;
+    }
+    ln->cyl = cyl;
+    ln->use = ++dc->stamp;
+    return ln;
+}
+
+static t_stat
+disk_cache_read(UNIT *uptr, uint64 *buffer, int sector)
+{
+    struct disk_cache *dc = (struct disk_cache *)uptr->up8;
+    struct disk_line  *ln;
+    int      cyl = sector / dc->spc;
+
+    if ((ln = disk_cache_get(uptr, cyl)) == NULL)
+        return SCPE_MEM;
+    memcpy(buffer, &ln->data[(sector % dc->spc) * dc->wps], dc->wps * sizeof(uint64));
+    /* Moved on to the next cylinder, read the one after in as well */
+    if (cyl == dc->last + 1 && dc->nlines > 1)
+        (void)disk_cache_get(uptr, cyl + 1);
+    dc->last = cyl;
+    return SCPE_OK;
+}
+
+static t_stat
+disk_cache_write(UNIT *uptr, uint64 *buffer, int sector)
+{
+    struct disk_cache *dc = (struct disk_cache *)uptr->up8;
+    struct disk_line  *ln;
+    int      cyl = sector / dc->spc;
+    int      s = sector % dc->spc;
+
+    if ((ln = disk_cache_get(uptr, cyl)) == NULL)
+        return SCPE_MEM;
+    memcpy(&ln->data[s * dc->wps], buffer, dc->wps * sizeof(uint64));
+    if (!ln->dirty[s]) {
+        ln->dirty[s] = 1;
+        ln->ndirty++;
+    }
+    dc->last = cyl;
+    return SCPE_OK;
+}
+
 t_stat 
 disk_read(UNIT *uptr, uint64 *buffer, int sector, int wps)
 {
     int      da;
     int      wc;
     int      bc;
-    int      wp;
-    uint64   temp;
     uint8    conv_buff[2048];
+
+    if (disk_cache_ok(uptr, wps) && disk_cache_read(uptr, buffer, sector) == SCPE_OK)
+        return SCPE_OK;
     switch(GET_FMT(uptr->flags)) {
     case SIMH:
             da = sector * wps;
@@ -90,20 +487,7 @@ disk_read(UNIT *uptr, uint64 *buffer, int sector, int wps)
             wc = sim_fread (&conv_buff, 1, bc, uptr->fileref);
             while (wc < bc)
                  conv_buff[wc++] = 0;
-            for (wp = wc = 0; wp < wps;) {
-                temp = ((uint64)conv_buff[wc++]) << 28;
-                temp |= ((uint64)conv_buff[wc++]) << 20;
-                temp |= ((uint64)conv_buff[wc++]) << 12;
-                temp |= ((uint64)conv_buff[wc++]) << 4;
-                temp |= ((uint64)conv_buff[wc]) >> 4;
-                buffer[wp++] = temp;
-                temp = ((uint64)conv_buff[wc++] & 0xf) << 32;
-                temp |= ((uint64)conv_buff[wc++]) << 24;
-                temp |= ((uint64)conv_buff[wc++]) << 16;
-                temp |= ((uint64)conv_buff[wc++]) << 8;
-                temp |= ((uint64)conv_buff[wc++]);
-                buffer[wp++] = temp;
-            }
+            dbd9_unpack(buffer, conv_buff, wps);
             break;
 
     case DLD9:
@@ -113,20 +497,7 @@ disk_read(UNIT *uptr, uint64 *buffer, int sector, int wps)
             wc = sim_fread (&conv_buff, 1, bc, uptr->fileref);
             while (wc < bc)
                  conv_buff[wc++] = 0;
-            for (wp = wc = 0; wp < wps;) {
-                temp = ((uint64)conv_buff[wc++]);
-                temp |= ((uint64)conv_buff[wc++]) << 8;
-                temp |= ((uint64)conv_buff[wc++]) << 16;
-                temp |= ((uint64)conv_buff[wc++]) << 24;
-                temp |= ((uint64)conv_buff[wc] & 0xf) << 32;
-                buffer[wp++] = temp;
-                temp = ((uint64)conv_buff[wc++] & 0xf0) >> 4;
-                temp |= ((uint64)conv_buff[wc++]) << 4;
-                temp |= ((uint64)conv_buff[wc++]) << 12;
-                temp |= ((uint64)conv_buff[wc++]) << 20;
-                temp |= ((uint64)conv_buff[wc++]) << 28;
-                buffer[wp++] = temp;
-            }
+            dld9_unpack(buffer, conv_buff, wps);
             break;
      }
      return SCPE_OK;
@@ -138,9 +509,10 @@ disk_write(UNIT *uptr, uint64 *buffer, int sector, int wps)
     int      da;
     int      wc;
     int      bc;
-    int      wp;
-    uint64   temp;
     uint8    conv_buff[2048];
+
+    if (disk_cache_ok(uptr, wps) && disk_cache_write(uptr, buffer, sector) == SCPE_OK)
+        return SCPE_OK;
     switch(GET_FMT(uptr->flags)) {
     case SIMH:
             da = sector * wps;
@@ -149,40 +521,14 @@ disk_write(UNIT *uptr, uint64 *buffer, int sector, int wps)
             break;
     case DBD9:
             bc = (wps / 2) * 9;
-            for (wp = wc = 0; wp < wps;) {
-                temp = buffer[wp++];
-                conv_buff[wc++] = (uint8)((temp >> 28) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 20) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 12) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 4) & 0xff);
-                conv_buff[wc] = (uint8)((temp & 0xf) << 4);
-                temp = buffer[wp++];
-                conv_buff[wc++] |= (uint8)((temp >> 32) & 0xf);
-                conv_buff[wc++] = (uint8)((temp >> 24) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 16) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 8) & 0xff);
-                conv_buff[wc++] = (uint8)(temp & 0xff);
-            }
+            dbd9_pack(conv_buff, buffer, wps);
             da = sector * bc;
             (void)sim_fseek(uptr->fileref, da, SEEK_SET);
             wc = sim_fwrite (&conv_buff, 1, bc, uptr->fileref);
             return SCPE_OK;
     case DLD9:
             bc = (wps / 2) * 9;
-            for (wp = wc = 0; wp < wps;) {
-                temp = buffer[wp++];
-                conv_buff[wc++] = (uint8)(temp & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 8) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 16) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 24) & 0xff);
-                conv_buff[wc] = (uint8)((temp >> 32)  & 0xf);
-                temp = buffer[wp++];
-                conv_buff[wc++] |= (uint8)((temp << 4) & 0xf0);
-                conv_buff[wc++] = (uint8)((temp >> 4) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 12) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 20) & 0xff);
-                conv_buff[wc++] = (uint8)((temp >> 28) & 0xff);
-            }
+            dld9_pack(conv_buff, buffer, wps);
             da = sector * bc;
             (void)sim_fseek(uptr->fileref, da, SEEK_SET);
             wc = sim_fwrite (&conv_buff, 1, bc, uptr->fileref);
@@ -226,6 +572,78 @@ t_stat disk_show_fmt (FILE *st, UNIT *uptr, int32 val, CONST void *desc)
     return SCPE_OK;
 }
 
+/* Set cache size in words, with optional K or M */
+t_stat disk_set_cache (UNIT *uptr, int32 val, CONST char *cptr, void *desc)
+{
+    struct disk_cache *dc;
+    t_value  size;
+    CONST char *tptr;
+
+    if (uptr == NULL) return SCPE_IERR;
+    if (cptr == NULL || *cptr == 0) return SCPE_ARG;
+    size = strtotv(cptr, &tptr, 10);
+    if (tptr == cptr) return SCPE_ARG;
+    if (*tptr == 'K' || *tptr == 'k') {
+        size *= 1024;
+        tptr++;
+    } else if (*tptr == 'M' || *tptr == 'm') {
+        size *= 1024 * 1024;
+        tptr++;
+    }
+    if (*tptr != 0 || size > 01000000000)
+        return SCPE_ARG;
+    dc = (struct disk_cache *)uptr->up8;
+    if (dc == NULL) {
+        if (size == 0)
+            return SCPE_OK;
+        if ((dc = (struct disk_cache *)calloc(1, sizeof(struct disk_cache))) == NULL)
+            return SCPE_MEM;
+        uptr->up8 = dc;
+    }
+    disk_cache_free(uptr);
+    dc->size = (int32)size;
+    if (size != 0 && (uptr->flags & UNIT_ATT))
+        disk_cache_start(uptr);
+    else
+        uptr->io_flush = NULL;
+    return SCPE_OK;
+}
+
+/* Show cache size */
+t_stat disk_show_cache (FILE *st, UNIT *uptr, int32 val, CONST void *desc)
+{
+    struct disk_cache *dc = (struct disk_cache *)uptr->up8;
+
+    if (dc == NULL || dc->size == 0)
+        fprintf (st, "no cache");
+    else if (dc->size % (1024 * 1024) == 0)
+        fprintf (st, "cache=%dMW", dc->size / (1024 * 1024));
+    else if (dc->size % 1024 == 0)
+        fprintf (st, "cache=%dKW", dc->size / 1024);
+    else
+        fprintf (st, "cache=%dW", dc->size);
+    return SCPE_OK;
+}
+
+/*
+ * Set the number of sectors in a cylinder, the unit of caching.  Kept
+ * even without a cache, so SET CACHE after ATTACH can use it.
+ */
+void disk_set_cylinder (UNIT *uptr, int spc)
+{
+    struct disk_cache *dc = (struct disk_cache *)uptr->up8;
+
+    if (dc == NULL) {
+        if ((dc = (struct disk_cache *)calloc(1, sizeof(struct disk_cache))) == NULL)
+            return;
+        uptr->up8 = dc;
+    }
+    if (dc->spc == spc)
+        return;
+    disk_cache_free(uptr);
+    dc->spc = spc;
+}
+
 
 /* Device attach */
 t_stat disk_attach (UNIT *uptr, CONST char *cptr)
@@ -247,6 +665,8 @@ t_stat disk_attach (UNIT *uptr, CONST char *cptr)
     r = attach_unit (uptr, cptr);
     if (r != SCPE_OK)
         return r;
+    if (uptr->up8 != NULL && ((struct disk_cache *)uptr->up8)->size != 0)
+        disk_cache_start(uptr);
     return SCPE_OK;
 }
 
@@ -254,6 +674,8 @@ t_stat disk_attach (UNIT *uptr, CONST char *cptr)
 
 t_stat disk_detach (UNIT *uptr)
 {
+    disk_cache_free(uptr);
+    uptr->io_flush = NULL;
     return detach_unit (uptr);
 }
 
@@ -285,5 +707,9 @@ t_stat disk_attach_help(FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, const ch
     fprintf (st, "                is SIMH), other options are DBD9 and DLD9\n");
     fprintf (st, "    -Y          Answer Yes to prompt to overwrite last track (on disk create)\n");
     fprintf (st, "    -N          Answer No to prompt to overwrite last track (on disk create)\n");
+    fprintf (st, "\nSET %s0 CACHE=n keeps up to n words (K and M suffixes allowed) of the\n", dptr->name);
+    fprintf (st, "disk in memory a cylinder at a time, reading ahead on sequential access\n");
+    fprintf (st, "and holding written sectors until the unit is detached, the simulator\n");
+    fprintf (st, "stops or a few seconds have passed.  CACHE=0 turns the cache off.\n");
     return SCPE_OK;
 }
@@ -70,6 +70,14 @@ t_stat disk_write(UNIT *uptr, uint64 *buffer, int sector, int wps);
 t_stat disk_set_fmt (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 /* Show disk format */
 t_stat disk_show_fmt (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
+/* Set cylinder cache size */
+t_stat disk_set_cache (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
+/* Show cylinder cache size */
+t_stat disk_show_cache (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
+/* Set sectors per cylinder for the cache */
+void disk_set_cylinder (UNIT *uptr, int spc);
+/* Write back cached sectors */
+void disk_cache_flush (UNIT *uptr);
 /* Device attach */
 t_stat disk_attach (UNIT *uptr, CONST char *cptr);
 /* Device detach */
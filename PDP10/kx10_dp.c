@@ -272,6 +272,8 @@ MTAB                dp_mod[] = {
     {UNIT_DTYPE, (RP02_DTYPE << UNIT_V_DTYPE), "RP02", "RP02", &dp_set_type },
     {UNIT_DTYPE, (RP01_DTYPE << UNIT_V_DTYPE), "RP01", "RP01", &dp_set_type },
     {MTAB_XTD|MTAB_VUN, 0, "FORMAT", "FORMAT", NULL, &disk_show_fmt }, 
+    {MTAB_XTD|MTAB_VUN|MTAB_VALR, 0, "CACHE", "CACHE", &disk_set_cache,
+              &disk_show_cache, NULL, "Sets size of cylinder cache in words" },
     {0},
 };
 
@@ -943,6 +945,9 @@ t_stat dp_attach (UNIT *uptr, CONST char *cptr)
     int ctlr;
 
     r = disk_attach (uptr, cptr);
+    if (r == SCPE_OK)
+        disk_set_cylinder(uptr, dp_drv_tab[GET_DTYPE (uptr->flags)].sect *
+                                dp_drv_tab[GET_DTYPE (uptr->flags)].surf);
     if (r != SCPE_OK || (sim_switches & SIM_SW_REST) != 0)
         return r;
     uptr->capac = dp_drv_tab[GET_DTYPE (uptr->flags)].size;
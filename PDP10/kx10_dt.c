@@ -93,8 +93,10 @@
 #define DT_NUMDR        8                           /* #drives */
 #define UNIT_V_8FMT     (UNIT_V_UF + 0)             /* 12b format */
 #define UNIT_V_11FMT    (UNIT_V_UF + 1)             /* 16b format */
+#define UNIT_V_MAP      (UNIT_V_UF + 2)             /* file mapped */
 #define UNIT_8FMT       (1 << UNIT_V_8FMT)
 #define UNIT_11FMT      (1 << UNIT_V_11FMT)
+#define UNIT_MAP        (1 << UNIT_V_MAP)
 
 /* System independent DECtape constants */
 
@@ -421,6 +423,17 @@ t_stat dt_devio(uint32 dev, uint64 *data) {
                   dtsb |= DTB_IDL;
               }
           }
+          /* Write functions are illegal on a write locked unit */
+          i = DTC_GETUNI(dtsa);
+          if (i < DT_NUMDR && (dt_unit[i].flags & UNIT_RO) != 0) {
+              dtsb |= DTB_WRLK;
+              if (DTC_GETFNC(dtsa) >= FNC_WMRK) {
+                  dtsa &= ~0700;
+                  dtsb |= DTB_ILL;
+                  if (dtsb & DTB_ILLENB)
+                     set_interrupt(DT_DEVNUM, dtsa);
+              }
+          }
           if (*data & (DTC_FWDRV|DTC_RVDRV|DTC_STSTOP)) {
               i = DTC_GETUNI(dtsa);
 #if DT_NUMDR < 8
@@ -1154,7 +1167,9 @@ t_stat dt_attach (UNIT *uptr, CONST char *cptr)
     if (r != SCPE_OK)                                       /* error? */
         return r;
     if ((sim_switches & SIM_SW_REST) == 0) {                /* not from rest? */
-        uptr->flags = uptr->flags & ~(UNIT_8FMT | UNIT_11FMT);      /* default 18b */
+        uptr->flags = uptr->flags & ~(UNIT_8FMT | UNIT_11FMT | UNIT_MAP); /* default 18b */
+        if (sim_switches & SWMASK ('M'))                    /* map file? */
+            uptr->flags = uptr->flags | UNIT_MAP;
         if (sim_switches & SWMASK ('T'))                    /* att 12b? */
             uptr->flags = uptr->flags | UNIT_8FMT;
         else if (sim_switches & SWMASK ('S'))               /* att 16b? */
@@ -1168,6 +1183,24 @@ t_stat dt_attach (UNIT *uptr, CONST char *cptr)
         }
     }
     uptr->capac = DTU_CAPAC (uptr);                         /* set capacity */
+    if (uptr->flags & UNIT_MAP) {                           /* 18b/36b only */
+        FMAP   *fmap;
+
+        if ((uptr->flags & (UNIT_8FMT | UNIT_11FMT)) == 0 && sim_end &&
+            sim_fmap_open (uptr->fileref, uptr->capac * sizeof (uint32),
+                (uptr->flags & UNIT_RO) != 0, &fmap, &uptr->filebuf) == SCPE_OK) {
+            uptr->up8 = fmap;
+            sim_printf ("%s%d: 18b/36b format, mapping file into memory\n",
+                        sim_dname (&dt_dev), u);
+            uptr->io_flush = dt_flush;
+            uptr->hwmark = uptr->capac;
+            uptr->pos = DT_EZLIN;                           /* beyond leader */
+            uptr->WRITTEN = 0;
+            return SCPE_OK;
+        }
+        uptr->flags = uptr->flags & ~UNIT_MAP;
+        sim_printf ("%s%d: can't map file\n", sim_dname (&dt_dev), u);
+    }
     uptr->filebuf = calloc (uptr->capac, sizeof (uint32));
     if (uptr->filebuf == NULL) {                            /* can't alloc? */
         detach_unit (uptr);
@@ -1232,6 +1265,12 @@ void dt_flush (UNIT* uptr)
     uint16 pdp11b[D18_BSIZE];
     uint32 ba, k, *fbuf;
 
+    if (uptr->flags & UNIT_MAP) {                           /* mapped? */
+        if (uptr->WRITTEN)
+            sim_fmap_sync ((FMAP *) uptr->up8);
+        uptr->WRITTEN = 0;
+        return;
+    }
     if (uptr->WRITTEN && uptr->hwmark && ((uptr->flags & UNIT_RO) == 0)) {   /* any data? */
         rewind (uptr->fileref);                             /* start of file */
         fbuf = (uint32 *) uptr->filebuf;                    /* file buffer */
@@ -1284,14 +1323,19 @@ t_stat dt_detach (UNIT* uptr)
         sim_cancel (uptr);
         uptr->CMD = uptr->pos = 0;
     }
-    if (uptr->hwmark && ((uptr->flags & UNIT_RO) == 0)) {   /* any data? */
-        sim_printf ("%s%d: writing buffer to file\n", sim_dname (&dt_dev), u);
-        dt_flush(uptr);
-    }                                                       /* end if hwmark */
-    free (uptr->filebuf);                                   /* release buf */
+    if (uptr->flags & UNIT_MAP) {                           /* mapped? */
+        sim_fmap_close ((FMAP *) uptr->up8);                /* write and unmap */
+        uptr->up8 = NULL;
+    } else {
+        if (uptr->hwmark && ((uptr->flags & UNIT_RO) == 0)) { /* any data? */
+            sim_printf ("%s%d: writing buffer to file\n", sim_dname (&dt_dev), u);
+            dt_flush(uptr);
+        }                                                   /* end if hwmark */
+        free (uptr->filebuf);                               /* release buf */
+    }
     uptr->flags = uptr->flags & ~UNIT_BUF;                  /* clear buf flag */
     uptr->filebuf = NULL;                                   /* clear buf ptr */
-    uptr->flags = uptr->flags & ~(UNIT_8FMT | UNIT_11FMT);  /* default fmt */
+    uptr->flags = uptr->flags & ~(UNIT_8FMT | UNIT_11FMT | UNIT_MAP); /* default fmt */
     uptr->capac = DT_CAPAC;                                 /* default size */
     return detach_unit (uptr);
 }
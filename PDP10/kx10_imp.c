@@ -130,8 +130,14 @@
 #define ILEN       u6    /* Size of input buffer in bits */
 
 
-#define IMP_ARPTAB_SIZE        64
+#define IMP_ARPTAB_SIZE        64      /* Initial ARP table size */
+#define IMP_ARPTAB_MAX         4096    /* Largest ARP table */
 #define IMP_ARP_MAX_AGE        100
+#define IMP_PORTMAP_SIZE       64      /* Initial port map size */
+#define IMP_PORTMAP_MAX        16384   /* Largest port map */
+
+/* Tables are open hashed, size is a power of 2 */
+#define IMP_HASH(k, size)      ((((uint32)(k) * 0x9E3779B1u) >> 16) & ((size) - 1))
 
 uint32 mask[] = {
      0xFFFFFFFF, 0xFFFFFFFE, 0xFFFFFFFC, 0xFFFFFFF8,
@@ -370,6 +376,7 @@ struct imp_map {
     uint16            sport;                   /* Port to fix */
     uint16            dport;                   /* Port to fix */
     uint16            cls_tim;                 /* Close timer */
+    uint8             expired;                 /* Close timer ran out */
     uint32            adj;                     /* Amount to adjust */
     uint32            lseq;                    /* Sequence number last adjusted */
 };
@@ -402,7 +409,13 @@ struct imp_device {
     in_addr_T         hostip;                  /* IP address of local host */
     in_addr_T         gwip;                    /* Gateway IP address */
     int               maskbits;                /* Mask length */
-    struct imp_map    port_map[64];            /* Ports to adjust */
+    struct imp_map    *port_map;               /* Ports to adjust, hashed */
+    int               port_size;               /* Size of port_map */
+    int               port_cnt;                /* Entries in port_map */
+    in_addr_T         adj_ip;                  /* ip adj_in/out computed for */
+    in_addr_T         adj_hostip;              /* hostip adj_in/out computed for */
+    uint32            adj_in;                  /* Checksum change ip to hostip */
+    uint32            adj_out;                 /* Checksum change hostip to ip */
     in_addr_T         dhcpip;                  /* DHCP server address */
     uint8             dhcp_state;              /* State of DHCP */
     uint32            dhcp_lease;              /* DHCP lease time */
@@ -426,7 +439,9 @@ struct imp_device {
     int               host_error;
     int               rfnm_count;              /* Number of pending RFNM packets */
     int               pia;                     /* PIA channels */
-    struct arp_entry  arp_table[IMP_ARPTAB_SIZE];
+    struct arp_entry  *arp_table;              /* ARP cache, hashed on IP */
+    int               arp_size;                /* Size of arp_table */
+    int               arp_cnt;                 /* Entries in arp_table */
 } imp_data;
 
 extern int32 tmxr_poll;
@@ -464,6 +479,10 @@ void           imp_arp_update(struct imp_device *imp, in_addr_T ipaddr, ETH_MAC
 void           imp_arp_arpin(struct imp_device *imp, ETH_PACK *packet);
 void           imp_arp_arpout(struct imp_device *imp, in_addr_T ipaddr);
 struct arp_entry * imp_arp_lookup(struct imp_device *imp, in_addr_T ipaddr);
+void           imp_arp_clear(struct imp_device *imp);
+struct imp_map * imp_port_lookup(struct imp_device *imp, uint16 sport, uint16 dport);
+struct imp_map * imp_port_enter(struct imp_device *imp, uint16 sport, uint16 dport);
+void           imp_port_free(struct imp_device *imp, struct imp_map *map);
 void           imp_packet_out(struct imp_device *imp, ETH_PACK *packet);
 void           imp_packet_debug(struct imp_device *imp, const char *action, ETH_PACK *packet);
 void           imp_write(struct imp_device *imp, ETH_PACK *packet);
@@ -787,6 +806,43 @@ t_stat imp_srv(UNIT * uptr)
     return SCPE_OK;
 }
 
+/*
+ * Add len octets to a one's complement sum a 32 bit word at a time.
+ * If inv is all ones, the complement of each octet pair is added.
+ */
+static uint64
+ip_sum(uint64 sum, const uint8 *ptr, int len, uint32 inv)
+{
+    uint32 w;
+
+    while (len > 3) {
+        memcpy(&w, ptr, sizeof(w));
+        sum += ntohl(w) ^ inv;
+        ptr += 4;
+        len -= 4;
+    }
+    if (len > 1) {
+        sum += (((ptr[0] << 8) | ptr[1]) ^ inv) & 0xffff;
+        ptr += 2;
+        len -= 2;
+    }
+    /*  Add left-over byte, if any */
+    if (len > 0)
+        sum += ((ptr[0] << 8) ^ inv) & 0xffff;
+    return sum;
+}
+
+/*
+ * Fold one's complement sum to 16 bits.
+ */
+static uint32
+ip_fold(uint64 sum)
+{
+    while (sum >> 16)
+       sum = (sum & 0xffff) + (sum >> 16);
+    return (uint32)sum;
+}
+
 void
 ip_checksum(uint8 *chksum, uint8 *ptr, int len)
 {
@@ -794,28 +850,29 @@ ip_checksum(uint8 *chksum, uint8 *ptr, int len)
     * Compute Internet Checksum for "count" bytes
     *         beginning at location "addr".
     */
-   int32  sum = 0;
+    uint32 sum = ip_fold(ip_sum(0, ptr, len, 0));
 
-   while( len > 1 )  {
-      /*  This is the inner loop */
-      sum += (ptr[0]<<8)+ptr[1];
-      ptr+=2;
-      len -= 2;
-   }
-
-   /*  Add left-over byte, if any */
-   if( len > 0 )
-      sum += ptr[0]<<8;
-
-    /*  Fold 32-bit sum to 16 bits */
-    while (sum>>16)
-       sum = (sum & 0xffff) + (sum >> 16);
     sum=(~sum & 0xffff);
     chksum[0]=(sum>>8) & 0xff;
     chksum[1]=sum & 0xff;
 }
 
 
+/*
+ * Apply a change in one's complement sum to the checksum.
+ */
+static void
+checksumdelta(uint8 *chksum, uint32 delta)
+{
+    uint32 sum;
+
+    sum=(chksum[0]<<8)+chksum[1];
+    sum=ip_fold((uint64)(~sum & 0xffff) + delta);
+    sum=(~sum & 0xffff);
+    chksum[0]=sum>>8;
+    chksum[1]=sum & 0xff;
+}
+
 /*
  * Update the checksum based on code from RFC1631
  */
@@ -826,39 +883,38 @@ checksumadjust(uint8 *chksum, uint8 *optr,
      - chksum points to the chksum in the packet
      - optr points to the old data in the packet
      - nptr points to the new data in the packet
-     - even number of octets updated.
+     - old data is subtracted by adding its complement.
    */
 {
-    int32 sum, old, new_sum;
-    sum=(chksum[0]<<8)+chksum[1];
-    sum=(~sum & 0xffff);
-    while (olen > 1) {
-        old=(optr[0]<<8)+optr[1];
-        optr+=2;
-        sum-=old & 0xffff;
-        if (sum<=0) { sum--; sum&=0xffff; }
-        olen-=2;
-    }
-    if (olen > 0) {
-        old=optr[0]<<8;
-        sum-=old & 0xffff;
-        if (sum<=0) { sum--; sum&=0xffff; }
-    }
-    while (nlen > 1) {
-        new_sum=(nptr[0]<<8)+nptr[1];
-        nptr+=2;
-        sum+=new_sum & 0xffff;
-        if (sum & 0x10000) { sum++; sum&=0xffff; }
-        nlen-=2;
-    }
-    if (nlen > 0) {
-        new_sum=(nptr[0]<<8);
-        sum+=new_sum & 0xffff;
-        if (sum & 0x10000) { sum++; sum&=0xffff; }
-    }
-    sum=(~sum & 0xffff);
-    chksum[0]=sum>>8;
-    chksum[1]=sum & 0xff;
+    uint64 sum = 0;
+
+    sum = ip_sum(sum, optr, olen, 0xffffffff);
+    sum = ip_sum(sum, nptr, nlen, 0);
+    checksumdelta(chksum, ip_fold(sum));
+}
+
+/*
+ * Checksum change when replacing address oaddr with naddr.
+ */
+static uint32
+ip_addr_delta(in_addr_T oaddr, in_addr_T naddr)
+{
+    return ip_fold((uint64)(~ntohl(oaddr)) + ntohl(naddr));
+}
+
+/*
+ * Update checksum changes for translating between ip and hostip,
+ * recomputed only when either address changes.
+ */
+static void
+imp_adj_update(struct imp_device *imp)
+{
+    if (imp->adj_ip == imp->ip && imp->adj_hostip == imp->hostip)
+        return;
+    imp->adj_ip = imp->ip;
+    imp->adj_hostip = imp->hostip;
+    imp->adj_in = ip_addr_delta(imp->ip, imp->hostip);
+    imp->adj_out = ip_addr_delta(imp->hostip, imp->ip);
 }
 
 t_stat imp_eth_srv(UNIT * uptr)
@@ -897,6 +953,116 @@ t_stat imp_eth_srv(UNIT * uptr)
     return SCPE_OK;
 }
 
+/*
+ * Put copy of entry into first free slot of port map.
+ */
+static struct imp_map *
+imp_port_put(struct imp_device *imp, struct imp_map *ent)
+{
+    uint32    i = IMP_HASH(((uint32)ent->sport << 16) | ent->dport,
+                           imp->port_size);
+
+    while (imp->port_map[i].dport != 0)
+        i = (i + 1) & (imp->port_size - 1);
+    imp->port_map[i] = *ent;
+    imp->port_cnt++;
+    return &imp->port_map[i];
+}
+
+/*
+ * Double the size of port map, rehashing entries.
+ */
+static void
+imp_port_grow(struct imp_device *imp)
+{
+    struct imp_map *old = imp->port_map;
+    int             osize = imp->port_size;
+    int             size = (osize == 0) ? IMP_PORTMAP_SIZE : osize * 2;
+    int             i;
+
+    if (size > IMP_PORTMAP_MAX)
+        return;
+    imp->port_map = (struct imp_map *)calloc(size, sizeof(struct imp_map));
+    if (imp->port_map == NULL) {
+        imp->port_map = old;
+        return;
+    }
+    imp->port_size = size;
+    imp->port_cnt = 0;
+    for (i = 0; i < osize; i++) {
+        if (old[i].dport != 0)
+            (void)imp_port_put(imp, &old[i]);
+    }
+    free(old);
+}
+
+/*
+ * Find port map entry for connection, NULL if none.
+ */
+struct imp_map *
+imp_port_lookup(struct imp_device *imp, uint16 sport, uint16 dport)
+{
+    struct imp_map *map;
+    uint32          i;
+
+    if (imp->port_cnt == 0)
+        return NULL;
+    i = IMP_HASH(((uint32)sport << 16) | dport, imp->port_size);
+    while ((map = &imp->port_map[i])->dport != 0) {
+        if (map->sport == sport && map->dport == dport)
+            return map;
+        i = (i + 1) & (imp->port_size - 1);
+    }
+    return NULL;
+}
+
+/*
+ * Find or create port map entry for connection.
+ * Returns NULL if map is full.
+ */
+struct imp_map *
+imp_port_enter(struct imp_device *imp, uint16 sport, uint16 dport)
+{
+    struct imp_map  ent;
+    struct imp_map *map;
+
+    if (dport == 0)
+        return NULL;
+    if ((map = imp_port_lookup(imp, sport, dport)) != NULL)
+        return map;
+    /* Keep load under half so probes stay short */
+    if (2 * (imp->port_cnt + 1) > imp->port_size) {
+        imp_port_grow(imp);
+        if (2 * (imp->port_cnt + 1) > imp->port_size)
+            return NULL;
+    }
+    memset(&ent, 0, sizeof(ent));
+    ent.sport = sport;
+    ent.dport = dport;
+    return imp_port_put(imp, &ent);
+}
+
+/*
+ * Remove entry from port map.
+ */
+void
+imp_port_free(struct imp_device *imp, struct imp_map *map)
+{
+    struct imp_map  ent;
+    uint32          i = (uint32)(map - imp->port_map);
+
+    memset(map, 0, sizeof(*map));
+    imp->port_cnt--;
+    /* Reenter rest of run so lookups don't stop at the hole */
+    for (i = (i + 1) & (imp->port_size - 1); imp->port_map[i].dport != 0;
+         i = (i + 1) & (imp->port_size - 1)) {
+        ent = imp->port_map[i];
+        memset(&imp->port_map[i], 0, sizeof(ent));
+        imp->port_cnt--;
+        (void)imp_port_put(imp, &ent);
+    }
+}
+
 void
 imp_timer_task(struct imp_device *imp)
 {
@@ -904,15 +1070,17 @@ imp_timer_task(struct imp_device *imp)
     int                 n;
 
     /* Scan through adjusted ports and remove old ones */
-    for (n = 0; n < 64; n++) {
+    for (n = 0; n < imp->port_size; n++) {
         if (imp->port_map[n].cls_tim > 0) {
-            if (--imp->port_map[n].cls_tim == 0) {
-                imp->port_map[n].dport = 0;
-                imp->port_map[n].sport = 0;
-                imp->port_map[n].adj = 0;
-            }
+            if (--imp->port_map[n].cls_tim == 0)
+                imp->port_map[n].expired = 1;
         }
     }
+    /* Freeing moves entries, so recheck slot */
+    for (n = 0; n < imp->port_size; n++) {
+        while (imp->port_map[n].dport != 0 && imp->port_map[n].expired)
+            imp_port_free(imp, &imp->port_map[n]);
+    }
 
     /* Scan the send queue and see if any packets have timed out */
     while (imp->sendq != NULL) {
@@ -1016,6 +1184,7 @@ imp_packet_in(struct imp_device *imp)
            if (ip_hdr->ip_dst == imp_data.ip && imp_data.hostip != 0) {
                uint8   *payload = (uint8 *)(&imp->rbuffer[pad +
                                            (ip_hdr->ip_v_hl & 0xf) * 4]);
+               imp_adj_update(imp);
                /* If TCP packet update the TCP checksum */
                if (ip_hdr->ip_p == TCP_PROTO) {
                    struct tcp *tcp_hdr = (struct tcp *)payload;
@@ -1025,31 +1194,25 @@ imp_packet_in(struct imp_device *imp)
                    int          hl = (ip_hdr->ip_v_hl & 0xf) * 4;
                    uint8       *tcp_payload = &imp->rbuffer[
                             sizeof(struct imp_eth_hdr) + hl + thl];
-                   checksumadjust((uint8 *)&tcp_hdr->chksum,
-                              (uint8 *)(&ip_hdr->ip_dst), sizeof(in_addr_T),
-                              (uint8 *)(&imp_data.hostip), sizeof(in_addr_T));
+                   /* ip_dst is ip, so use precomputed change */
+                   checksumdelta((uint8 *)&tcp_hdr->chksum, imp->adj_in);
                    if ((ntohs(tcp_hdr->flags) & 0x10) != 0) {
-                       for (n = 0; n < 64; n++) {
-                           if (imp->port_map[n].sport == sport &&
-                               imp->port_map[n].dport == dport) {
-                               /* Check if SYN */
-                               if (ntohs(tcp_hdr->flags) & 02) {
-                                   imp->port_map[n].sport = 0;
-                                   imp->port_map[n].dport = 0;
-                                   imp->port_map[n].adj = 0;
-                               } else {
-                                   uint32   new_seq = ntohl(tcp_hdr->ack);
-                                   if (new_seq > imp->port_map[n].lseq) {
-                                       new_seq = htonl(new_seq - imp->port_map[n].adj);
-                                       checksumadjust((uint8 *)&tcp_hdr->chksum,
-                                               (uint8 *)(&tcp_hdr->ack), 4,
-                                               (uint8 *)(&new_seq), 4);
-                                       tcp_hdr->ack = new_seq;
-                                   }
+                       struct imp_map *map = imp_port_lookup(imp, sport, dport);
+                       if (map != NULL) {
+                           /* Check if SYN */
+                           if (ntohs(tcp_hdr->flags) & 02) {
+                               imp_port_free(imp, map);
+                           } else {
+                               uint32   new_seq = ntohl(tcp_hdr->ack);
+                               if (new_seq > map->lseq) {
+                                   new_seq = htonl(new_seq - map->adj);
+                                   checksumadjust((uint8 *)&tcp_hdr->chksum,
+                                           (uint8 *)(&tcp_hdr->ack), 4,
+                                           (uint8 *)(&new_seq), 4);
+                                   tcp_hdr->ack = new_seq;
                                }
                                if (ntohs(tcp_hdr->flags) & 01)
-                                   imp->port_map[n].cls_tim = 100;
-                               break;
+                                   map->cls_tim = 100;
                            }
                        }
                     }
@@ -1078,23 +1241,12 @@ imp_packet_in(struct imp_device *imp)
                        memcpy(tcp_payload, port_buffer, nlen);
                        /* Check if we need to update the sequence numbers */
                        if (nlen != l && (ntohs(tcp_hdr->flags) & 02) == 0) {
-                           int n = -1;
+                           struct imp_map *map = imp_port_enter(imp, sport, dport);
                            /* See if we need to change the sequence number */
-                           for (i = 0; i < 64; i++) {
-                               if (imp->port_map[i].sport == sport &&
-                                   imp->port_map[i].dport == dport) {
-                                   n = i;
-                                   break;
-                               }
-                               if (n < 0 && imp->port_map[i].dport == 0)
-                                   n = 0;
-                           }
-                           if (n >= 0) {
-                               imp->port_map[n].dport = dport;
-                               imp->port_map[n].sport = sport;
-                               imp->port_map[n].adj += nlen - l;
-                               imp->port_map[n].cls_tim = 0;
-                               imp->port_map[n].lseq = ntohl(tcp_hdr->seq);
+                           if (map != NULL) {
+                               map->adj += nlen - l;
+                               map->cls_tim = 0;
+                               map->lseq = ntohl(tcp_hdr->seq);
                            }
                        }
                        /* Now we need to update the checksums */
@@ -1133,9 +1285,7 @@ imp_packet_in(struct imp_device *imp)
                                   (uint8 *)(&ip_hdr->ip_src), sizeof(in_addr_T),
                                   (uint8 *)(&imp_data.hostip), sizeof(in_addr_T));
                }
-               checksumadjust((uint8 *)&ip_hdr->ip_sum,
-                            (uint8 *)(&ip_hdr->ip_dst), sizeof(in_addr_T),
-                            (uint8 *)(&imp_data.hostip), sizeof(in_addr_T));
+               checksumdelta((uint8 *)&ip_hdr->ip_sum, imp->adj_in);
                ip_hdr->ip_dst = imp_data.hostip;
            }
            /* If we are not initializing queue it up for host */
@@ -1251,6 +1401,14 @@ imp_packet_out(struct imp_device *imp, ETH_PACK *packet) {
        int          hl = (pkt->iphdr.ip_v_hl & 0xf) * 4;
        uint8        *payload = (uint8 *)(&packet->msg[
                             sizeof(struct imp_eth_hdr) + hl]);
+       uint32       adj;
+
+       /* Change in checksum for new source, precomputed for hostip */
+       imp_adj_update(imp);
+       if (pkt->iphdr.ip_src == imp->hostip)
+           adj = imp->adj_out;
+       else
+           adj = ip_addr_delta(pkt->iphdr.ip_src, imp->ip);
        /* If TCP packet update the TCP checksum */
        if (pkt->iphdr.ip_p == TCP_PROTO) {
            struct tcp  *tcp_hdr = (struct tcp *)payload;
@@ -1259,32 +1417,25 @@ imp_packet_out(struct imp_device *imp, ETH_PACK *packet) {
            uint16       dport = ntohs(tcp_hdr->tcp_dport);
            uint8       *tcp_payload = &packet->msg[
                     sizeof(struct imp_eth_hdr) + hl + thl];
+           struct imp_map *map;
            /* Update pseudo header checksum */
-           checksumadjust((uint8 *)&tcp_hdr->chksum,
-                       (uint8 *)(&pkt->iphdr.ip_src), sizeof(in_addr_T),
-                       (uint8 *)(&imp->ip), sizeof(in_addr_T));
+           checksumdelta((uint8 *)&tcp_hdr->chksum, adj);
            /* See if we need to change the sequence number */
-           for (i = 0; i < 64; i++) {
-               if (imp->port_map[i].sport == sport &&
-                   imp->port_map[i].dport == dport) {
-                   /* Check if SYN */
-                   if (ntohs(tcp_hdr->flags) & 02) {
-                       imp->port_map[i].sport = 0;
-                       imp->port_map[i].dport = 0;
-                       imp->port_map[i].adj = 0;
-                   } else {
-                       uint32   new_seq = ntohl(tcp_hdr->seq);
-                       if (new_seq > imp->port_map[i].lseq) {
-                           new_seq = htonl(new_seq + imp->port_map[i].adj);
-                           checksumadjust((uint8 *)&tcp_hdr->chksum,
-                                   (uint8 *)(&tcp_hdr->seq), 4,
-                                   (uint8 *)(&new_seq), 4);
-                           tcp_hdr->seq = new_seq;
-                       }
+           if ((map = imp_port_lookup(imp, sport, dport)) != NULL) {
+               /* Check if SYN */
+               if (ntohs(tcp_hdr->flags) & 02) {
+                   imp_port_free(imp, map);
+               } else {
+                   uint32   new_seq = ntohl(tcp_hdr->seq);
+                   if (new_seq > map->lseq) {
+                       new_seq = htonl(new_seq + map->adj);
+                       checksumadjust((uint8 *)&tcp_hdr->chksum,
+                               (uint8 *)(&tcp_hdr->seq), 4,
+                               (uint8 *)(&new_seq), 4);
+                       tcp_hdr->seq = new_seq;
                    }
                    if (ntohs(tcp_hdr->flags) & 01)
-                       imp->port_map[i].cls_tim = 100;
-                   break;
+                       map->cls_tim = 100;
                }
            }
            /* Check if sending to FTP */
@@ -1311,23 +1462,11 @@ imp_packet_out(struct imp_device *imp, ETH_PACK *packet) {
                memcpy(tcp_payload, port_buffer, nlen);
                /* Check if we need to update the sequence numbers */
                if (nlen != l && (ntohs(tcp_hdr->flags) & 02) == 0) {
-                   int n = -1;
                    /* See if we need to change the sequence number */
-                   for (i = 0; i < 64; i++) {
-                       if (imp->port_map[i].sport == sport &&
-                           imp->port_map[i].dport == dport) {
-                           n = i;
-                           break;
-                       }
-                       if (n < 0 && imp->port_map[i].dport == 0)
-                           n = 0;
-                   }
-                   if (n >= 0) {
-                       imp->port_map[n].dport = dport;
-                       imp->port_map[n].sport = sport;
-                       imp->port_map[n].adj += nlen - l;
-                       imp->port_map[n].cls_tim = 0;
-                       imp->port_map[n].lseq = ntohl(tcp_hdr->seq);
+                   if ((map = imp_port_enter(imp, sport, dport)) != NULL) {
+                       map->adj += nlen - l;
+                       map->cls_tim = 0;
+                       map->lseq = ntohl(tcp_hdr->seq);
                    }
                }
                /* Now we need to update the checksums */
@@ -1349,22 +1488,16 @@ imp_packet_out(struct imp_device *imp, ETH_PACK *packet) {
        /* Check if UDP */
        } else if (pkt->iphdr.ip_p == UDP_PROTO) {
              struct udp *udp_hdr = (struct udp *)payload;
-             checksumadjust((uint8 *)&udp_hdr->chksum,
-                  (uint8 *)(&pkt->iphdr.ip_src), sizeof(in_addr_T),
-                  (uint8 *)(&imp->ip), sizeof(in_addr_T));
+             checksumdelta((uint8 *)&udp_hdr->chksum, adj);
         /* Lastly check if ICMP */
        } else if (pkt->iphdr.ip_p == ICMP_PROTO) {
              struct icmp *icmp_hdr = (struct icmp *)payload;
              if ((icmp_hdr->type != 0) &&   /*     Not Echo Reply */
                  (icmp_hdr->type != 8))     /* and Not Echo */
-                 checksumadjust((uint8 *)&icmp_hdr->chksum,
-                      (uint8 *)(&pkt->iphdr.ip_src), sizeof(in_addr_T),
-                      (uint8 *)(&imp->ip), sizeof(in_addr_T));
+                 checksumdelta((uint8 *)&icmp_hdr->chksum, adj);
        }
        /* Lastly update the header and IP address */
-       checksumadjust((uint8 *)&pkt->iphdr.ip_sum,
-                 (uint8 *)(&pkt->iphdr.ip_src), sizeof(in_addr_T),
-                 (uint8 *)(&imp->ip), sizeof(in_addr_T));
+       checksumdelta((uint8 *)&pkt->iphdr.ip_sum, adj);
        pkt->iphdr.ip_src = imp->ip;
     }
 
@@ -1379,16 +1512,13 @@ imp_packet_out(struct imp_device *imp, ETH_PACK *packet) {
     if ((imp->ip & imp->ip_mask) != (ipaddr & imp->ip_mask))
         ipaddr = imp->gwip;
 
-    for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
-        tabptr = &imp->arp_table[i];
-        if (ipaddr == tabptr->ipaddr) {
-            memcpy(&pkt->ethhdr.dest, &tabptr->ethaddr, 6);
-            memcpy(&pkt->ethhdr.src, &imp->mac, 6);
-            pkt->ethhdr.type = htons(ETHTYPE_IP);
-            imp_write(imp, packet);
-            imp->rfnm_count++;
-            return;
-         }
+    if ((tabptr = imp_arp_lookup(imp, ipaddr)) != NULL) {
+        memcpy(&pkt->ethhdr.dest, &tabptr->ethaddr, 6);
+        memcpy(&pkt->ethhdr.src, &imp->mac, 6);
+        pkt->ethhdr.type = htons(ETHTYPE_IP);
+        imp_write(imp, packet);
+        imp->rfnm_count++;
+        return;
     }
 
     /* Queue packet for later send */
@@ -1659,61 +1789,132 @@ void imp_write(struct imp_device *imp, ETH_PACK *packet) {
 }
 
 /*
- * Update the ARP table, first use free entry, else use oldest.
+ * Put copy of entry into first free slot of ARP table.
+ */
+static struct arp_entry *
+imp_arp_put(struct imp_device *imp, struct arp_entry *ent)
+{
+    uint32    i = IMP_HASH(ent->ipaddr, imp->arp_size);
+
+    while (imp->arp_table[i].ipaddr != 0)
+        i = (i + 1) & (imp->arp_size - 1);
+    imp->arp_table[i] = *ent;
+    imp->arp_cnt++;
+    return &imp->arp_table[i];
+}
+
+/*
+ * Double the size of ARP table, rehashing entries.
+ */
+static void
+imp_arp_grow(struct imp_device *imp)
+{
+    struct arp_entry *old = imp->arp_table;
+    int               osize = imp->arp_size;
+    int               size = (osize == 0) ? IMP_ARPTAB_SIZE : osize * 2;
+    int               i;
+
+    if (size > IMP_ARPTAB_MAX)
+        return;
+    imp->arp_table = (struct arp_entry *)calloc(size, sizeof(struct arp_entry));
+    if (imp->arp_table == NULL) {
+        imp->arp_table = old;
+        return;
+    }
+    imp->arp_size = size;
+    imp->arp_cnt = 0;
+    for (i = 0; i < osize; i++) {
+        if (old[i].ipaddr != 0)
+            (void)imp_arp_put(imp, &old[i]);
+    }
+    free(old);
+}
+
+/*
+ * Remove entry from ARP table.
+ */
+static void
+imp_arp_free(struct imp_device *imp, struct arp_entry *tabptr)
+{
+    struct arp_entry  ent;
+    uint32            i = (uint32)(tabptr - imp->arp_table);
+
+    memset(tabptr, 0, sizeof(*tabptr));
+    imp->arp_cnt--;
+    /* Reenter rest of run so lookups don't stop at the hole */
+    for (i = (i + 1) & (imp->arp_size - 1); imp->arp_table[i].ipaddr != 0;
+         i = (i + 1) & (imp->arp_size - 1)) {
+        ent = imp->arp_table[i];
+        memset(&imp->arp_table[i], 0, sizeof(ent));
+        imp->arp_cnt--;
+        (void)imp_arp_put(imp, &ent);
+    }
+}
+
+/*
+ * Remove all entries from ARP table.
+ */
+void
+imp_arp_clear(struct imp_device *imp)
+{
+    if (imp->arp_table != NULL)
+        memset(imp->arp_table, 0, imp->arp_size * sizeof(struct arp_entry));
+    imp->arp_cnt = 0;
+}
+
+/*
+ * Update the ARP table, growing it as needed, when full use oldest.
  */
 void
 imp_arp_update(struct imp_device *imp, in_addr_T ipaddr, ETH_MAC *ethaddr, int age)
 {
     struct arp_entry  *tabptr;
+    struct arp_entry   ent;
     int                i;
     char               mac_buf[20];
 
     /* Check if entry already in the table. */
-    for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
-        tabptr = &imp->arp_table[i];
-
-        if (tabptr->ipaddr != 0) {
-            if (tabptr->ipaddr == ipaddr) {
-                if (0 != memcmp(&tabptr->ethaddr, ethaddr, sizeof(ETH_MAC))) {
-                    memcpy(&tabptr->ethaddr, ethaddr, sizeof(ETH_MAC));
-                    eth_mac_fmt(ethaddr, mac_buf);
-                    sim_debug(DEBUG_ARP, &imp_dev,
-                              "updating entry for IP %s to %s\n", 
-                              ipv4_inet_ntoa(*((struct in_addr *)&ipaddr)), mac_buf);
-                    }
-                if (tabptr->age != ARP_DONT_AGE)
-                    tabptr->age = age;
-                return;
+    if ((tabptr = imp_arp_lookup(imp, ipaddr)) != NULL) {
+        if (0 != memcmp(&tabptr->ethaddr, ethaddr, sizeof(ETH_MAC))) {
+            memcpy(&tabptr->ethaddr, ethaddr, sizeof(ETH_MAC));
+            eth_mac_fmt(ethaddr, mac_buf);
+            sim_debug(DEBUG_ARP, &imp_dev,
+                      "updating entry for IP %s to %s\n", 
+                      ipv4_inet_ntoa(*((struct in_addr *)&ipaddr)), mac_buf);
             }
-        }
-     }
-
-    /* See if we can find an unused entry. */
-    for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
-        tabptr = &imp->arp_table[i];
-
-        if (tabptr->ipaddr == 0)
-            break;
+        if (tabptr->age != ARP_DONT_AGE)
+            tabptr->age = age;
+        return;
     }
 
-    /* If no empty entry search for oldest one. */
-    if (tabptr->ipaddr != 0) {
-        int       fnd = 0;
+    /* Keep load under half so probes stay short */
+    if (2 * (imp->arp_cnt + 1) > imp->arp_size)
+        imp_arp_grow(imp);
+
+    /* If no room search for oldest one. */
+    if (2 * (imp->arp_cnt + 1) > imp->arp_size) {
+        int       fnd = -1;
         int16     tmpage = 0;
-        for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
+        for (i = 0; i < imp->arp_size; i++) {
             tabptr = &imp->arp_table[i];
-            if (tabptr->age > tmpage) {
+            if (tabptr->ipaddr != 0 && tabptr->age > tmpage) {
                 tmpage = tabptr->age;
                 fnd = i;
             }
+            if (fnd < 0 && tabptr->ipaddr != 0 && tabptr->age != ARP_DONT_AGE)
+                fnd = i;
         }
-        tabptr = &imp->arp_table[fnd];
+        if (fnd < 0)
+            return;
+        imp_arp_free(imp, &imp->arp_table[fnd]);
     }
 
     /* Now save the entry */
-    memcpy(&tabptr->ethaddr, ethaddr, sizeof(ETH_MAC));
-    tabptr->ipaddr = ipaddr;
-    tabptr->age = age;
+    memset(&ent, 0, sizeof(ent));
+    memcpy(&ent.ethaddr, ethaddr, sizeof(ETH_MAC));
+    ent.ipaddr = ipaddr;
+    ent.age = age;
+    (void)imp_arp_put(imp, &ent);
     eth_mac_fmt(ethaddr, mac_buf);
     sim_debug(DEBUG_ARP, &imp_dev,
               "creating entry for IP %s to %s, initial age=%d\n", 
@@ -1728,21 +1929,24 @@ void imp_arp_age(struct imp_device *imp)
     struct arp_entry  *tabptr;
     int                i;
 
-    for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
+    for (i = 0; i < imp->arp_size; i++) {
         tabptr = &imp->arp_table[i];
         if (tabptr->ipaddr != 0) {      /* active entry? */
             if (tabptr->age != ARP_DONT_AGE)
                 tabptr->age++;          /* Age it */
-            /* expire too old entries */
-            if (tabptr->age > IMP_ARP_MAX_AGE) {
-                char mac_buf[20];
-
-                eth_mac_fmt(&tabptr->ethaddr, mac_buf);
-                sim_debug(DEBUG_ARP, &imp_dev, 
-                          "discarding ARP entry for IP %s %s after %d seconds\n", 
-                          ipv4_inet_ntoa(*((struct in_addr *)&tabptr->ipaddr)), mac_buf, IMP_ARP_MAX_AGE);
-                memset(tabptr, 0, sizeof(*tabptr));
-            }
+        }
+    }
+    /* Expire too old entries, freeing moves entries so recheck slot */
+    for (i = 0; i < imp->arp_size; i++) {
+        tabptr = &imp->arp_table[i];
+        while (tabptr->ipaddr != 0 && tabptr->age > IMP_ARP_MAX_AGE) {
+            char mac_buf[20];
+
+            eth_mac_fmt(&tabptr->ethaddr, mac_buf);
+            sim_debug(DEBUG_ARP, &imp_dev, 
+                      "discarding ARP entry for IP %s %s after %d seconds\n", 
+                      ipv4_inet_ntoa(*((struct in_addr *)&tabptr->ipaddr)), mac_buf, IMP_ARP_MAX_AGE);
+            imp_arp_free(imp, tabptr);
         }
     }
 }
@@ -1860,16 +2064,16 @@ imp_arp_arpout(struct imp_device *imp, in_addr_T ipaddr)
 struct arp_entry *imp_arp_lookup(struct imp_device *imp, in_addr_T ipaddr)
 {
     struct arp_entry  *tabptr;
-    int                i;
-
-    /* Check if entry already in the table. */
-    for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
-        tabptr = &imp->arp_table[i];
-
-        if (tabptr->ipaddr != 0) {
-            if (tabptr->ipaddr == ipaddr)
-                return tabptr;
-        }
+    uint32             i;
+
+    if (imp->arp_cnt == 0 || ipaddr == 0)
+        return NULL;
+    /* Probe from hashed slot until free one */
+    i = IMP_HASH(ipaddr, imp->arp_size);
+    while ((tabptr = &imp->arp_table[i])->ipaddr != 0) {
+        if (tabptr->ipaddr == ipaddr)
+            return tabptr;
+        i = (i + 1) & (imp->arp_size - 1);
     }
     return NULL;
 }
@@ -1902,7 +2106,7 @@ t_stat imp_show_arp (FILE *st, UNIT *uptr, int32 val, CONST void *desc)
 
     fprintf (st, "%-17s%-19s%s\n", "IP Address:", "MAC:", "Age:");
 
-    for (i = 0; i < IMP_ARPTAB_SIZE; i++) {
+    for (i = 0; i < imp_data.arp_size; i++) {
         char buf[32];
 
         tabptr = &imp_data.arp_table[i];
@@ -2632,7 +2836,7 @@ t_stat imp_reset (DEVICE *dptr)
         /* Set a default MAC address in a BBN assigned OID range no longer in use */
         imp_set_mac (dptr->units, 0, "00:00:02:00:00:00/24", NULL);
         /* Clear ARP table. */
-        memset(imp_data.arp_table, 0, sizeof(imp_data.arp_table));
+        imp_arp_clear(&imp_data);
         imp_data.dhcp_state = DHCP_STATE_OFF;
     }
     /* Clear queues. */
@@ -2715,7 +2919,7 @@ t_stat imp_attach(UNIT* uptr, CONST char* cptr)
     imp_data.dhcp_xid = (imp_data.mac[0] | (imp_data.mac[1] << 8) |
                         (imp_data.mac[2] << 16) | (imp_data.mac[3] << 24)) + (uint32)time(NULL);
     imp_data.dhcp_state = DHCP_STATE_OFF;
-    memset(imp_data.arp_table, 0, sizeof(imp_data.arp_table));
+    imp_arp_clear(&imp_data);
 
     /* If we're not doing DHCP and a gateway is defined on the network
        then define a static APR entry for the gateway to facilitate 
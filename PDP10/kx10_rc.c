@@ -38,6 +38,8 @@
 #define UNIT_M_DTYPE    1
 #define UNIT_DTYPE      (UNIT_M_DTYPE << UNIT_V_DTYPE)
 #define GET_DTYPE(x)    (((x) >> UNIT_V_DTYPE) & UNIT_M_DTYPE)
+#define UNIT_V_MAP      (UNIT_V_UF + 1)                 /* file mapped */
+#define UNIT_MAP        (1 << UNIT_V_MAP)
 
 /* Parameters in the unit descriptor */
 
@@ -116,6 +118,7 @@ void            rc_ini(UNIT *, t_bool);
 t_stat          rc_reset(DEVICE *);
 t_stat          rc_attach(UNIT *, CONST char *);
 t_stat          rc_detach(UNIT *);
+void            rc_flush(UNIT *);
 t_stat          rc_set_type(UNIT *uptr, int32 val, CONST char *cptr, void *desc);
 t_stat          rc_help (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag,
                      const char *cptr);
@@ -387,9 +390,15 @@ t_stat rc_svc (UNIT *uptr)
                  /* Read the block */
            int da;
            da = ((cyl * rc_drv_tab[dtype].seg) + seg) * seg_size;
-           err = sim_fseek(uptr->fileref, da * sizeof(uint64), SEEK_SET);
-           wc = sim_fread (&rc_buf[ctlr][0], sizeof(uint64),
-                        seg_size, uptr->fileref);
+           if (uptr->flags & UNIT_MAP) {
+               memcpy(&rc_buf[ctlr][0], &((uint64 *)uptr->filebuf)[da],
+                        seg_size * sizeof(uint64));
+               wc = seg_size;
+           } else {
+               err = sim_fseek(uptr->fileref, da * sizeof(uint64), SEEK_SET);
+               wc = sim_fread (&rc_buf[ctlr][0], sizeof(uint64),
+                            seg_size, uptr->fileref);
+           }
            sim_debug(DEBUG_DETAIL, dptr, "HK %d Read %d %d %d %x\n",
                 ctlr, da, cyl, seg, uptr->UFLAGS << 1 );
            for (; wc < seg_size; wc++)
@@ -425,9 +434,14 @@ t_stat rc_svc (UNIT *uptr)
              da = ((cyl * rc_drv_tab[dtype].seg) + seg) * seg_size;
              sim_debug(DEBUG_DETAIL, dptr, "HK %d Write %d %d %d %x %d\n",
                   ctlr, da, cyl, seg, uptr->UFLAGS << 1, uptr->DATAPTR );
-             err = sim_fseek(uptr->fileref, da * sizeof(uint64), SEEK_SET);
-             wc = sim_fwrite(&rc_buf[ctlr][0],sizeof(uint64),
-                        seg_size, uptr->fileref);
+             if (uptr->flags & UNIT_MAP) {
+                 memcpy(&((uint64 *)uptr->filebuf)[da], &rc_buf[ctlr][0],
+                        seg_size * sizeof(uint64));
+             } else {
+                 err = sim_fseek(uptr->fileref, da * sizeof(uint64), SEEK_SET);
+                 wc = sim_fwrite(&rc_buf[ctlr][0],sizeof(uint64),
+                            seg_size, uptr->fileref);
+             }
         }
         uptr->DATAPTR = -1;
         seg++;
@@ -532,7 +546,28 @@ t_stat r;
 
 uptr->capac = rc_drv_tab[GET_DTYPE (uptr->flags)].size;
 r = attach_unit (uptr, cptr);
-if (r != SCPE_OK || (sim_switches & SIM_SW_REST) != 0)
+if (r != SCPE_OK)
+    return r;
+if ((sim_switches & SIM_SW_REST) == 0) {
+    uptr->flags &= ~UNIT_MAP;
+    if (sim_switches & SWMASK ('M'))                    /* map file? */
+        uptr->flags |= UNIT_MAP;
+    }
+if (uptr->flags & UNIT_MAP) {
+    FMAP *fmap;
+
+    if (sim_end &&
+        sim_fmap_open (uptr->fileref, uptr->capac * sizeof (uint64),
+            (uptr->flags & UNIT_RO) != 0, &fmap, &uptr->filebuf) == SCPE_OK) {
+        uptr->up8 = fmap;
+        uptr->io_flush = &rc_flush;
+        }
+    else {
+        uptr->flags &= ~UNIT_MAP;
+        sim_printf ("%s: can't map file, using file I/O\n", sim_uname (uptr));
+        }
+    }
+if ((sim_switches & SIM_SW_REST) != 0)
     return r;
 uptr->CUR_CYL = 0;
 uptr->UFLAGS = 0;
@@ -547,9 +582,24 @@ if (!(uptr->flags & UNIT_ATT))                          /* attached? */
     return SCPE_OK;
 if (sim_is_active (uptr))                              /* unit active? */
     sim_cancel (uptr);                                  /* cancel operation */
+if (uptr->flags & UNIT_MAP) {                           /* mapped? */
+    sim_fmap_close ((FMAP *) uptr->up8);                /* write and unmap */
+    uptr->up8 = NULL;
+    uptr->filebuf = NULL;
+    uptr->io_flush = NULL;
+    uptr->flags &= ~UNIT_MAP;
+    }
 return detach_unit (uptr);
 }
 
+/* Write a mapped file back to disk */
+
+void rc_flush (UNIT *uptr)
+{
+if (uptr->flags & UNIT_MAP)
+    sim_fmap_sync ((FMAP *) uptr->up8);
+}
+
 t_stat rc_help (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, const char *cptr)
 {
 fprintf (st, "RD10/RM10  Disk Pack Drives (RC)\n\n");
@@ -561,6 +611,8 @@ fprint_set_help (st, dptr);
 fprint_show_help (st, dptr);
 fprintf (st, "\nThe type options can be used only when a unit is not attached to a file.\n");
 fprintf (st, "The RC device supports the BOOT command.\n");
+fprintf (st, "\nATTACH -M maps the disk image into memory in place of reading and\n");
+fprintf (st, "writing the file a segment at a time.\n");
 fprint_reg_help (st, dptr);
 return SCPE_OK;
 }
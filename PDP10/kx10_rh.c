@@ -1160,3 +1160,107 @@ int rh_write(struct rh_if *rhc) {
      return 1;
 }
 
+#if !KS
+/*
+ * Number of words rh_read/rh_write can move without anything but a
+ * memory access: inside the current control word, not the last word of
+ * it, not skipping, forward, and in memory.  Returns the first address.
+ */
+static int rh_run(struct rh_if *rhc, int n, t_addr *addr)
+{
+     t_addr      first = rhc->cda;
+     uint32      left;
+
+     if (rhc->wcr == 0 || rhc->cda == 0)
+         return 0;
+#if KL
+     if (rhc->imode == 2) {
+         if (rhc->cop & 01)
+             return 0;
+     } else
+#endif
+     first++;                   /* DF10 steps the address before use */
+     left = (uint32)((0 - rhc->wcr) & WMASK) - 1;
+     if ((uint32)n > left)
+         n = left;
+     if (n <= 0 || (first + n) > MEMSIZE || (first + n) > AMASK)
+         return 0;
+     *addr = first;
+     return n;
+}
+
+/* Account for n words moved by the direct path */
+static void rh_step(struct rh_if *rhc, int n)
+{
+     rhc->cda = (uint32)((rhc->cda + n) & AMASK);
+     rhc->wcr = (uint32)((rhc->wcr + n) & WMASK);
+}
+#endif
+
+/*
+ * Read up to n words into buf, as n calls of rh_read would.  The word
+ * from the call that ends the transfer is stored too.  Returns the last
+ * result of rh_read and the number of words stored in *cnt.
+ */
+int rh_read_block(struct rh_if *rhc, uint64 *buf, int n, int *cnt)
+{
+     int         i = 0;
+     int         sts = 1;
+
+     while (i < n) {
+#if !KS
+        t_addr   addr;
+        int      run = rh_run(rhc, n - i, &addr);
+
+        if (run > 0) {
+            memcpy(&buf[i], &M[addr], run * sizeof(uint64));
+            rh_step(rhc, run);
+            i += run;
+            rhc->buf = buf[i - 1];
+            continue;
+        }
+#endif
+        sts = rh_read(rhc);
+        buf[i++] = rhc->buf;
+        if (sts == 0)
+            break;
+     }
+     *cnt = i;
+     return sts;
+}
+
+/*
+ * Write up to n words from buf, as n calls of rh_write would.  Returns
+ * the last result of rh_write and the number of words taken in *cnt.
+ */
+int rh_write_block(struct rh_if *rhc, uint64 *buf, int n, int *cnt)
+{
+     int         i = 0;
+     int         sts = 1;
+
+     while (i < n) {
+#if !KS
+        t_addr   addr;
+        t_addr   a;
+        int      run = rh_run(rhc, n - i, &addr);
+
+        if (run > 0) {
+            memcpy(&M[addr], &buf[i], run * sizeof(uint64));
+            for (a = addr; a < addr + run; a += SIM_DIRTY_PAGE)
+                MEM_DIRTY(a);
+            MEM_DIRTY(addr + run - 1);
+            rh_step(rhc, run);
+            i += run;
+            rhc->buf = buf[i - 1];
+            continue;
+        }
+#endif
+        rhc->buf = buf[i++];
+        sts = rh_write(rhc);
+        if (sts == 0)
+            break;
+     }
+     *cnt = i;
+     return sts;
+}
+
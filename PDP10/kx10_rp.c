@@ -357,6 +357,8 @@ MTAB                rp_mod[] = {
     {UNIT_DTYPE, (RP06_DTYPE << UNIT_V_DTYPE), "RP06", "RP06", &rp_set_type },
     {UNIT_DTYPE, (RP04_DTYPE << UNIT_V_DTYPE), "RP04", "RP04", &rp_set_type },
     {MTAB_XTD|MTAB_VUN, 0, "FORMAT", "FORMAT", NULL, &disk_show_fmt },
+    {MTAB_XTD|MTAB_VUN|MTAB_VALR, 0, "CACHE", "CACHE", &disk_set_cache,
+              &disk_show_cache, NULL, "Sets size of cylinder cache in words" },
 #if KS
     {MTAB_XTD|MTAB_VDV|MTAB_VALR, 0, "addr", "addr",  &uba_set_addr, uba_show_addr,
               NULL, "Sets address of RH11" },
@@ -803,6 +805,7 @@ t_stat rp_svc (UNIT *uptr)
     struct rh_if *rhc;
     int           diff, da;
     int           sts;
+    int           n;
 
     dptr = rp_devs[ctlr];
     rhc = &rp_rh[ctlr];
@@ -936,29 +939,32 @@ t_stat rp_svc (UNIT *uptr)
                 if (rh_write(rhc) == 0)
                     goto rd_end;
             }
+            /* Hand the sector over once it has passed under the heads */
+            sim_activate(uptr, 10 * (RP_NUMWD - 1));
+            return SCPE_OK;
         }
 
-        rhc->buf = rp_buf[ctlr][uptr->DATAPTR++];
-        sim_debug(DEBUG_DATA, dptr, "%s%o read word %d %012llo %09o %06o\n",
-                   dptr->name, unit, uptr->DATAPTR, rhc->buf, rhc->cda, rhc->wcr);
-        if (rh_write(rhc)) {
-            if (uptr->DATAPTR == RP_NUMWD) {
-                /* Increment to next sector. Set Last Sector */
-                uptr->DATAPTR = 0;
-                CLR_BUF(uptr);
-                regs[RPDA] += 1 << DA_V_SC;
-                if (GET_SC(regs[RPDA]) >= rp_drv_tab[dtype].sect) {
-                    regs[RPDA] &= (DA_M_SF << DA_V_SF);
-                    regs[RPDA] += 1 << DA_V_SF;
-                    if (GET_SF(regs[RPDA]) >= rp_drv_tab[dtype].surf) {
-                         regs[RPDA] = 0;
-                         regs[RPDC] += 1 << DC_V_CY;
-                         regs[RPDS] |= DS_PIP;
-                    }
+        sts = rh_write_block(rhc, &rp_buf[ctlr][uptr->DATAPTR],
+                             RP_NUMWD - uptr->DATAPTR, &n);
+        uptr->DATAPTR += n;
+        sim_debug(DEBUG_DATA, dptr, "%s%o read %d words %012llo %09o %06o\n",
+                   dptr->name, unit, n, rhc->buf, rhc->cda, rhc->wcr);
+        if (sts) {
+            /* Increment to next sector. Set Last Sector */
+            uptr->DATAPTR = 0;
+            CLR_BUF(uptr);
+            regs[RPDA] += 1 << DA_V_SC;
+            if (GET_SC(regs[RPDA]) >= rp_drv_tab[dtype].sect) {
+                regs[RPDA] &= (DA_M_SF << DA_V_SF);
+                regs[RPDA] += 1 << DA_V_SF;
+                if (GET_SF(regs[RPDA]) >= rp_drv_tab[dtype].surf) {
+                     regs[RPDA] = 0;
+                     regs[RPDC] += 1 << DC_V_CY;
+                     regs[RPDS] |= DS_PIP;
                 }
-                if (rh_blkend(rhc))
-                    goto rd_end;
             }
+            if (rh_blkend(rhc))
+                goto rd_end;
             sim_activate(uptr, 10);
         } else {
 rd_end:
@@ -1001,11 +1007,15 @@ rd_end:
             }
             uptr->DATAPTR = 0;
             uptr->hwmark = 0;
+            /* Take the sector from memory as it ends under the heads */
+            sim_activate(uptr, 10 * (RP_NUMWD - 1));
+            return SCPE_OK;
         }
-        sts = rh_read(rhc);
-        sim_debug(DEBUG_DATA, dptr, "%s%o write word %d %012llo %06o %06o\n",
-                      dptr->name, unit, uptr->DATAPTR, rhc->buf, rhc->cda, rhc->wcr);
-        rp_buf[ctlr][uptr->DATAPTR++] = rhc->buf;
+        sts = rh_read_block(rhc, &rp_buf[ctlr][uptr->DATAPTR],
+                            RP_NUMWD - uptr->DATAPTR, &n);
+        uptr->DATAPTR += n;
+        sim_debug(DEBUG_DATA, dptr, "%s%o write %d words %012llo %06o %06o\n",
+                      dptr->name, unit, n, rhc->buf, rhc->cda, rhc->wcr);
         if (sts == 0) {
             while (uptr->DATAPTR < RP_NUMWD)
                 rp_buf[ctlr][uptr->DATAPTR++] = 0;
@@ -1220,6 +1230,8 @@ t_stat rp_attach (UNIT *uptr, CONST char *cptr)
     r = disk_attach (uptr, cptr);
     if (r != SCPE_OK)
         return r;
+    disk_set_cylinder(uptr, rp_drv_tab[GET_DTYPE (uptr->flags)].sect *
+                            rp_drv_tab[GET_DTYPE (uptr->flags)].surf);
     rptr = find_dev_from_unit(uptr);
     if (rptr == 0)
         return SCPE_OK;
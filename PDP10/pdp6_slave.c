@@ -60,6 +60,9 @@ static t_stat slave_detach (UNIT *uptr);
 static t_stat slave_attach_help (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, const char *cptr);
 static const char *slave_description (DEVICE *dptr);
 static uint8  slave_valid[040000];
+static SHMEM  *slave_shmem = NULL;             /* Segment when attached -M */
+static uint64 *slave_shm = NULL;
+static int32  slave_irq;                       /* IRQ requests seen so far */
 
 UNIT slave_unit[1] = {
   { UDATA (&slave_svc, UNIT_IDLE|UNIT_ATTABLE, 0), 1000 },
@@ -86,6 +89,8 @@ static DEBTAB slave_debug[] = {
   {0},
 };
 
+DIB slave_dib = { SLAVE_DEVNUM, 1, &slave_devio, NULL };
+
 DEVICE slave_dev = {
   "SLAVE", slave_unit, slave_reg, slave_mod,
   1, 8, 16, 2, 8, 16,
@@ -95,7 +100,7 @@ DEVICE slave_dev = {
   NULL,                                               /* boot */
   slave_attach,                                       /* attach */
   slave_detach,                                       /* detach */
-  NULL,                                               /* context */
+  &slave_dib,                                          /* context */
   DEV_DISABLE | DEV_DIS | DEV_DEBUG | DEV_MUX,
   DEBUG_CMD,                                          /* debug control */
   slave_debug,                                        /* debug flags */
@@ -135,6 +140,21 @@ static t_stat slave_attach (UNIT *uptr, CONST char *cptr)
     return SCPE_ARG;
   if (!(uptr->flags & UNIT_ATTABLE))
     return SCPE_NOATT;
+  if (sim_switches & SWMASK ('M')) {
+    /* Run out of shared memory, the PDP-10 reads and writes it directly */
+    r = sim_shmem_open (cptr, SHM_WORDS * sizeof (uint64), &slave_shmem,
+                        (void **)&slave_shm);
+    if (r != SCPE_OK)
+      return r;
+    uptr->filename = (char *)calloc (1, strlen (cptr) + 1);
+    strcpy (uptr->filename, cptr);
+    uptr->flags |= UNIT_ATT;
+    slave_irq = sim_shmem_atomic_add ((int32 *)&slave_shm[SHM_IRQ], 0);
+    cpu_set_memory (&slave_shm[SHM_MEM]);
+    sim_debug(DEBUG_TRC, &slave_dev, "shared memory %s\n", cptr);
+    sim_activate (uptr, 10);
+    return SCPE_OK;
+  }
   r = tmxr_attach_ex (&slave_desc, uptr, cptr, FALSE);
   if (r != SCPE_OK)                                       /* error? */
     return r;
@@ -150,6 +170,16 @@ static t_stat slave_detach (UNIT *uptr)
   if (!(uptr->flags & UNIT_ATT))
     return SCPE_OK;
   sim_cancel (uptr);
+  if (slave_shmem != NULL) {
+    cpu_set_memory (NULL);
+    sim_shmem_close (slave_shmem);
+    slave_shmem = NULL;
+    slave_shm = NULL;
+    free (uptr->filename);
+    uptr->filename = NULL;
+    uptr->flags &= ~UNIT_ATT;
+    return SCPE_OK;
+  }
   r = tmxr_detach (&slave_desc, uptr);
   uptr->filename = NULL;
   return r;
@@ -213,6 +243,7 @@ static t_stat process_request (UNIT *uptr, const uint8 *request, size_t size)
       data |= ((uint64)request[7]) << 24;
       data |= ((uint64)request[8]) << 32;
       M[address] = data;
+      MEM_DIRTY(address);
       build (response, ACK);
       sim_debug(DEBUG_DATAIO, &slave_dev, "DATO %06o <- %012llo\n",
                 address, data);
@@ -244,6 +275,19 @@ static t_stat slave_svc (UNIT *uptr)
   const uint8 *slave_request;
   size_t size;
 
+  if (slave_shm != NULL) {
+    int32 irq = sim_shmem_atomic_add ((int32 *)&slave_shm[SHM_IRQ], 0);
+
+    if (irq != slave_irq) {
+      slave_irq = irq;
+      uptr->STATUS |= 010;
+      set_interrupt(SLAVE_DEVNUM, uptr->PIA);
+      sim_debug(DEBUG_DATAIO, &slave_dev, "IRQ\n");
+    }
+    sim_clock_coschedule (uptr, uptr->wait);
+    return SCPE_OK;
+  }
+
   if (tmxr_poll_conn(&slave_desc) >= 0) {
     sim_debug(DEBUG_CMD, &slave_dev, "got connection\n");
     slave_ldsc.rcve = 1;
@@ -277,6 +321,12 @@ const char helpString[] =
     "\n"
     "+sim> ATTACH %U port\n"
     "\n"
+    " When both simulators run on the same host the -M switch shares the\n"
+    " PDP-6 memory with the PDP-10 instead, the name given must match the one\n"
+    " the AUXCPU device on the PDP-10 is attached to.\n"
+    "\n"
+    "+sim> ATTACH -M %U name\n"
+    "\n"
     ;
 
  return scp_help (st, dptr, uptr, flag, helpString, cptr);
@@ -103,6 +103,7 @@ uint32          PSD[2];                     /* the PC for the instruction */
 #define PSD1 PSD[0]                         /* word 1 of PSD */
 #define PSD2 PSD[1]                         /* word 2 of PSD */
 uint32          M[MAXMEMSIZE] = { 0 };      /* Memory */
+uint8           mem_dirty[SIM_DIRTY_BYTES(MAXMEMSIZE<<2)];  /* pages changed since SAVE */
 uint32          GPR[8];                     /* General Purpose Registers */
 uint32          BR[8];                      /* Base registers */
 uint32          PC;                         /* Program counter */
@@ -336,6 +337,9 @@ MTAB cpu_mod[] = {
     {UNIT_MSIZE, MEMAMOUNT(10),  NULL,  "16M", &cpu_set_size},
     { MTAB_XTD|MTAB_VDV, 0, "IDLE", "IDLE", &sim_set_idle, &sim_show_idle },
     { MTAB_XTD|MTAB_VDV, 0, NULL, "NOIDLE", &sim_clr_idle, NULL },
+    { MTAB_XTD|MTAB_VDV|MTAB_VALR|MTAB_NMO, 0, "PROFILE", "PROFILE",
+      &sim_set_profile, &sim_show_profile },
+    { MTAB_XTD|MTAB_VDV, 0, NULL, "NOPROFILE", &sim_clr_profile, NULL },
     {MTAB_XTD | MTAB_VDV | MTAB_NMO | MTAB_SHP, 0, "HISTORY", "HISTORY",
      &cpu_set_hist, &cpu_show_hist},
     {0}
@@ -377,6 +381,11 @@ DEVICE cpu_dev = {
     NULL,                /* BRKTYPTB *brk_types */  /* Breakpoint types */
 };
 
+/* memory as seen by SAVE/RESTORE, 4 byte addresses per word */
+static MEMREGION cpu_mem_region = {
+    &cpu_dev, &cpu_unit, M, sizeof(uint32), 4, 0, 0, mem_dirty
+};
+
 /* CPU Instruction decode flags */
 #define INV     0x0000      /* Instruction is invalid */
 #define HLF     0x0001      /* Half word instruction */
@@ -2040,7 +2049,9 @@ wait_loop:
                 /* take interrupt, store the PSD, fetch new PSD */
                 bc = PSD2 & 0x3ff8;                 /* get copy of cpix */
                 M[int_icb>>2] = PSD1&0xfffffffe;    /* store PSD 1 */
+                MEM_DIRTY(int_icb>>2);
                 M[(int_icb>>2)+1] = PSD2;           /* store PSD 2 */
+                MEM_DIRTY((int_icb>>2)+1);
                 sim_debug(DEBUG_IRQ, &cpu_dev,
                     "<|>Normal int cpix %04x OPSD1 %08x OPSD2 %08x\n",
                     bc, PSD1, PSD2);
@@ -2224,6 +2235,7 @@ skipi:
             reason = STOP_IBKPT;
             break;
         }
+        SIM_PROFILE(PC, (PSD1 & PRIVBIT) == 0);
 
         /* fill IR from logical memory address */
         if ((TRAPME = read_instruction(PSD, &IR))) {
@@ -3481,7 +3493,9 @@ tbr:                                                /* handle basemode TBR too *
                     cfp = BR[2] & 0x00fffff8;       /* clean the cfp address to 24 bit dw */
 
                     M[cfp>>2] = (PSD1 + 2) & 0x01fffffe; /* save AEXP bit and PC into frame */
+                    MEM_DIRTY(cfp>>2);
                     M[(cfp>>2)+1] = 0x80000000;     /* show frame created by BSUB instr */
+                    MEM_DIRTY((cfp>>2)+1);
                     BR[1] = BR[sreg] & MASK24;      /* Rs reg to BR 1 */
                     PSD1 = (PSD1 & 0xff000000) | (BR[1] & MASK24); /* New PSD address */
                     BR[3] = GPR[0];                 /* GPR 0 to BR 3 (AP) */
@@ -3853,10 +3867,13 @@ skipit:
                 /* this will skip over rt hw instruction if any */
                 PSD1 = (PSD1 + 4) | (((PSD1 & 2) >> 1) & 1);    /* bump pc by 1 wd */
                 M[t>>2] = PSD1 & 0xfffffffe;        /* store PSD 1 + 1HW to point to next instruction */
+                MEM_DIRTY(t>>2);
                 M[(t>>2)+1] = PSD2;                 /* store PSD 2 */
+                MEM_DIRTY((t>>2)+1);
                 PSD1 = M[(t>>2)+2];                 /* get new PSD 1 */
                 PSD2 = (M[(t>>2)+3] & ~0x3fff) | bc;    /* get new PSD 2 w/old cpix */
                 M[(t>>2)+4] = opr & 0x03FF;         /* store calm number in bits 6-15 */
+                MEM_DIRTY((t>>2)+4);
 
                 /* set the mode bits and CCs from the new PSD */
                 CC = PSD1 & 0x78000000;             /* extract bits 1-4 from PSD1 */
@@ -5484,10 +5501,13 @@ doovr2:
                 }
                 bc = PSD2 & 0x3ff8;                 /* get copy of cpix */
                 M[t>>2] = (PSD1+4) & 0xfffffffe;    /* store PSD 1 + 1W to point to next instruction */
+                MEM_DIRTY(t>>2);
                 M[(t>>2)+1] = PSD2;                 /* store PSD 2 */
+                MEM_DIRTY((t>>2)+1);
                 PSD1 = M[(t>>2)+2];                 /* get new PSD 1 */
                 PSD2 = (M[(t>>2)+3] & ~0x3fff) | bc;    /* get new PSD 2 w/old cpix */
                 M[(t>>2)+4] = IR&0xFFF;             /* store call number */
+                MEM_DIRTY((t>>2)+4);
 #ifdef MPXTEST  /* set to 1 for traceme to work */
                 sim_debug(DEBUG_IRQ, &cpu_dev,
                     "SVC %x,%x @ %.8x PSD %.8x %.8x SPAD PSD2 %x C.CURR %x LMN %8s\n",
@@ -7106,9 +7126,13 @@ newpsd:
                     PSD1 = 0x80000000 + TRAPME;     /* just priv and PC to trap vector */
                     PSD2 = 0x00004000;              /* unmapped, blocked interrupts mode */
                     M[0x680>>2] = PSD1;             /* store PSD 1 */
+                    MEM_DIRTY(0x680>>2);
                     M[0x684>>2] = PSD2;             /* store PSD 2 */
+                    MEM_DIRTY(0x684>>2);
                     M[0x688>>2] = TRAPSTATUS;       /* store trap status */
+                    MEM_DIRTY(0x688>>2);
                     M[0x68C>>2] = 0;                /* This will be device table entry later TODO */
+                    MEM_DIRTY(0x68C>>2);
                     for (ix=0; ix<8; ix+=2) {
                         fprintf(stderr, "GPR[%d] %08x GPR[%d] %08x\r\n", ix, GPR[ix], ix+1, GPR[ix+1]);
                     }
@@ -7129,11 +7153,15 @@ newpsd:
                     } else
                         M[tvl>>2] = PSD1 & 0xffffffff;  /* store PSD 1 */
                     M[(tvl>>2)+1] = PSD2;           /* store PSD 2 */
+                    MEM_DIRTY(tvl>>2);
+                    MEM_DIRTY((tvl>>2)+1);
                     PSD1 = M[(tvl>>2)+2];           /* get new PSD 1 */
                     PSD2 = (M[(tvl>>2)+3] & ~0x3fff) | bc;  /* get new PSD 2 w/old cpix */
                     M[(tvl>>2)+4] = TRAPSTATUS;     /* store trap status */
+                    MEM_DIRTY((tvl>>2)+4);
                     if (TRAPME == DEMANDPG_TRAP) {  /* 0xC4 Demand Page Fault Trap (V6&V9 Only) */
                         M[(tvl>>2)+5] = pfault;     /* store page fault number */
+                        MEM_DIRTY((tvl>>2)+5);
                         sim_debug(DEBUG_TRAP, &cpu_dev,
                             "DPAGE tvl %06x PSD1 %08x PSD2 %08x TRAPME %04x TRAPSTATUS %08x\n",
                             tvl, PSD1, PSD2, TRAPME, pfault);
@@ -7276,6 +7304,7 @@ t_stat cpu_reset(DEVICE *dptr)
 
     /* set default breaks to execution tracing */
     sim_brk_types = sim_brk_dflt = SWMASK('E');
+    sim_register_mem_region(&cpu_mem_region);       /* let SAVE/RESTORE use M directly */
     /* zero regs */
     for (i = 0; i < 8; i++) {
         GPR[i] = BOOTR[i];                          /* set boot register values */
@@ -489,11 +489,13 @@ extern DEBTAB dev_debug[];
 #define RMB(a) ((M[(a)>>2]>>(8*(3-(a&3))))&0xff)    /* read memory addressed byte */
 #define RMH(a) ((a)&2?(M[(a)>>2]&RMASK):(M[(a)>>2]>>16)&RMASK)    /* read memory addressed halfword */
 #define RMW(a) (M[((a)&MASK24)>>2])     /* read memory addressed word */
-#define WMW(a,d) (M[((a)&MASK24)>>2]=d) /* write memory addressed word */
+#define WMW(a,d) (MEM_DIRTY(((a)&MASK24)>>2),M[((a)&MASK24)>>2]=d) /* write memory addressed word */
 /* write halfword to memory address */
-#define WMH(a,d) ((a)&2?(M[(a)>>2]=(M[(a)>>2]&LMASK)|((d)&RMASK)):(M[(a)>>2]=(M[(a)>>2]&RMASK)|((d)<<16)))
+#define WMH(a,d) (MEM_DIRTY((a)>>2),(a)&2?(M[(a)>>2]=(M[(a)>>2]&LMASK)|((d)&RMASK)):(M[(a)>>2]=(M[(a)>>2]&RMASK)|((d)<<16)))
 /* write byte to memory */
-#define WMB(a,d) (M[(a)>>2]=(((M[(a)>>2])&(~(0xff<<(8*(3-(a&3))))))|((d&0xff)<<(8*(3-(a&3))))))
+#define WMB(a,d) (MEM_DIRTY((a)>>2),M[(a)>>2]=(((M[(a)>>2])&(~(0xff<<(8*(3-(a&3))))))|((d&0xff)<<(8*(3-(a&3))))))
+/* mark memory word w changed since the last SAVE, pages are in byte addresses */
+#define MEM_DIRTY(w) SIM_SET_DIRTY(mem_dirty, (w)<<2)
 
 /* map register access macros */
 /* The RMR and WMR macros are used to read/write the MAPC cache registers */
@@ -518,6 +520,7 @@ extern  t_stat  set_inch(UNIT *uptr, uint32 inch_addr); /* set channel inch addr
 extern  CHANP  *find_chanp_ptr(uint16 chsa);    /* find chanp pointer */
 
 extern  uint32  M[];                    /* our memory */
+extern  uint8   mem_dirty[];            /* memory pages changed since SAVE */
 extern  uint32  SPAD[];                 /* cpu SPAD memory */
 extern  uint32  attention_trap;
 extern  uint32  RDYQ[];                 /* ready queue */
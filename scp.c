@@ -237,10 +237,19 @@
 #include <fcntl.h>
 #endif
 #include <setjmp.h>
+#if !defined(_WIN32) && !defined(VMS)                   /* SAVE -B background save */
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#define SIM_BG_SAVE
+#endif
 
 #if defined(HAVE_DLOPEN)                                /* Dynamic Readline support */
 #include <dlfcn.h>
 #endif
+#if defined(HAVE_ZLIB)                                  /* SAVE -Z compression */
+#include <zlib.h>
+#endif
 
 #ifndef MAX
 #define MAX(a,b)  (((a) >= (b)) ? (a) : (b))
@@ -264,9 +273,16 @@
 #define SCH_LE          7
 
 #define MAX_DO_NEST_LVL 20                              /* DO cmd nesting level limit */
-#define SRBSIZ          1024                            /* save/restore buffer */
+#define SRBSIZ          (1 << SIM_DIRTY_SHIFT)          /* save/restore buffer */
 #define SIM_BRK_INILNT  4096                            /* bpt tbl length */
 #define SIM_BRK_ALLTYP  0xFFFFFFFB
+#define SIM_BRK_HBITS   12                              /* bpt address filter */
+#define SIM_BRK_HSIZE   (1 << SIM_BRK_HBITS)
+#define SIM_BRK_HASH(a) ((uint32)((a) ^ ((a) >> SIM_BRK_HBITS)) & (SIM_BRK_HSIZE - 1))
+#define SIM_QUEUE_BITS  8                               /* event queue timing wheel */
+#define SIM_QUEUE_SLOTS (1 << SIM_QUEUE_BITS)           /* slots per wheel level */
+#define SIM_QUEUE_LVLS  4                               /* wheel levels */
+#define SIM_QUEUE_HEAD_TIME ((int32)(sim_clock_queue->due - sim_queue_ref))
 #define UPDATE_SIM_TIME                                         \
     if (1) {                                                    \
         int32 _x;                                               \
@@ -274,13 +290,12 @@
         if (sim_clock_queue == QUEUE_LIST_END)                  \
             _x = noqueue_time;                                  \
         else                                                    \
-            _x = sim_clock_queue->time;                         \
+            _x = SIM_QUEUE_HEAD_TIME;                           \
         sim_time = sim_time + (_x - sim_interval);              \
         sim_rtime = sim_rtime + ((uint32) (_x - sim_interval)); \
+        sim_queue_ref = sim_queue_ref + (_x - sim_interval);    \
         if (sim_clock_queue == QUEUE_LIST_END)                  \
             noqueue_time = sim_interval;                        \
-        else                                                    \
-            sim_clock_queue->time = sim_interval;               \
         AIO_UNLOCK;                                             \
         }                                                       \
     else                                                        \
@@ -367,6 +382,8 @@ t_bool sim_asynch_enabled = TRUE;
 int32 sim_asynch_check;
 int32 sim_asynch_latency = 4000;      /* 4 usec interrupt latency */
 int32 sim_asynch_inst_latency = 20;   /* assume 5 mip simulator */
+static void _sim_jrn_aio_record (UNIT *uptr, int32 event_time);
+static void _sim_jrn_aio_hold (UNIT *uptr);
 
 int sim_aio_update_queue (void)
 {
@@ -385,6 +402,10 @@ if (AIO_QUEUE_VAL != QUEUE_LIST_END) {  /* List !Empty */
         uptr = q;
         q = q->a_next;
         uptr->a_next = NULL;        /* hygiene */
+        if (sim_jrn_mode == SIM_JRN_REPLAY) {   /* journal decides when */
+            _sim_jrn_aio_hold (uptr);
+            continue;
+            }
         if (uptr->a_activate_call != &sim_activate_notbefore) {
             a_event_time = uptr->a_event_time-((sim_asynch_inst_latency+1)/2);
             if (a_event_time < 0)
@@ -392,6 +413,8 @@ if (AIO_QUEUE_VAL != QUEUE_LIST_END) {  /* List !Empty */
             }
         else
             a_event_time = uptr->a_event_time;
+        if (sim_jrn_mode == SIM_JRN_RECORD)
+            _sim_jrn_aio_record (uptr, a_event_time);
         AIO_IUNLOCK;
         uptr->a_activate_call (uptr, a_event_time);
         if (uptr->a_check_completion) {
@@ -486,6 +509,8 @@ t_stat show_break (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *c
 t_stat show_on (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat show_do (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat show_runlimit (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
+t_stat show_save (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
+t_stat show_profile (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat sim_show_send (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat sim_show_expect (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 t_stat show_device (FILE *st, DEVICE *dptr, int32 flag);
@@ -567,10 +592,32 @@ void int_handler (int signal);
 t_stat set_prompt (int32 flag, CONST char *cptr);
 t_stat set_runlimit (int32 flag, CONST char *cptr);
 t_stat sim_set_asynch (int32 flag, CONST char *cptr);
+t_stat sim_set_journal (int32 flag, CONST char *cptr);
+t_stat sim_show_journal (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr);
 static const char *_get_dbg_verb (uint32 dbits, DEVICE* dptr, UNIT *uptr);
 static t_stat sim_sanity_check_register_declarations (void);
 static void fix_writelock_mtab (DEVICE *dptr);
 static t_stat _sim_debug_flush (void);
+static void _sim_debug_trace_dump (void);
+static void _sim_debug_trace_sync (void);
+static int32 _sim_queue_list (UNIT ***list);
+static MEMREGION *_sim_find_mem_region (DEVICE *dptr, UNIT *uptr, size_t sz);
+static t_bool _sim_mem_region_get (MEMREGION *mr, t_addr k, int32 cnt, void *mbuf, size_t sz);
+static void _sim_mem_region_put (MEMREGION *mr, t_addr k, int32 cnt, void *mbuf, size_t sz);
+static void _sim_mem_regions_dirty (t_bool dirty);
+static char *sim_snap_base = NULL;                      /* last snapshot saved or restored */
+static const char *sim_save_base = NULL;                /* base of the SAVE -I in progress */
+static void _sim_save_flush_unit (DEVICE *dptr, UNIT *uptr);
+static void _sim_bg_save_check (t_bool wait);
+#if defined(SIM_BG_SAVE)
+static t_stat _sim_bg_save (FILE *sfile, const char *filename);
+static pid_t sim_bg_save_pid = 0;                       /* SAVE -B child */
+#endif
+static char *sim_bg_save_file = NULL;                   /* SAVE -B file */
+static time_t sim_bg_save_start;                        /* SAVE -B start time */
+static int32 sim_bg_save_secs = 0;                      /* SAVE -B elapsed time */
+static t_stat sim_bg_save_stat = SCPE_OK;               /* SAVE -B completion status */
+static t_uint64 sim_event_count = 0;                    /* events processed */
 
 /* Global data */
 
@@ -606,6 +653,7 @@ BRKTAB **sim_brk_tab = NULL;
 int32 sim_brk_ent = 0;
 int32 sim_brk_lnt = 0;
 int32 sim_brk_ins = 0;
+static uint32 sim_brk_hash[SIM_BRK_HSIZE];              /* types set per address hash */
 int32 sim_quiet = 0;
 int32 sim_show_message = 1;                         /* the message display status of the currently open do file */
 int32 sim_step = 0;
@@ -622,6 +670,17 @@ size_t *sim_sub_instr_off = NULL;   /* offsets in substitution buffer where orig
 static double sim_time;
 static uint32 sim_rtime;
 static int32 noqueue_time;
+typedef struct {
+    UNIT *head;                                         /* first entry */
+    UNIT *tail;                                         /* last entry */
+    } QSLOT;
+static QSLOT sim_queue_wheel[SIM_QUEUE_LVLS][SIM_QUEUE_SLOTS];
+static t_uint64 sim_queue_map[SIM_QUEUE_LVLS][SIM_QUEUE_SLOTS / 64];
+static QSLOT sim_queue_early;                           /* due before wheel base */
+static QSLOT sim_queue_far;                             /* due beyond wheel span */
+static t_int64 sim_queue_base;                          /* wheel base time */
+static t_int64 sim_queue_ref;                           /* queue head reference time */
+static int32 sim_queue_count;                           /* entries on the queue */
 volatile t_bool stop_cpu = FALSE;
 volatile t_bool sigterm_received = FALSE;
 static unsigned int sim_stop_sleep_ms = 250;
@@ -720,6 +779,22 @@ DEVICE sim_expect_dev = {
     NULL, NULL, NULL, NULL, NULL, NULL,
     sim_int_expect_description};
 
+static const char *sim_int_jrn_description (DEVICE *dptr)
+{
+return "Event journal facility";
+}
+
+static t_stat sim_jrn_svc (UNIT *uptr);
+static t_stat sim_int_jrn_reset (DEVICE *dptr);
+static UNIT sim_jrn_unit = { UDATA (&sim_jrn_svc, 0, 0) };
+DEVICE sim_jrn_dev = {
+    "INT-JOURNAL", &sim_jrn_unit, NULL, NULL, 
+    1, 0, 0, 0, 0, 0, 
+    NULL, NULL, &sim_int_jrn_reset, NULL, NULL, NULL, 
+    NULL, DEV_NOSAVE, 0, 
+    NULL, NULL, NULL, NULL, NULL, NULL,
+    sim_int_jrn_description};
+
 static const char *sim_int_flush_description (DEVICE *dptr)
 {
 return "Open File Flush facility";
@@ -756,6 +831,7 @@ const char *sim_savename = sim_name;      /* Simulator Name used in SAVE/RESTORE
 
 const char save_vercur[] = "V4.0";
 const char save_ver40[] = "V4.0";
+const char save_ver40i[] = "V4.0I";                     /* SAVE -I delta */
 const char save_ver35[] = "V3.5";
 const char save_ver32[] = "V3.2";
 const char save_ver30[] = "V3.0";
@@ -1002,6 +1078,23 @@ static const char simh_help1[] =
       " to a file.  This includes the contents of main memory and all registers,\n"
       " and the I/O connections of devices:\n\n"
       "++SAVE <filename>\n\n"
+      "4Switches\n"
+      " Switches can influence the output and behavior of the SAVE command\n\n"
+      "++-Z      Compresses memory contents (needs zlib support)\n"
+      "++-I      Only saves the memory changed since the last SAVE or RESTORE\n"
+      "++-B      Writes the file in the background (not available on all hosts)\n"
+      "\n"
+      " SAVE -I writes an incremental snapshot which refers to the previous\n"
+      " snapshot by name.  Restoring it first restores that snapshot (and any\n"
+      " it in turn refers to), so the whole chain of files must be kept.  When\n"
+      " there is no previous snapshot a complete state is saved.\n"
+      "\n"
+      " SAVE -B writes the file from a copy of the simulator made when the\n"
+      " command is issued, so simulation can be continued immediately.  The\n"
+      " completion status is reported at the next command prompt and by the\n"
+      " SHOW SAVE command.  Only one background SAVE may be in progress; other\n"
+      " SAVE and RESTORE commands wait for it to complete.\n"
+      "\n"
 #define HLP_RESTORE     "*Commands Saving_and_Restoring_State RESTORE"
       "3RESTORE\n"
       " The RESTORE command (abbreviation REST, alternately GET) restores a\n"
@@ -1014,7 +1107,9 @@ static const char simh_help1[] =
       "++-F      Overrides the related file timestamp validation check\n"
       "\n"
       "4Notes:\n"
-      " 1) SAVE file format compresses zeroes to minimize file size.\n"
+      " 1) SAVE file format compresses zeroes to minimize file size.  Files\n"
+      " written with SAVE -Z or SAVE -I can only be restored by simulators which\n"
+      " support them.\n"
       " 2) The simulator can't restore active incoming telnet sessions to\n"
       " multiplexer devices, but the listening ports will be restored across a\n"
       " save/restore.\n"
@@ -1063,6 +1158,20 @@ static const char simh_help1[] =
       " The BOOT command (abbreviated BO) resets all devices and bootstraps the\n"
       " device and unit given by its argument.  If no unit is supplied, unit 0 is\n"
       " bootstrapped.  The specified unit must be attached.\n"
+#define HLP_BENCHMARK   "*Commands Running_A_Simulated_Program BENCHMARK"
+      "3BENCHMARK\n"
+      " The BENCHMARK command runs any of the RUN, GO, CONTINUE, STEP or BOOT\n"
+      " commands and then reports how fast the simulator ran:\n\n"
+      "++BENCHMARK BOOT CDR0\n"
+      "++BENCHMARK STEP 100000000\n\n"
+      " The result is a single line of name=value pairs which can be collected\n"
+      " from the console or log to track performance over time:\n\n"
+      "++BENCHMARK: sim=<name> cmd=\"<command>\" status=\"<stop reason>\"\n"
+      "++++insts=<n> events=<n> wall=<secs> cpu=<secs> ips=<n> eps=<n>\n\n"
+      " insts counts the %C executed, events the event service routines\n"
+      " called, wall and cpu are the elapsed and host processor seconds.\n"
+      " Benchmark scripts for several simulators are provided in their tests\n"
+      " directories as <sim>_bench.ini.\n"
        /***************** 80 character line width template *************************/
       "2Stopping The Simulator\n"
       " Programs run until the simulator detects an error or stop condition, or\n"
@@ -1400,6 +1509,16 @@ static const char simh_help1[] =
       " The size of the circular memory buffer that is used is specified on\n"
       " the SET DEBUG command line, for example:\n\n"
       "++SET DEBUG -B <sizeinMB> <debug-destination>\n\n"
+      "5-K\n"
+      " The -K switch causes debug messages to be recorded unformatted in a\n"
+      " circular table of the given number of entries.  The recorded messages\n"
+      " are formatted and written to the debug destination when the simulator\n"
+      " stops and when debugging is turned off, so that the most recent debug\n"
+      " history is available at much less cost while instructions execute:\n\n"
+      "++SET DEBUG -K <entries> <debug-destination>\n\n"
+      " When both -B and -K are given, the buffer size is specified first.\n"
+      " Debug messages from I/O threads are not recorded but are written\n"
+      " directly.\n"
 #define HLP_SET_BREAK  "*Commands SET Breakpoints"
       "3Breakpoints\n"
       "+SET BREAK <list>            set breakpoints\n"
@@ -1448,6 +1567,20 @@ static const char simh_help1[] =
       "3Asynch\n"
       "+SET ASYNCH                  enable asynchronous I/O\n"
       "+SET NOASYNCH                disable asynchronous I/O\n"
+#define HLP_SET_JOURNAL "*Commands SET Journal"
+      "3Journal\n"
+      "+SET JOURNAL RECORD=file     record externally injected events\n"
+      "+SET JOURNAL REPLAY=file     replay recorded events\n"
+      "+SET NOJOURNAL               stop recording or replaying\n\n"
+      " An event journal makes simulator runs repeatable.  While recording,\n"
+      " console input, multiplexer connections and data, Ethernet packets,\n"
+      " clock calibrations, asynchronous I/O completions and idle periods are\n"
+      " logged with the simulated time they occurred.  While replaying, the\n"
+      " same events are delivered at exactly those times instead of from the\n"
+      " host, so the same instructions execute on every replay.  Multiplexer\n"
+      " lines are connected in loopback mode while replaying, and their output\n"
+      " is discarded.  Both runs must start from the same configuration and\n"
+      " commands.  Catchup clock ticks are disabled while a journal is active.\n"
 #define HLP_SET_ENVIRON "*Commands SET Environment"
       "3Environment\n"
       "4Explicitily Changing a Variable\n"
@@ -1577,6 +1710,9 @@ static const char simh_help2[] =
       "+sh{ow} on                   show on condition actions\n"
       "+sh{ow} do                   show do nesting state\n"
       "+sh{ow} runlimit             show execution limit states\n"
+      "+sh{ow} save                 show background SAVE status\n"
+      "+sh{ow} prof{ile} {n|ALL}    show the most frequently sampled PC values\n"
+      "+sh{ow} prof{ile} file       write the PC samples to a file\n"
       "+h{elp} <dev> show           displays the device specific show commands\n"
       "++++++++                     available\n"
 #define HLP_SHOW_CONFIG         "*Commands SHOW"
@@ -1596,6 +1732,7 @@ static const char simh_help2[] =
 #define HLP_SHOW_DEBUG          "*Commands SHOW"
 #define HLP_SHOW_THROTTLE       "*Commands SHOW"
 #define HLP_SHOW_ASYNCH         "*Commands SHOW"
+#define HLP_SHOW_JOURNAL        "*Commands SHOW"
 #define HLP_SHOW_ETHERNET       "*Commands SHOW"
 #define HLP_SHOW_SERIAL         "*Commands SHOW"
 #define HLP_SHOW_MULTIPLEXER    "*Commands SHOW"
@@ -1604,6 +1741,8 @@ static const char simh_help2[] =
 #define HLP_SHOW_ON             "*Commands SHOW"
 #define HLP_SHOW_DO             "*Commands SHOW"
 #define HLP_SHOW_RUNLIMIT       "*Commands SHOW"
+#define HLP_SHOW_SAVE           "*Commands SHOW"
+#define HLP_SHOW_PROFILE        "*Commands SHOW"
 #define HLP_SHOW_SEND           "*Commands SHOW"
 #define HLP_SHOW_EXPECT         "*Commands SHOW"
 #define HLP_HELP                "*Commands HELP"
@@ -2495,6 +2634,7 @@ static CTAB cmd_table[] = {
     { "NEXT",       &run_cmd,       RU_NEXT,    HLP_NEXT,       NULL, &run_cmd_message },
     { "CONTINUE",   &run_cmd,       RU_CONT,    HLP_CONTINUE,   NULL, &run_cmd_message },
     { "BOOT",       &run_cmd,       RU_BOOT,    HLP_BOOT,       NULL, &run_cmd_message },
+    { "BENCHMARK",  &benchmark_cmd, 0,          HLP_BENCHMARK,  NULL, &run_cmd_message },
     { "BREAK",      &brk_cmd,       SSH_ST,     HLP_BREAK,      NULL, NULL },
     { "NOBREAK",    &brk_cmd,       SSH_CL,     HLP_NOBREAK,    NULL, NULL },
     { "DEBUG",      &debug_cmd,     1,          HLP_DEBUG,      NULL, NULL },
@@ -2576,6 +2716,8 @@ static CTAB set_glob_tab[] = {
     { "CLOCKS",     &sim_set_timers,            1, HLP_SET_CLOCK },
     { "ASYNCH",     &sim_set_asynch,            1, HLP_SET_ASYNCH },
     { "NOASYNCH",   &sim_set_asynch,            0, HLP_SET_ASYNCH },
+    { "JOURNAL",    &sim_set_journal,           1, HLP_SET_JOURNAL },
+    { "NOJOURNAL",  &sim_set_journal,           0, HLP_SET_JOURNAL },
     { "ENVIRONMENT", &sim_set_environment,      1, HLP_SET_ENVIRON },
     { "ON",         &set_on,                    1, HLP_SET_ON },
     { "NOON",       &set_on,                    0, HLP_SET_ON },
@@ -2636,6 +2778,7 @@ static SHTAB show_glob_tab[] = {
     { "DEBUG",          &sim_show_debug,            0, HLP_SHOW_DEBUG },
     { "THROTTLE",       &sim_show_throt,            0, HLP_SHOW_THROTTLE },
     { "ASYNCH",         &sim_show_asynch,           0, HLP_SHOW_ASYNCH },
+    { "JOURNAL",        &sim_show_journal,          0, HLP_SHOW_JOURNAL },
     { "ETHERNET",       &eth_show_devices,          0, HLP_SHOW_ETHERNET },
     { "SERIAL",         &sim_show_serial,           0, HLP_SHOW_SERIAL },
     { "MULTIPLEXER",    &tmxr_show_open_devices,    0, HLP_SHOW_MULTIPLEXER },
@@ -2647,6 +2790,8 @@ static SHTAB show_glob_tab[] = {
     { "ON",             &show_on,                  -1, HLP_SHOW_ON },
     { "DO",             &show_do,                   0, HLP_SHOW_DO },
     { "RUNLIMIT",       &show_runlimit,             0, HLP_SHOW_RUNLIMIT },
+    { "SAVE",           &show_save,                 0, HLP_SHOW_SAVE },
+    { "PROFILE",        &show_profile,              0, HLP_SHOW_PROFILE },
     { NULL,             NULL,                       0 }
     };
 
@@ -2795,6 +2940,7 @@ sim_register_internal_device (&sim_expect_dev);
 sim_register_internal_device (&sim_step_dev);
 sim_register_internal_device (&sim_flush_dev);
 sim_register_internal_device (&sim_runlimit_dev);
+sim_register_internal_device (&sim_jrn_dev);
 
 if ((stat = sim_ttinit ()) != SCPE_OK) {
     fprintf (stderr, "Fatal terminal initialization error\n%s\n",
@@ -2907,6 +3053,7 @@ if (SCPE_BARE_STATUS(stat) != SCPE_EXIT)
 
 cleanup_and_exit:
 
+_sim_bg_save_check (TRUE);                              /* finish SAVE -B */
 detach_all (0, TRUE);                                   /* close files */
 sim_set_deboff (0, NULL);                               /* close debug */
 sim_set_logoff (0, NULL);                               /* close log */
@@ -2939,6 +3086,7 @@ while (stat != SCPE_EXIT) {                             /* in case exit */
         if (sim_on_actions[sim_do_depth][ON_SIGINT_ACTION])
             sim_brk_setact (sim_on_actions[sim_do_depth][ON_SIGINT_ACTION]);
         }
+    _sim_bg_save_check (FALSE);                         /* report SAVE -B */
     sim_do_ocptr[sim_do_depth] = cptr = sim_brk_getact (cbuf, sizeof(cbuf)); /* get bkpt action */
     if (sim_do_ocptr[sim_do_depth]) {                   /* pending action? */
         if (sim_do_echo)
@@ -5512,6 +5660,569 @@ fprintf (st, "Asynchronous I/O is not available in this simulator\n");
 return SCPE_OK;
 }
 
+/* Event journal
+
+   SET JOURNAL RECORD=file logs each externally injected event (console
+   keyboard input, multiplexer connections and receive data, Ethernet
+   receive packets, calibrated timer intervals, asynchronous I/O
+   completions and time skipped while idling) together with the
+   simulated time at which it was seen.
+   SET JOURNAL REPLAY=file feeds the same events back at exactly those
+   times, so that two runs of a workload execute the same instruction
+   stream.  Journal time counts from the SET JOURNAL command and carries
+   across the time base resets done by RUN and BOOT.  Catchup clock
+   ticks depend on wall clock time and are suppressed while a journal
+   is active.
+
+   The journal file is a magic string followed by records, each a JRNHDR
+   and len bytes of event data.  Header fields and the numeric event data
+   described by sim_jrn_width and sim_jrn_words are little endian, so a
+   journal can be replayed on another host.  For replay the records of
+   each event source are indexed in time order.
+*/
+
+#define SIM_JRN_MAGIC   "SIMJRNL1"
+#define SIM_JRN_WAIT_MS 500                     /* max wait for a replayed AIO completion */
+
+typedef struct {
+    double      time;                           /* journal time of event */
+    uint32      id;                             /* event source */
+    uint16      type;                           /* SIM_JRN_xxx */
+    uint16      len;                            /* event data length */
+    } JRNHDR;
+
+typedef struct {
+    JRNHDR      hdr;
+    uint8       *data;                          /* event data */
+    t_bool      done;                           /* already replayed */
+    } JRNENT;
+
+typedef struct {
+    uint32      type;                           /* event type */
+    uint32      id;                             /* event source */
+    uint32      *ents;                          /* its entries in time order */
+    uint32      count;
+    uint32      size;
+    uint32      next;                           /* next entry to replay */
+    } JRNSTREAM;
+
+static const char *sim_jrn_types[] = {
+    "", "Console", "Multiplexer Data", "Multiplexer Connect", "Ethernet",
+    "Clock Calibration", "Asynchronous I/O", "Idle"};
+
+/* Event data is sim_jrn_words elements of sim_jrn_width bytes (0 for
+   all of it) followed by bytes.  A width of 0 is a single value as long
+   as the data. */
+
+static const uint8 sim_jrn_width[] = {1, 4, 1, 4, 4, 0, 4, 4};
+static const uint8 sim_jrn_words[] = {0, 0, 0, 0, 2, 0, 0, 0};
+
+int32 sim_jrn_mode = SIM_JRN_OFF;               /* event journal mode */
+static char sim_jrn_file[CBUFSIZE];             /* journal file name */
+static FILE *sim_jrn_fp = NULL;                 /* file being recorded */
+static JRNENT *sim_jrn_ents = NULL;             /* entries being replayed */
+static uint32 sim_jrn_count = 0;                /* entries recorded or loaded */
+static uint32 sim_jrn_first = 0;                /* first entry not yet replayed */
+static JRNSTREAM *sim_jrn_streams = NULL;       /* entries by source */
+static uint32 sim_jrn_stream_count = 0;
+static JRNSTREAM *sim_jrn_aio = NULL;           /* AIO entries of all units */
+static uint32 sim_jrn_replayed = 0;             /* entries replayed */
+static uint32 sim_jrn_stats[SIM_JRN_IDLE + 1];  /* per type counts */
+static double sim_jrn_base = 0.0;               /* journal time at sim_time 0 */
+static void _sim_jrn_schedule (void);
+
+static double _sim_jrn_time (void)
+{
+return sim_jrn_base + sim_gtime ();
+}
+
+/* Identify a device by its position in the device tables, which is
+   stable across runs of the same simulator configuration */
+
+uint32 sim_jrn_devid (DEVICE *dptr)
+{
+uint32 i;
+
+if (dptr == NULL)
+    return 0xFFFF;
+for (i = 0; sim_devices[i] != NULL; i++)
+    if (sim_devices[i] == dptr)
+        return i;
+for (i = 0; i < sim_internal_device_count; i++)
+    if (sim_internal_devices[i] == dptr)
+        return 0x8000 | i;
+return 0xFFFF;
+}
+
+static uint32 _sim_jrn_unitid (UNIT *uptr)
+{
+DEVICE *dptr = find_dev_from_unit (uptr);
+
+if (dptr == NULL)
+    return 0xFFFFFFFF;
+return (sim_jrn_devid (dptr) << 16) | (uint32)(uptr - dptr->units);
+}
+
+static UNIT *_sim_jrn_unit (uint32 id)
+{
+uint32 dev = id >> 16;
+DEVICE *dptr = NULL;
+
+if (dev & 0x8000) {
+    if ((dev & 0x7FFF) < sim_internal_device_count)
+        dptr = sim_internal_devices[dev & 0x7FFF];
+    }
+else {
+    uint32 i;
+
+    for (i = 0; (i < dev) && sim_devices[i]; i++)
+        ;
+    dptr = sim_devices[i];
+    }
+if ((dptr == NULL) || ((id & 0xFFFF) >= dptr->numunits))
+    return NULL;
+return dptr->units + (id & 0xFFFF);
+}
+
+/* Write or read event data, returns FALSE on error */
+
+static uint32 _sim_jrn_words (uint32 type, uint32 len, size_t *width)
+{
+uint32 n;
+
+*width = (type <= SIM_JRN_IDLE) ? sim_jrn_width[type] : 1;
+if (*width == 0)                                /* single value? */
+    *width = ((len == 2) || (len == 4) || (len == 8)) ? len : 1;
+n = ((type <= SIM_JRN_IDLE) && sim_jrn_words[type]) ? (uint32)MIN (len, sim_jrn_words[type] * *width) : len;
+return n / (uint32)*width;
+}
+
+static t_bool _sim_jrn_write_data (uint32 type, const uint8 *data, uint32 len, FILE *fp)
+{
+size_t width;
+uint32 words = _sim_jrn_words (type, len, &width);
+uint32 bytes = words * (uint32)width;
+
+return ((words == 0) || (sim_fwrite (data, width, words, fp) == words)) &&
+       ((bytes == len) || (fwrite (data + bytes, len - bytes, 1, fp) == 1));
+}
+
+static t_bool _sim_jrn_read_data (uint32 type, uint8 *data, uint32 len, FILE *fp)
+{
+size_t width;
+uint32 words = _sim_jrn_words (type, len, &width);
+uint32 bytes = words * (uint32)width;
+
+return ((words == 0) || (sim_fread (data, width, words, fp) == words)) &&
+       ((bytes == len) || (fread (data + bytes, len - bytes, 1, fp) == 1));
+}
+
+/* Find the index of an event source, adding it if asked to.  Replayed
+   AIO completions are taken in time order across all units. */
+
+static JRNSTREAM *_sim_jrn_stream (uint32 type, uint32 id, t_bool add)
+{
+uint32 i;
+
+if (type == SIM_JRN_AIO)
+    id = 0;
+for (i = 0; i < sim_jrn_stream_count; i++)
+    if ((sim_jrn_streams[i].id == id) && (sim_jrn_streams[i].type == type))
+        return &sim_jrn_streams[i];
+if (!add)
+    return NULL;
+sim_jrn_streams = (JRNSTREAM *)realloc (sim_jrn_streams, (sim_jrn_stream_count + 1) * sizeof (*sim_jrn_streams));
+memset (&sim_jrn_streams[i], 0, sizeof (*sim_jrn_streams));
+sim_jrn_streams[i].type = type;
+sim_jrn_streams[i].id = id;
+++sim_jrn_stream_count;
+return &sim_jrn_streams[i];
+}
+
+/* Take an entry as replayed */
+
+static void _sim_jrn_replayed (JRNENT *ent)
+{
+ent->done = TRUE;
+++sim_jrn_replayed;
+++sim_jrn_stats[(ent->hdr.type <= SIM_JRN_IDLE) ? ent->hdr.type : 0];
+while ((sim_jrn_first < sim_jrn_count) && sim_jrn_ents[sim_jrn_first].done)
+    ++sim_jrn_first;
+}
+
+/* Record an event */
+
+void sim_jrn_record (uint32 type, uint32 id, const void *data, uint32 len)
+{
+JRNHDR hdr;
+
+if ((sim_jrn_mode != SIM_JRN_RECORD) || (sim_jrn_fp == NULL))
+    return;
+memset (&hdr, 0, sizeof (hdr));
+hdr.time = _sim_jrn_time ();
+hdr.id = id;
+hdr.type = (uint16)type;
+hdr.len = (uint16)len;
+if ((sim_fwrite (&hdr.time, sizeof (hdr.time), 1, sim_jrn_fp) != 1) ||
+    (sim_fwrite (&hdr.id, sizeof (hdr.id), 1, sim_jrn_fp) != 1) ||
+    (sim_fwrite (&hdr.type, sizeof (hdr.type), 1, sim_jrn_fp) != 1) ||
+    (sim_fwrite (&hdr.len, sizeof (hdr.len), 1, sim_jrn_fp) != 1) ||
+    !_sim_jrn_write_data (type, (const uint8 *)data, len, sim_jrn_fp)) {
+    sim_printf ("Journal write error on %s: %s\n", sim_jrn_file, strerror (errno));
+    fclose (sim_jrn_fp);
+    sim_jrn_fp = NULL;
+    sim_jrn_mode = SIM_JRN_OFF;
+    return;
+    }
+++sim_jrn_count;
+++sim_jrn_stats[(type <= SIM_JRN_IDLE) ? type : 0];
+}
+
+/* Replay an event
+
+   Returns the length of the event data of the oldest unreplayed event of
+   the given type and source which is now due, copying up to size bytes
+   of it into data, or -1 when no such event is due */
+
+int32 sim_jrn_replay (uint32 type, uint32 id, void *data, uint32 size)
+{
+JRNSTREAM *st;
+JRNENT *ent;
+
+if (sim_jrn_mode != SIM_JRN_REPLAY)
+    return -1;
+st = _sim_jrn_stream (type, id, FALSE);
+if ((st == NULL) || (st->next >= st->count))
+    return -1;
+ent = &sim_jrn_ents[st->ents[st->next]];
+if (ent->hdr.time > _sim_jrn_time ())               /* not due yet? */
+    return -1;
+++st->next;
+_sim_jrn_replayed (ent);
+memcpy (data, ent->data, MIN (size, ent->hdr.len));
+return ent->hdr.len;
+}
+
+#if defined (SIM_ASYNCH_IO)
+/* Asynchronous I/O completions
+
+   While recording, each completion migrated from the asynch queue is
+   logged with the activation it requested.  While replaying, migrated
+   completions are held (with a_next still marking them queued) until the
+   journal reaches the recorded time.  If the completion has not arrived
+   by then, the journal blocks until the I/O thread queues it, for at most
+   SIM_JRN_WAIT_MS, and otherwise activates the unit itself, as happens
+   for reader threads whose data is replayed.
+*/
+
+static UNIT **sim_jrn_held = NULL;              /* completions awaiting replay */
+static int32 sim_jrn_held_count = 0;
+static int32 sim_jrn_held_size = 0;
+
+static void _sim_jrn_aio_record (UNIT *uptr, int32 event_time)
+{
+int32 data[2];
+
+data[0] = event_time;
+data[1] = (uptr->a_activate_call == &sim_activate_abs) ? 1 :
+          ((uptr->a_activate_call == &sim_activate_notbefore) ? 2 : 0);
+sim_jrn_record (SIM_JRN_AIO, _sim_jrn_unitid (uptr), data, sizeof (data));
+}
+
+static void _sim_jrn_aio_hold (UNIT *uptr)
+{
+if (sim_jrn_held_count == sim_jrn_held_size) {
+    sim_jrn_held_size += 16;
+    sim_jrn_held = (UNIT **)realloc (sim_jrn_held, sim_jrn_held_size * sizeof (*sim_jrn_held));
+    }
+uptr->a_next = uptr;                            /* still queued as far as AIO_ACTIVATE knows */
+sim_jrn_held[sim_jrn_held_count++] = uptr;
+}
+
+static t_bool _sim_jrn_aio_unhold (UNIT *uptr)
+{
+int32 i;
+
+for (i = 0; i < sim_jrn_held_count; i++) {
+    if (sim_jrn_held[i] == uptr) {
+        memmove (&sim_jrn_held[i], &sim_jrn_held[i + 1], (sim_jrn_held_count - i - 1) * sizeof (*sim_jrn_held));
+        --sim_jrn_held_count;
+        AIO_ILOCK;
+        uptr->a_next = NULL;
+        AIO_IUNLOCK;
+        return TRUE;
+        }
+    }
+return FALSE;
+}
+
+static void _sim_jrn_aio_activate (UNIT *uptr, int32 call, int32 event_time)
+{
+switch (call) {
+    case 1:
+        sim_activate_abs (uptr, event_time);
+        break;
+    case 2:
+        sim_activate_notbefore (uptr, event_time);
+        break;
+    default:
+        _sim_activate (uptr, event_time);
+        break;
+    }
+if (uptr->a_check_completion)
+    uptr->a_check_completion (uptr);
+}
+
+/* Wait up to msec for an asynchronous I/O completion to be queued.
+   Queueing signals sim_asynch_wake when sim_idle_wait is set. */
+
+static void _sim_jrn_aio_wait (uint32 msec)
+{
+struct timespec end_time;
+
+clock_gettime (CLOCK_REALTIME, &end_time);
+end_time.tv_sec += (msec/1000);
+end_time.tv_nsec += 1000000*(msec%1000);
+if (end_time.tv_nsec >= 1000000000) {
+    end_time.tv_sec += end_time.tv_nsec/1000000000;
+    end_time.tv_nsec = end_time.tv_nsec%1000000000;
+    }
+pthread_mutex_lock (&sim_asynch_lock);
+if (AIO_QUEUE_VAL == QUEUE_LIST_END) {          /* nothing queued yet? */
+    sim_idle_wait = TRUE;
+    pthread_cond_timedwait (&sim_asynch_wake, &sim_asynch_lock, &end_time);
+    sim_idle_wait = FALSE;
+    }
+pthread_mutex_unlock (&sim_asynch_lock);
+}
+
+static void _sim_jrn_aio_release_all (void)
+{
+while (sim_jrn_held_count) {
+    UNIT *uptr = sim_jrn_held[0];
+
+    _sim_jrn_aio_unhold (uptr);
+    _sim_jrn_aio_activate (uptr, (uptr->a_activate_call == &sim_activate_abs) ? 1 :
+                                 ((uptr->a_activate_call == &sim_activate_notbefore) ? 2 : 0), uptr->a_event_time);
+    }
+free (sim_jrn_held);
+sim_jrn_held = NULL;
+sim_jrn_held_size = 0;
+}
+#endif
+
+static t_stat sim_jrn_svc (UNIT *uptr)
+{
+#if defined (SIM_ASYNCH_IO)
+double now = _sim_jrn_time ();
+
+while ((sim_jrn_aio != NULL) && (sim_jrn_aio->next < sim_jrn_aio->count) &&
+       (sim_jrn_ents[sim_jrn_aio->ents[sim_jrn_aio->next]].hdr.time <= now)) {
+    JRNENT *ent = &sim_jrn_ents[sim_jrn_aio->ents[sim_jrn_aio->next++]];
+    UNIT *auptr;
+    int32 data[2] = {0, 0};
+    uint32 start, waited;
+
+    _sim_jrn_replayed (ent);
+    if ((auptr = _sim_jrn_unit (ent->hdr.id)) == NULL)
+        continue;
+    memcpy (data, ent->data, MIN (sizeof (data), ent->hdr.len));
+    start = sim_os_msec ();
+    while (!_sim_jrn_aio_unhold (auptr)) {
+        waited = sim_os_msec () - start;
+        if (waited >= SIM_JRN_WAIT_MS) {
+            sim_debug (SIM_DBG_AIO_QUEUE, &sim_scp_dev, "Journal synthesizing completion for %s\n", sim_uname (auptr));
+            break;
+            }
+        if (sim_aio_update_queue () == 0)       /* migrates into the held list */
+            _sim_jrn_aio_wait (SIM_JRN_WAIT_MS - waited);
+        }
+    _sim_jrn_aio_activate (auptr, data[1], data[0]);
+    }
+_sim_jrn_schedule ();
+#endif
+return SCPE_OK;
+}
+
+/* Schedule the journal unit for the next asynchronous I/O completion */
+
+static void _sim_jrn_schedule (void)
+{
+double delay;
+
+if ((sim_jrn_mode != SIM_JRN_REPLAY) ||
+    (sim_jrn_aio == NULL) || (sim_jrn_aio->next >= sim_jrn_aio->count))
+    return;
+delay = sim_jrn_ents[sim_jrn_aio->ents[sim_jrn_aio->next]].hdr.time - _sim_jrn_time ();
+if (delay < 0.0)
+    delay = 0.0;
+if (delay > 0x7FFFFFFF)
+    delay = 0x7FFFFFFF;
+sim_activate_abs (&sim_jrn_unit, (int32)delay);
+}
+
+static t_stat sim_int_jrn_reset (DEVICE *dptr)
+{
+_sim_jrn_schedule ();
+return SCPE_OK;
+}
+
+/* Start and stop journaling */
+
+static t_stat _sim_jrn_close (void)
+{
+if (sim_jrn_fp)
+    fclose (sim_jrn_fp);
+sim_jrn_fp = NULL;
+if (sim_jrn_ents) {
+    uint32 i;
+
+    for (i = 0; i < sim_jrn_count; i++)
+        free (sim_jrn_ents[i].data);
+    free (sim_jrn_ents);
+    sim_jrn_ents = NULL;
+    }
+while (sim_jrn_stream_count)
+    free (sim_jrn_streams[--sim_jrn_stream_count].ents);
+free (sim_jrn_streams);
+sim_jrn_streams = NULL;
+sim_jrn_aio = NULL;
+sim_jrn_mode = SIM_JRN_OFF;
+#if defined (SIM_ASYNCH_IO)
+_sim_jrn_aio_release_all ();
+#endif
+sim_cancel (&sim_jrn_unit);
+return SCPE_OK;
+}
+
+static t_stat _sim_jrn_open (int32 mode, const char *file)
+{
+char magic[sizeof (SIM_JRN_MAGIC) - 1];
+JRNHDR hdr;
+uint32 size = 0;
+
+_sim_jrn_close ();
+strlcpy (sim_jrn_file, file, sizeof (sim_jrn_file));
+sim_jrn_count = sim_jrn_first = sim_jrn_replayed = 0;
+memset (sim_jrn_stats, 0, sizeof (sim_jrn_stats));
+sim_jrn_base = -sim_gtime ();
+if (mode == SIM_JRN_RECORD) {
+    if ((sim_jrn_fp = sim_fopen (file, "wb")) == NULL)
+        return sim_messagef (SCPE_OPENERR, "Can't create journal %s: %s\n", file, strerror (errno));
+    fwrite (SIM_JRN_MAGIC, sizeof (magic), 1, sim_jrn_fp);
+    sim_jrn_mode = SIM_JRN_RECORD;
+    sim_timer_journal_start ();
+    return SCPE_OK;
+    }
+if ((sim_jrn_fp = sim_fopen (file, "rb")) == NULL)
+    return sim_messagef (SCPE_OPENERR, "Can't open journal %s: %s\n", file, strerror (errno));
+if ((fread (magic, sizeof (magic), 1, sim_jrn_fp) != 1) ||
+    (memcmp (magic, SIM_JRN_MAGIC, sizeof (magic)) != 0)) {
+    _sim_jrn_close ();
+    return sim_messagef (SCPE_FMT, "%s is not a journal file\n", file);
+    }
+memset (&hdr, 0, sizeof (hdr));
+while ((sim_fread (&hdr.time, sizeof (hdr.time), 1, sim_jrn_fp) == 1) &&
+       (sim_fread (&hdr.id, sizeof (hdr.id), 1, sim_jrn_fp) == 1) &&
+       (sim_fread (&hdr.type, sizeof (hdr.type), 1, sim_jrn_fp) == 1) &&
+       (sim_fread (&hdr.len, sizeof (hdr.len), 1, sim_jrn_fp) == 1)) {
+    JRNENT *ent;
+    JRNSTREAM *st;
+
+    if (sim_jrn_count == size) {
+        size += 1024;
+        sim_jrn_ents = (JRNENT *)realloc (sim_jrn_ents, size * sizeof (*sim_jrn_ents));
+        }
+    ent = &sim_jrn_ents[sim_jrn_count];
+    ent->hdr = hdr;
+    ent->done = FALSE;
+    ent->data = (uint8 *)malloc (hdr.len + 1);
+    if (!_sim_jrn_read_data (hdr.type, ent->data, hdr.len, sim_jrn_fp)) {
+        free (ent->data);
+        break;
+        }
+    st = _sim_jrn_stream (hdr.type, hdr.id, TRUE);  /* index by source */
+    if (st->count == st->size) {
+        st->size += 256;
+        st->ents = (uint32 *)realloc (st->ents, st->size * sizeof (*st->ents));
+        }
+    st->ents[st->count++] = sim_jrn_count;
+    ++sim_jrn_count;
+    }
+sim_jrn_aio = _sim_jrn_stream (SIM_JRN_AIO, 0, FALSE);
+fclose (sim_jrn_fp);
+sim_jrn_fp = NULL;
+sim_jrn_mode = SIM_JRN_REPLAY;
+sim_timer_journal_start ();
+_sim_jrn_schedule ();
+return SCPE_OK;
+}
+
+/* Set journal/nojournal routine */
+
+t_stat sim_set_journal (int32 flag, CONST char *cptr)
+{
+char gbuf[CBUFSIZE];
+int32 mode;
+t_stat r;
+
+if (flag == 0) {
+    if (cptr && (*cptr != 0))                           /* now eol? */
+        return SCPE_2MARG;
+    if (sim_jrn_mode == SIM_JRN_OFF)
+        return SCPE_OK;
+    if (sim_jrn_mode == SIM_JRN_RECORD)
+        sim_messagef (SCPE_OK, "Journal %s closed, %u events recorded\n", sim_jrn_file, sim_jrn_count);
+    else
+        sim_messagef (SCPE_OK, "Journal %s closed, %u of %u events replayed\n", sim_jrn_file, sim_jrn_replayed, sim_jrn_count);
+    return _sim_jrn_close ();
+    }
+if ((!cptr) || (*cptr == 0))
+    return SCPE_2FARG;
+cptr = get_glyph (cptr, gbuf, '=');
+if (MATCH_CMD (gbuf, "RECORD") == 0)
+    mode = SIM_JRN_RECORD;
+else {
+    if (MATCH_CMD (gbuf, "REPLAY") == 0)
+        mode = SIM_JRN_REPLAY;
+    else
+        return sim_messagef (SCPE_ARG, "Unknown journal mode: %s\n", gbuf);
+    }
+if ((!cptr) || (*cptr == 0))
+    return sim_messagef (SCPE_2FARG, "Missing journal file name\n");
+r = _sim_jrn_open (mode, cptr);
+if ((r == SCPE_OK) && (mode == SIM_JRN_REPLAY))
+    sim_messagef (SCPE_OK, "Replaying %u events from %s\n", sim_jrn_count, sim_jrn_file);
+return r;
+}
+
+/* Show journal routine */
+
+t_stat sim_show_journal (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr)
+{
+int32 i;
+
+if (cptr && (*cptr != 0))
+    return SCPE_2MARG;
+switch (sim_jrn_mode) {
+    case SIM_JRN_OFF:
+        fprintf (st, "No event journal\n");
+        return SCPE_OK;
+    case SIM_JRN_RECORD:
+        fprintf (st, "Recording event journal %s, %u events\n", sim_jrn_file, sim_jrn_count);
+        break;
+    case SIM_JRN_REPLAY:
+        fprintf (st, "Replaying event journal %s, %u of %u events replayed\n", sim_jrn_file, sim_jrn_replayed, sim_jrn_count);
+        if (sim_jrn_first < sim_jrn_count)
+            fprintf (st, "Next event due at journal time %.0f, now %.0f\n", sim_jrn_ents[sim_jrn_first].hdr.time, _sim_jrn_time ());
+        break;
+    }
+for (i = SIM_JRN_CON; i <= SIM_JRN_IDLE; i++)
+    if (sim_jrn_stats[i])
+        fprintf (st, "  %-20s %u\n", sim_jrn_types[i], sim_jrn_stats[i]);
+return SCPE_OK;
+}
+
 /* Set environment routine */
 
 t_stat sim_set_environment (int32 flag, CONST char *cptr)
@@ -5609,6 +6320,7 @@ if (*cptr == 0)                                         /* must be more */
 cptr = get_glyph (svptr = cptr, gbuf, 0);               /* get glob/dev/unit */
 
 if ((dptr = find_dev (gbuf))) {                         /* device match? */
+    _sim_mem_regions_dirty (TRUE);                      /* may touch memory */
     uptr = dptr->units;                                 /* first unit */
     ctbr = set_dev_tab;                                 /* global table */
     lvl = MTAB_VDV;                                     /* device match */
@@ -6553,10 +7265,13 @@ if (sim_clock_queue == QUEUE_LIST_END)
 else {
     const char *tim = "";
     double inst_per_sec = sim_timer_inst_per_sec ();
+    UNIT **ulist;
+    int32 i, cnt = _sim_queue_list (&ulist);
 
     fprintf (st, "%s event queue status, time = %.0f, executing %s %s/sec\n",
              sim_name, sim_time, sim_fmt_numeric (inst_per_sec), sim_vm_interval_units);
-    for (uptr = sim_clock_queue; uptr != QUEUE_LIST_END; uptr = uptr->next) {
+    for (i = 0; i < cnt; i++) {
+        uptr = ulist[i];
         if (uptr == &sim_step_unit)
             fprintf (st, "  Step timer");
         else
@@ -6581,6 +7296,7 @@ else {
                                             (*tim) ? " (" : "", tim, (*tim) ? ")" : "",
                                             (uptr->flags & UNIT_IDLE) ? " (Idle capable)" : "");
         }
+    free (ulist);
     }
 sim_show_clock_queues (st, dnotused, unotused, flag, cptr);
 #if defined (SIM_ASYNCH_IO)
@@ -7512,6 +8228,7 @@ uint32 i;
 t_stat reason;
 int32 saved_sim_switches = sim_switches;
 
+_sim_mem_regions_dirty (TRUE);                          /* resets may change memory */
 for (i = 0; i < start; i++) {
     if (sim_devices[i] == NULL)
         return SCPE_IERR;
@@ -7692,6 +8409,8 @@ if (!mem_data) {
         return SCPE_OPENERR;
     }
 GET_SWITCHES (cptr);                                    /* get switches */
+if (!flag)
+    _sim_mem_regions_dirty (TRUE);                      /* loader writes memory */
 reason = sim_load (loadfile, (CONST char *)cptr, gbuf, flag);/* load or dump */
 if (loadfile)
     fclose (loadfile);
@@ -7722,6 +8441,7 @@ if (dptr == NULL)                                       /* found dev? */
     return SCPE_NXDEV;
 if (uptr == NULL)                                       /* valid unit? */
     return SCPE_NXUN;
+_sim_mem_regions_dirty (TRUE);                          /* may touch memory */
 if (uptr->flags & UNIT_ATT) {                           /* already attached? */
     if (!(uptr->dynflags & UNIT_ATTMULT) &&             /* and only single attachable */
         !(dptr->flags & DEV_DONTAUTO)) {                /* and auto detachable */
@@ -8079,6 +8799,7 @@ t_stat save_cmd (int32 flag, CONST char *cptr)
 FILE *sfile;
 t_stat r;
 char gbuf[4*CBUFSIZE];
+char *fullpath;
 
 GET_SWITCHES (cptr);                                    /* get switches */
 if (*cptr == 0)                                         /* must be more */
@@ -8086,42 +8807,225 @@ if (*cptr == 0)                                         /* must be more */
 gbuf[sizeof(gbuf)-1] = '\0';
 strlcpy (gbuf, cptr, sizeof(gbuf));
 sim_trim_endspc (gbuf);
+#if !defined(SIM_BG_SAVE)
+if (sim_switches & SWMASK ('B'))
+    return sim_messagef (SCPE_NOFNC, "SAVE -B is not supported on this host\n");
+#endif
+_sim_bg_save_check (TRUE);                              /* one SAVE at a time */
+fullpath = sim_filepath_parts (gbuf, "f");
 if ((sfile = sim_fopen (gbuf, "r+b")) == NULL) {    /* try existing file */
-    if ((sfile = sim_fopen (gbuf, "wb")) == NULL)   /* create new empty file */
+    if ((sfile = sim_fopen (gbuf, "wb")) == NULL) { /* create new empty file */
+        free (fullpath);
         return SCPE_OPENERR;
+        }
     }
+if ((sim_switches & SWMASK ('I')) &&                    /* incremental? */
+    (sim_snap_base != NULL) && (fullpath != NULL) &&
+    (strcmp (fullpath, sim_snap_base) != 0))            /* and not replacing base */
+    sim_save_base = sim_snap_base;
+#if defined(SIM_BG_SAVE)
+if (sim_switches & SWMASK ('B'))                        /* background? */
+    r = _sim_bg_save (sfile, gbuf);
+else
+    r = sim_save (sfile);
+#else
 r = sim_save (sfile);
+#endif
 fclose (sfile);
+sim_save_base = NULL;
+if ((r == SCPE_OK) && (fullpath != NULL)) {             /* new snapshot base */
+    free (sim_snap_base);
+    sim_snap_base = fullpath;
+    _sim_mem_regions_dirty (FALSE);
+    }
+else
+    free (fullpath);
 return r;
 }
 
-t_stat sim_save (FILE *sfile)
+/* Write back a writable buffered unit file so that the save file refers
+   to its current contents */
+
+static void _sim_save_flush_unit (DEVICE *dptr, UNIT *uptr)
 {
-void *mbuf;
-int32 l, t;
-uint32 i, j, device_count;
-t_addr k, high;
-t_value val;
-t_stat r;
-t_bool zeroflg;
-size_t sz;
-DEVICE *dptr;
-UNIT *uptr;
-REG *rptr;
+if ((uptr->flags & UNIT_ATT) &&
+    (uptr->flags & UNIT_BUF) &&                         /* writable buffered */
+    uptr->hwmark &&                                     /* files need to be */
+    ((uptr->flags & UNIT_RO) == 0)) {                   /* written on save */
+    uint32 cap = (uptr->hwmark + dptr->aincr - 1) / dptr->aincr;
+    rewind (uptr->fileref);
+    sim_fwrite (uptr->filebuf, SZ_D (dptr), cap, uptr->fileref);
+    fclose (uptr->fileref);                             /* flush data and state */
+    uptr->fileref = sim_fopen (uptr->filename, "rb+");  /* reopen r/w */
+    }
+}
 
-#define WRITE_I(xx) sim_fwrite (&(xx), sizeof (xx), 1, sfile)
+/* Background save (SAVE -B)
 
-sim_debug(SIM_DBG_SAVE, &sim_scp_dev, "sim_save ()\n");
+   The state is written to the save file by a fork()ed child while the
+   parent goes on simulating.  AIO, timer and console threads may hold
+   stdio, malloc or simulator locks at the fork, which the child would
+   then wait for forever, so the child does nothing but write(2) the
+   state which the parent has serialized into memory and _exit.  The
+   child's exit status is collected by _sim_bg_save_check, at the command
+   prompt, by SHOW SAVE and by anything which needs the file complete.
+*/
 
-/* Don't make changes below without also changing save_vercur above */
+#if defined(SIM_BG_SAVE)
+static t_stat _sim_bg_save (FILE *sfile, const char *filename)
+{
+FILE *mfile;
+char *mbuf = NULL;
+size_t msize = 0;
+t_stat r;
+pid_t pid;
 
-fprintf (sfile, "%s\n%s\n%s\n%s\n%s\n%.0f\n",
-    save_vercur,                                        /* [V2.5] save format */
-    sim_savename,                                       /* sim name */
-    sim_si64, sim_sa64, eth_capabilities(),             /* [V3.5] options */
-    sim_time);                                          /* [V3.2] sim time */
-WRITE_I (sim_rtime);                                    /* [V2.6] sim rel time */
-#if defined(SIM_GIT_COMMIT_ID)
+if ((mfile = open_memstream (&mbuf, &msize)) == NULL)
+    return SCPE_MEM;
+r = sim_save (mfile);                                   /* serialize the state */
+if (fclose (mfile) && (r == SCPE_OK))
+    r = SCPE_MEM;
+if (r != SCPE_OK) {
+    free (mbuf);
+    return r;
+    }
+fflush (sfile);
+fflush (stdout);                                        /* don't duplicate */
+if (sim_log)                                            /* pending output */
+    fflush (sim_log);
+if (sim_deb)
+    fflush (sim_deb);
+pid = fork ();
+if (pid < 0) {
+    free (mbuf);
+    return sim_messagef (SCPE_IERR, "SAVE -B can't create a process: %s\n", strerror (errno));
+    }
+if (pid == 0) {                                         /* child */
+    int fd = fileno (sfile);
+    size_t done = 0;
+    ssize_t n;
+
+    while (done < msize) {                              /* write(2) and _exit only */
+        n = write (fd, mbuf + done, msize - done);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            _exit (SCPE_BARE_STATUS (SCPE_IOERR));
+            }
+        done += (size_t)n;
+        }
+    if (ftruncate (fd, (off_t)msize))                   /* drop any old tail */
+        _exit (SCPE_BARE_STATUS (SCPE_IOERR));
+    _exit (SCPE_BARE_STATUS (SCPE_OK));
+    }
+free (mbuf);
+sim_bg_save_pid = pid;
+free (sim_bg_save_file);
+sim_bg_save_file = (char *)malloc (strlen (filename) + 1);
+if (sim_bg_save_file)
+    strcpy (sim_bg_save_file, filename);
+sim_bg_save_start = time (NULL);
+sim_bg_save_secs = 0;
+sim_bg_save_stat = SCPE_OK;
+if (!sim_quiet)
+    sim_printf ("Background SAVE to %s started\n", filename);
+return SCPE_OK;
+}
+#endif
+
+/* Collect the status of a completed background save, optionally waiting
+   for it.  A failed save can't serve as a SAVE -I base. */
+
+static void _sim_bg_save_check (t_bool wait)
+{
+#if defined(SIM_BG_SAVE)
+int status;
+pid_t pid;
+
+if (sim_bg_save_pid == 0)                               /* none running? */
+    return;
+do
+    pid = waitpid (sim_bg_save_pid, &status, wait ? 0 : WNOHANG);
+    while ((pid < 0) && (errno == EINTR));
+if (pid == 0)                                           /* still running */
+    return;
+sim_bg_save_pid = 0;
+sim_bg_save_secs = (int32)(time (NULL) - sim_bg_save_start);
+if ((pid < 0) || !WIFEXITED (status))
+    sim_bg_save_stat = SCPE_IERR;
+else
+    sim_bg_save_stat = WEXITSTATUS (status);
+if (sim_bg_save_stat != SCPE_OK) {
+    free (sim_snap_base);
+    sim_snap_base = NULL;
+    _sim_mem_regions_dirty (TRUE);
+    sim_printf ("Background SAVE to %s failed: %s\n", sim_bg_save_file, sim_error_text (sim_bg_save_stat));
+    }
+else
+    if (!sim_quiet)
+        sim_printf ("Background SAVE to %s complete (%d second%s)\n", sim_bg_save_file, sim_bg_save_secs, (sim_bg_save_secs == 1) ? "" : "s");
+#endif
+}
+
+/* Show background save status */
+
+t_stat show_save (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr)
+{
+if (cptr && (*cptr != 0))
+    return SCPE_2MARG;
+_sim_bg_save_check (FALSE);
+if (sim_bg_save_file == NULL)
+    fprintf (st, "No background SAVE has been done\n");
+else {
+#if defined(SIM_BG_SAVE)
+    if (sim_bg_save_pid != 0)
+        fprintf (st, "Background SAVE to %s in progress for %d seconds\n", sim_bg_save_file, (int)(time (NULL) - sim_bg_save_start));
+    else
+#endif
+    if (sim_bg_save_stat == SCPE_OK)
+        fprintf (st, "Background SAVE to %s completed in %d seconds\n", sim_bg_save_file, sim_bg_save_secs);
+    else
+        fprintf (st, "Background SAVE to %s failed: %s\n", sim_bg_save_file, sim_error_text (sim_bg_save_stat));
+    }
+if (sim_snap_base)
+    fprintf (st, "SAVE -I base: %s\n", sim_snap_base);
+return SCPE_OK;
+}
+
+t_stat sim_save (FILE *sfile)
+{
+void *mbuf;
+int32 l, t;
+uint32 i, j, device_count;
+t_addr k, high;
+t_value val;
+t_stat r;
+t_bool zeroflg;
+size_t sz;
+DEVICE *dptr;
+UNIT *uptr;
+REG *rptr;
+MEMREGION *mr;
+const char *base = sim_save_base;
+#if defined(HAVE_ZLIB)
+t_bool compress_mem = ((sim_switches & SWMASK ('Z')) != 0);
+Bytef *cbuf = NULL;
+uLongf clen;
+#endif
+
+#define WRITE_I(xx) sim_fwrite (&(xx), sizeof (xx), 1, sfile)
+
+sim_debug(SIM_DBG_SAVE, &sim_scp_dev, "sim_save ()\n");
+
+/* Don't make changes below without also changing save_vercur above */
+
+fprintf (sfile, "%s\n%s\n%s\n%s\n%s\n%.0f\n",
+    base ? save_ver40i : save_vercur,                   /* [V2.5] save format */
+    sim_savename,                                       /* sim name */
+    sim_si64, sim_sa64, eth_capabilities(),             /* [V3.5] options */
+    sim_time);                                          /* [V3.2] sim time */
+WRITE_I (sim_rtime);                                    /* [V2.6] sim rel time */
+#if defined(SIM_GIT_COMMIT_ID)
 #define S_xstr(a) S_str(a)
 #define S_str(a) #a
 fprintf (sfile, "git commit id: %8.8s\n", S_xstr(SIM_GIT_COMMIT_ID));
@@ -8130,6 +9034,8 @@ fprintf (sfile, "git commit id: %8.8s\n", S_xstr(SIM_GIT_COMMIT_ID));
 #else
 fprintf (sfile, "git commit id: unknown\n");
 #endif
+if (base)                                               /* [V4.0I] base snapshot */
+    fprintf (sfile, "%s\n", base);
 
 for (device_count = 0; sim_devices[device_count]; device_count++);/* count devices */
 for (i = 0; i < (device_count + sim_internal_device_count); i++) {/* loop thru devices */
@@ -8166,15 +9072,7 @@ for (i = 0; i < (device_count + sim_internal_device_count); i++) {/* loop thru d
         WRITE_I (uptr->pos);
         if (uptr->flags & UNIT_ATT) {
             fputs (uptr->filename, sfile);
-            if ((uptr->flags & UNIT_BUF) &&             /* writable buffered */
-                uptr->hwmark &&                         /* files need to be */
-                ((uptr->flags & UNIT_RO) == 0)) {       /* written on save */
-                uint32 cap = (uptr->hwmark + dptr->aincr - 1) / dptr->aincr;
-                rewind (uptr->fileref);
-                sim_fwrite (uptr->filebuf, SZ_D (dptr), cap, uptr->fileref);
-                fclose (uptr->fileref);                 /* flush data and state */
-                uptr->fileref = sim_fopen (uptr->filename, "rb+");/* reopen r/w */
-                }
+            _sim_save_flush_unit (dptr, uptr);
             }
         fputc ('\n', sfile);
         if (((uptr->flags & (UNIT_FIX + UNIT_ATTABLE)) == UNIT_FIX) &&
@@ -8186,28 +9084,83 @@ for (i = 0; i < (device_count + sim_internal_device_count); i++) {/* loop thru d
                 fclose (sfile);
                 return SCPE_MEM;
                 }
+            mr = _sim_find_mem_region (dptr, uptr, sz);
+#if defined(HAVE_ZLIB)
+            if (compress_mem &&
+                ((cbuf = (Bytef *)malloc (compressBound (SRBSIZ * sizeof (t_uint64)))) == NULL)) {
+                free (mbuf);
+                fclose (sfile);
+                return SCPE_MEM;
+                }
+#endif
             for (k = 0; k < high; ) {                   /* loop thru mem */
-                zeroflg = TRUE;
-                for (l = 0; (l < SRBSIZ) && (k < high); l++,
-                     k = k + (dptr->aincr)) {           /* check for 0 block */
-                    r = dptr->examine (&val, k, uptr, SIM_SW_REST);
-                    if (r != SCPE_OK) {
-                        free (mbuf);
-                        return r;
+                if (base && (mr != NULL) &&             /* unchanged since base? */
+                    (mr->dirty != NULL) && (k >= mr->low) &&
+                    !SIM_IS_DIRTY (mr->dirty, k)) {
+                    int32 marker = 0;
+                    uint32 csize = 0;
+
+                    for (l = 0; (k < high) &&           /* run of kept pages */
+                         !SIM_IS_DIRTY (mr->dirty, k); l = l + SRBSIZ)
+                        k = k + SRBSIZ;
+                    if (k > high) {                     /* partial last page */
+                        l = l - (int32)(k - high);
+                        k = high;
                         }
-                    if (val) zeroflg = FALSE;
-                    SZ_STORE (sz, val, mbuf, l);
-                    }                                   /* end for l */
+                    WRITE_I (marker);                   /* zero count and size */
+                    WRITE_I (l);                        /* mark kept blocks */
+                    WRITE_I (csize);
+                    continue;
+                    }
+                if ((mr != NULL) && (k >= mr->low)) {   /* direct from memory array? */
+                    l = (int32)MIN (SRBSIZ, high - k);
+                    zeroflg = _sim_mem_region_get (mr, k, l, mbuf, sz);
+                    k = k + l;
+                    }
+                else {
+                    zeroflg = TRUE;
+                    for (l = 0; (l < SRBSIZ) && (k < high); l++,
+                         k = k + (dptr->aincr)) {       /* check for 0 block */
+                        r = dptr->examine (&val, k, uptr, SIM_SW_REST);
+                        if (r != SCPE_OK) {
+                            free (mbuf);
+#if defined(HAVE_ZLIB)
+                            free (cbuf);
+#endif
+                            return r;
+                            }
+                        if (val) zeroflg = FALSE;
+                        SZ_STORE (sz, val, mbuf, l);
+                        }                               /* end for l */
+                    }
                 if (zeroflg) {                          /* all zero's? */
                     l = -l;                             /* invert block count */
                     WRITE_I (l);                        /* write only count */
+                    continue;
                     }
-                else {
+#if defined(HAVE_ZLIB)
+                clen = compressBound (SRBSIZ * sizeof (t_uint64));
+                if (compress_mem &&                     /* compressed block? */
+                    (compress2 (cbuf, &clen, (Bytef *)mbuf, (uLong)(l * sz), Z_BEST_SPEED) == Z_OK) &&
+                    (clen < (l * sz))) {
+                    int32 marker = 0;
+                    uint32 csize = (uint32)clen;
+
+                    WRITE_I (marker);                   /* zero count marks compressed */
                     WRITE_I (l);                        /* block count */
-                    sim_fwrite (mbuf, sz, l, sfile);
+                    WRITE_I (csize);                    /* compressed size */
+                    sim_fwrite (cbuf, 1, csize, sfile);
+                    continue;
                     }
+#endif
+                WRITE_I (l);                            /* block count */
+                sim_fwrite (mbuf, sz, l, sfile);
                 }                                       /* end for k */
             free (mbuf);                                /* dealloc buffer */
+#if defined(HAVE_ZLIB)
+            free (cbuf);
+            cbuf = NULL;
+#endif
             }                                           /* end if mem */
         else {                                          /* no memory */
             high = 0;                                   /* write 0 */
@@ -8256,10 +9209,16 @@ if (*cptr == 0)                                         /* must be more */
 gbuf[sizeof(gbuf)-1] = '\0';
 strlcpy (gbuf, cptr, sizeof(gbuf));
 sim_trim_endspc (gbuf);
+_sim_bg_save_check (TRUE);                              /* file may be in use */
 if ((rfile = sim_fopen (gbuf, "rb")) == NULL)
     return SCPE_OPENERR;
 r = sim_rest (rfile);
 fclose (rfile);
+free (sim_snap_base);                                   /* memory now matches */
+sim_snap_base = NULL;                                   /* the restored file */
+if (r == SCPE_OK)
+    sim_snap_base = sim_filepath_parts (gbuf, "f");
+_sim_mem_regions_dirty (sim_snap_base == NULL);
 return r;
 }
 
@@ -8271,13 +9230,15 @@ UNIT **attunits = NULL;
 int32 *attswitches = NULL;
 int32 attcnt = 0;
 void *mbuf = NULL;
+void *cbuf = NULL;
+MEMREGION *mr;
 int32 j, blkcnt, limit, unitno, time, flg;
 uint32 us, depth;
 t_addr k, high, old_capac;
 t_value val, mask;
 t_stat r;
 size_t sz;
-t_bool v40, v35, v32;
+t_bool v40, v35, v32, incremental;
 DEVICE *dptr;
 UNIT *uptr;
 REG *rptr;
@@ -8304,9 +9265,11 @@ if (fstat (fileno (rfile), &rstat)) {
     }
 READ_S (buf);                                           /* [V2.5+] read version */
 sim_debug (SIM_DBG_RESTORE, &sim_scp_dev, "version=%s\n", buf);
-v40 = v35 = v32 = FALSE;
+v40 = v35 = v32 = incremental = FALSE;
 if (strcmp (buf, save_ver40) == 0)                      /* version 4.0? */
     v40 = v35 = v32 = TRUE;
+else if (strcmp (buf, save_ver40i) == 0)                /* version 4.0 delta? */
+    v40 = v35 = v32 = incremental = TRUE;
 else if (strcmp (buf, save_ver35) == 0)                 /* version 3.5? */
     v35 = v32 = TRUE;
 else if (strcmp (buf, save_ver32) == 0)                 /* version 3.2? */
@@ -8315,7 +9278,7 @@ else if (strcmp (buf, save_ver30) != 0) {               /* version 3.0? */
     sim_printf ("Invalid file version: %s\n", buf);
     return SCPE_INCOMP;
     }
-if ((strcmp (buf, save_ver40) != 0) && (!sim_quiet) && (!suppress_warning)) {
+if ((!v40) && (!sim_quiet) && (!suppress_warning)) {
     sim_printf ("warning - attempting to restore a saved simulator image in %s image format.\n", buf);
     warned = TRUE;
     }
@@ -8358,6 +9321,23 @@ if (v40) {
 #undef S_xstr
 #endif
     }
+if (incremental) {                                      /* [V4.0I] delta? */
+    FILE *bfile;
+
+    READ_S (buf);                                       /* base snapshot */
+    sim_debug (SIM_DBG_RESTORE, &sim_scp_dev, "base=%s\n", buf);
+    if ((bfile = sim_fopen (buf, "rb")) == NULL) {
+        sim_printf ("Can't open base snapshot: %s\n", buf);
+        r = SCPE_OPENERR;
+        goto Cleanup_Return;
+        }
+    sim_switches = SWMASK ('D') | SWMASK ('Q') |        /* state and memory only */
+                   (force_restore ? SWMASK ('F') : 0);
+    r = sim_rest (bfile);                               /* restore base first */
+    fclose (bfile);
+    if (r != SCPE_OK)
+        goto Cleanup_Return;
+    }
 if (!dont_detach_attach)
     detach_all (0, 0);                                  /* Detach everything to start from a consistent state */
 else {
@@ -8498,6 +9478,7 @@ for ( ;; ) {                                            /* device loop */
                 r = SCPE_MEM;
                 goto Cleanup_Return;
                 }
+            mr = _sim_find_mem_region (dptr, uptr, sz);
             for (k = 0; k < high; ) {                   /* loop thru mem */
                 if (sim_fread (&blkcnt, sizeof (blkcnt), 1, rfile) == 0) {/* block count */
                     r = SCPE_IOERR;
@@ -8505,12 +9486,52 @@ for ( ;; ) {                                            /* device loop */
                     }
                 if (blkcnt < 0)                         /* compressed? */
                     limit = -blkcnt;
+                else if (blkcnt == 0) {                 /* SAVE -Z or -I block? */
+                    uint32 csize;
+#if defined(HAVE_ZLIB)
+                    uLongf dlen;
+#endif
+
+                    READ_I (blkcnt);
+                    READ_I (csize);
+                    if ((blkcnt > 0) && ((k + blkcnt) <= high) &&
+                        (csize == 0) && incremental) {  /* SAVE -I kept blocks? */
+                        k = k + blkcnt;                 /* already restored */
+                        continue;
+                        }
+                    if ((blkcnt <= 0) || (blkcnt > SRBSIZ) ||
+                        (csize == 0) || (csize > (uint32)(2 * SRBSIZ * sz)) ||
+                        ((cbuf = realloc (cbuf, csize)) == NULL) ||
+                        (sim_fread (cbuf, 1, csize, rfile) != csize)) {
+                        r = SCPE_IOERR;
+                        goto Cleanup_Return;
+                        }
+#if defined(HAVE_ZLIB)
+                    dlen = (uLongf)(blkcnt * sz);
+                    if ((uncompress ((Bytef *)mbuf, &dlen, (Bytef *)cbuf, csize) != Z_OK) ||
+                        (dlen != (uLongf)(blkcnt * sz))) {
+                        r = SCPE_IOERR;
+                        goto Cleanup_Return;
+                        }
+                    limit = blkcnt;
+#else
+                    sim_printf ("Compressed memory in save file needs zlib support: %s%d\n", sim_dname (dptr), unitno);
+                    r = SCPE_INCOMP;
+                    goto Cleanup_Return;
+#endif
+                    }
                 else
                     limit = (int32)sim_fread (mbuf, sz, blkcnt, rfile);
                 if (limit <= 0) {                       /* invalid or err? */
                     r = SCPE_IOERR;
                     goto Cleanup_Return;
                     }
+                if ((mr != NULL) && (k >= mr->low) &&   /* direct to memory array? */
+                    ((k + limit) <= uptr->capac)) {
+                    _sim_mem_region_put (mr, k, limit, (blkcnt < 0) ? NULL : mbuf, sz);
+                    k = k + limit;
+                    continue;
+                    }
                 for (j = 0; j < limit; j++, k = k + (dptr->aincr)) {
                     if (blkcnt < 0)                     /* compressed? */
                         val = 0;
@@ -8599,6 +9620,7 @@ for (j=0, r = SCPE_OK; j<attcnt; j++) {
     }
 Cleanup_Return:
 free (mbuf);
+free (cbuf);
 for (j=0; j < attcnt; j++)
     free (attnames[j]);
 free (attnames);
@@ -8933,6 +9955,49 @@ return r | ((sim_switches & SWMASK ('Q')) ? SCPE_NOMESSAGE : 0);
 
 /* run command message handler */
 
+/* Benchmark command
+
+   bench[mark] <run command>    run and report the execution rate
+*/
+
+t_stat benchmark_cmd (int32 flag, CONST char *cptr)
+{
+char gbuf[CBUFSIZE], cmd[CBUFSIZE], status[CBUFSIZE];
+CTAB *cmdp;
+double start_insts = sim_gtime ();
+t_uint64 start_events = sim_event_count;
+uint32 start_ms = sim_os_msec ();
+clock_t start_cpu = clock ();
+double insts, wall, cpu;
+t_stat r;
+
+strlcpy (cmd, cptr, sizeof (cmd));
+sim_trim_endspc (cmd);
+cptr = get_glyph (cptr, gbuf, 0);                       /* get command */
+if (gbuf[0] == '\0')
+    return SCPE_2FARG;
+cmdp = find_cmd (gbuf);
+if ((cmdp == NULL) || (cmdp->action != &run_cmd) || (cmdp->arg == RU_NEXT))
+    return sim_messagef (SCPE_ARG, "BENCHMARK needs a RUN, GO, CONTINUE, STEP or BOOT command\n");
+if ((cmdp->arg == RU_RUN) || (cmdp->arg == RU_BOOT))   /* time restarts at 0 */
+    start_insts = 0.0;
+r = run_cmd (cmdp->arg, cptr);
+wall = (sim_os_msec () - start_ms) / 1000.0;
+cpu = (double)(clock () - start_cpu) / CLOCKS_PER_SEC;
+insts = sim_gtime () - start_insts;
+if (SCPE_BARE_STATUS (r) >= SCPE_BASE)
+    strlcpy (status, sim_error_text (r), sizeof (status));
+else
+    if (sim_stop_messages[SCPE_BARE_STATUS (r)])
+        strlcpy (status, sim_stop_messages[SCPE_BARE_STATUS (r)], sizeof (status));
+    else
+        snprintf (status, sizeof (status), "Stop code %d", SCPE_BARE_STATUS (r));
+sim_printf ("\nBENCHMARK: sim=%s cmd=\"%s\" status=\"%s\" insts=%.0f events=%.0f wall=%.3f cpu=%.3f ips=%.0f eps=%.0f\n",
+            sim_savename, cmd, status, insts, (double)(sim_event_count - start_events), wall, cpu,
+            (wall > 0.0) ? insts / wall : 0.0, (wall > 0.0) ? (sim_event_count - start_events) / wall : 0.0);
+return r;
+}
+
 void
 run_cmd_message (const char *unechoed_cmdline, t_stat r)
 {
@@ -8962,6 +10027,7 @@ t_stat r;
 /* reset queue */
 while (sim_clock_queue != QUEUE_LIST_END)
     sim_cancel (sim_clock_queue);
+sim_jrn_base += sim_gtime ();                           /* journal time continues */
 sim_time = sim_rtime = 0;
 noqueue_time = sim_interval = 0;
 r = reset_all (0);
@@ -9735,6 +10801,7 @@ if ((reason = parse_sym ((CONST char *)cptr, addr, uptr, sim_eval, sim_switches)
     }
 count = (1 - reason + (dptr->aincr - 1)) / dptr->aincr;
 
+_sim_mem_regions_dirty (TRUE);                          /* may be mapped anywhere */
 for (i = 0, j = addr; i < count; i++, j = j + dptr->aincr) {
     sim_eval[i] = sim_eval[i] & mask;
     if (dptr->deposit != NULL) {
@@ -10482,6 +11549,175 @@ sim_internal_devices[sim_internal_device_count] = NULL;
 return SCPE_OK;
 }
 
+/* Memory regions
+
+   sim_register_mem_region lets a simulator describe the array behind a
+   memory-like unit (see MEMREGION).  Registering the same descriptor
+   again (e.g. after the array was reallocated) just updates it.
+*/
+
+static MEMREGION **sim_mem_regions = NULL;
+static uint32 sim_mem_region_count = 0;
+
+t_stat sim_register_mem_region (MEMREGION *mr)
+{
+uint32 i;
+
+if ((mr == NULL) || (mr->dptr == NULL) || (mr->uptr == NULL) ||
+    ((mr->width != 1) && (mr->width != 2) && (mr->width != 4) && (mr->width != 8)) ||
+    (mr->addrs == 0) || ((mr->width % mr->addrs) != 0))
+    return SCPE_ARG;
+for (i = 0; i < sim_mem_region_count; i++)
+    if (sim_mem_regions[i] == mr)
+        return SCPE_OK;
+sim_mem_regions = (MEMREGION **)realloc (sim_mem_regions, (sim_mem_region_count + 1) * sizeof (*sim_mem_regions));
+sim_mem_regions[sim_mem_region_count++] = mr;
+return SCPE_OK;
+}
+
+/* Find the region usable for a unit whose values are saved sz bytes wide */
+
+static MEMREGION *_sim_find_mem_region (DEVICE *dptr, UNIT *uptr, size_t sz)
+{
+uint32 i;
+
+if (dptr->aincr != 1)
+    return NULL;
+for (i = 0; i < sim_mem_region_count; i++) {
+    MEMREGION *mr = sim_mem_regions[i];
+
+    if ((mr->dptr == dptr) && (mr->uptr == uptr) && (mr->mem != NULL) &&
+        ((mr->width / mr->addrs) <= sz))
+        return mr;
+    }
+return NULL;
+}
+
+/* Mark every tracked page changed (or unchanged after a snapshot) */
+
+static void _sim_mem_regions_dirty (t_bool dirty)
+{
+uint32 i;
+
+for (i = 0; i < sim_mem_region_count; i++) {
+    MEMREGION *mr = sim_mem_regions[i];
+
+    if (mr->dirty != NULL)
+        memset (mr->dirty, dirty ? 0xFF : 0, SIM_DIRTY_BYTES (mr->uptr->capac));
+    }
+}
+
+static t_uint64 _sim_mem_region_elem (MEMREGION *mr, t_addr e)
+{
+switch (mr->width) {
+    case 1:
+        return ((uint8 *)mr->mem)[e];
+    case 2:
+        return ((uint16 *)mr->mem)[e];
+    case 4:
+        return ((uint32 *)mr->mem)[e];
+    default:
+        return ((t_uint64 *)mr->mem)[e];
+    }
+}
+
+static void _sim_mem_region_set_elem (MEMREGION *mr, t_addr e, t_uint64 v)
+{
+switch (mr->width) {
+    case 1:
+        ((uint8 *)mr->mem)[e] = (uint8)v;
+        break;
+    case 2:
+        ((uint16 *)mr->mem)[e] = (uint16)v;
+        break;
+    case 4:
+        ((uint32 *)mr->mem)[e] = (uint32)v;
+        break;
+    default:
+        ((t_uint64 *)mr->mem)[e] = v;
+        break;
+    }
+}
+
+/* Copy cnt values starting at address k into a save buffer of sz byte
+   values; returns TRUE if they are all zero */
+
+static t_bool _sim_mem_region_get (MEMREGION *mr, t_addr k, int32 cnt, void *mbuf, size_t sz)
+{
+uint32 bits = (8 * mr->width) / mr->addrs;
+t_uint64 amask = (bits == 64) ? ~((t_uint64)0) : ((((t_uint64)1) << bits) - 1);
+t_uint64 any = 0;
+int32 l;
+
+if (mr->mask)
+    amask &= (t_uint64)mr->mask;
+if ((mr->addrs == 1) && (mr->width == 8) && (sz == sizeof (t_uint64))) {
+    t_uint64 *mp = ((t_uint64 *)mr->mem) + k;
+    t_uint64 *bp = (t_uint64 *)mbuf;
+
+    for (l = 0; l < cnt; l++)
+        any |= (bp[l] = mp[l] & amask);
+    return (any == 0);
+    }
+if ((mr->addrs == 1) && (mr->width == 4) && (sz == sizeof (uint32))) {
+    uint32 *mp = ((uint32 *)mr->mem) + k;
+    uint32 *bp = (uint32 *)mbuf;
+
+    for (l = 0; l < cnt; l++)
+        any |= (bp[l] = mp[l] & (uint32)amask);
+    return (any == 0);
+    }
+for (l = 0; l < cnt; l++, k++) {
+    t_uint64 val = _sim_mem_region_elem (mr, k / mr->addrs);
+    t_value v;
+
+    val = (val >> (bits * (mr->addrs - 1 - (k % mr->addrs)))) & amask;
+    v = (t_value)val;
+    any |= val;
+    SZ_STORE (sz, v, mbuf, l);
+    }
+return (any == 0);
+}
+
+/* Store cnt values from a restore buffer (NULL means zeros) at address k */
+
+static void _sim_mem_region_put (MEMREGION *mr, t_addr k, int32 cnt, void *mbuf, size_t sz)
+{
+uint32 bits = (8 * mr->width) / mr->addrs;
+t_uint64 amask = (bits == 64) ? ~((t_uint64)0) : ((((t_uint64)1) << bits) - 1);
+int32 l;
+
+if (mr->mask)
+    amask &= (t_uint64)mr->mask;
+if ((mr->addrs == 1) && (mbuf == NULL)) {
+    memset (((uint8 *)mr->mem) + (k * mr->width), 0, cnt * mr->width);
+    return;
+    }
+if ((mr->addrs == 1) && (mr->width == 8) && (sz == sizeof (t_uint64))) {
+    t_uint64 *mp = ((t_uint64 *)mr->mem) + k;
+    t_uint64 *bp = (t_uint64 *)mbuf;
+
+    for (l = 0; l < cnt; l++)
+        mp[l] = bp[l] & amask;
+    return;
+    }
+for (l = 0; l < cnt; l++, k++) {
+    t_addr e = k / mr->addrs;
+    uint32 shift = bits * (mr->addrs - 1 - (k % mr->addrs));
+    t_uint64 val = 0;
+    t_value v = 0;
+
+    if (mbuf != NULL) {
+        SZ_LOAD (sz, v, mbuf, l);
+        val = (t_uint64)v & amask;
+        }
+    if (mr->addrs == 1)
+        _sim_mem_region_set_elem (mr, e, val);
+    else
+        _sim_mem_region_set_elem (mr, e, (_sim_mem_region_elem (mr, e) & ~(amask << shift)) | (val << shift));
+    }
+}
+
 /* Find_dev_from_unit   find device for unit
 
    Inputs:
@@ -11446,8 +12682,17 @@ return buf;
    and to see if further events need to be processed, or sim_interval
    reset to count the next one.
 
-   The event queue is maintained in clock order; entry timeouts are
-   RELATIVE to the time in the previous entry.
+   The event queue is a hierarchical timing wheel.  Each entry holds
+   its absolute due time; the wheel has SIM_QUEUE_LVLS levels of
+   SIM_QUEUE_SLOTS slots and an entry is kept at the level of the
+   highest byte in which its due time differs from the wheel base
+   (the due time of the last event processed).  Entries due before the
+   wheel base are kept on a small ordered list, entries beyond the
+   wheel span on an unordered one.  Insertion and removal are O(1);
+   sim_clock_queue always points at the earliest entry, and entries
+   with equal due times are processed in the order they were queued.
+   The time of the earliest entry is RELATIVE to sim_queue_ref, so
+   that sim_interval keeps its historical meaning.
 
    sim_process_event - process event
 
@@ -11458,6 +12703,236 @@ return buf;
                         or 0 (SCPE_OK) if no exceptions
 */
 
+/* Event queue timing wheel helpers */
+
+static int _sim_queue_first_slot (const t_uint64 *map)
+{
+int w;
+
+for (w = 0; w < SIM_QUEUE_SLOTS / 64; w++) {
+    t_uint64 bits = map[w];
+    int bit = 0;
+
+    if (bits == 0)
+        continue;
+#if defined (__GNUC__)
+    bit = __builtin_ctzll (bits);
+#else
+    while ((bits & 1) == 0) {
+        bits >>= 1;
+        ++bit;
+        }
+#endif
+    return (w * 64) + bit;
+    }
+return -1;
+}
+
+/* Locate the list an entry with the given due time belongs on */
+
+static QSLOT *_sim_queue_slot (t_int64 due, int *lvl, int *slot)
+{
+t_uint64 diff;
+int l;
+
+*lvl = *slot = -1;
+if (due < sim_queue_base)
+    return &sim_queue_early;
+diff = ((t_uint64)due) ^ ((t_uint64)sim_queue_base);
+if (diff >> (SIM_QUEUE_LVLS * SIM_QUEUE_BITS))
+    return &sim_queue_far;
+for (l = SIM_QUEUE_LVLS - 1; l > 0; --l)
+    if (diff >> (l * SIM_QUEUE_BITS))
+        break;
+*lvl = l;
+*slot = (int)((((t_uint64)due) >> (l * SIM_QUEUE_BITS)) & (SIM_QUEUE_SLOTS - 1));
+return &sim_queue_wheel[l][*slot];
+}
+
+static void _sim_queue_link (UNIT *uptr)
+{
+int lvl, slot;
+QSLOT *qs = _sim_queue_slot (uptr->due, &lvl, &slot);
+UNIT *cptr = qs->tail;
+
+if (qs == &sim_queue_early) {                           /* early list is ordered */
+    while ((cptr != NULL) && (uptr->due < cptr->due))
+        cptr = (cptr->prev != QUEUE_LIST_END) ? cptr->prev : NULL;
+    }
+uptr->prev = (cptr != NULL) ? cptr : QUEUE_LIST_END;
+if (cptr != NULL) {                                     /* insert after cptr */
+    uptr->next = cptr->next;
+    cptr->next = uptr;
+    }
+else {                                                  /* insert at head */
+    uptr->next = (qs->head != NULL) ? qs->head : QUEUE_LIST_END;
+    qs->head = uptr;
+    }
+if (uptr->next != QUEUE_LIST_END)
+    uptr->next->prev = uptr;
+else
+    qs->tail = uptr;
+if (lvl >= 0)
+    sim_queue_map[lvl][slot >> 6] |= ((t_uint64)1) << (slot & 63);
+}
+
+static void _sim_queue_unlink (UNIT *uptr)
+{
+int lvl, slot;
+QSLOT *qs = _sim_queue_slot (uptr->due, &lvl, &slot);
+
+if (uptr->prev != QUEUE_LIST_END)
+    uptr->prev->next = uptr->next;
+else
+    qs->head = (uptr->next != QUEUE_LIST_END) ? uptr->next : NULL;
+if (uptr->next != QUEUE_LIST_END)
+    uptr->next->prev = uptr->prev;
+else
+    qs->tail = (uptr->prev != QUEUE_LIST_END) ? uptr->prev : NULL;
+uptr->next = uptr->prev = NULL;
+if ((lvl >= 0) && (qs->head == NULL))
+    sim_queue_map[lvl][slot >> 6] &= ~(((t_uint64)1) << (slot & 63));
+}
+
+/* Earliest entry on a list, first queued on ties */
+
+static UNIT *_sim_queue_min (QSLOT *qs)
+{
+UNIT *cptr, *mptr = qs->head;
+
+for (cptr = mptr; cptr != QUEUE_LIST_END; cptr = cptr->next)
+    if (cptr->due < mptr->due)
+        mptr = cptr;
+return mptr;
+}
+
+static UNIT *_sim_queue_first (void)
+{
+int lvl, slot;
+
+if (sim_queue_early.head != NULL)
+    return sim_queue_early.head;
+for (lvl = 0; lvl < SIM_QUEUE_LVLS; lvl++) {
+    if ((slot = _sim_queue_first_slot (sim_queue_map[lvl])) < 0)
+        continue;
+    if (lvl == 0)                                       /* level 0 slots share one due time */
+        return sim_queue_wheel[0][slot].head;
+    return _sim_queue_min (&sim_queue_wheel[lvl][slot]);
+    }
+if (sim_queue_far.head != NULL)
+    return _sim_queue_min (&sim_queue_far);
+return QUEUE_LIST_END;
+}
+
+/* Advance the wheel base to the due time of the earliest entry.
+
+   Since nothing is due before the new base, every level below the
+   highest byte which changed is empty and only the slot now covering
+   the base (or the far list) needs to be redistributed.  Entries are
+   relinked in list order which keeps equal due times in queue order.
+*/
+
+static void _sim_queue_advance (t_int64 base)
+{
+t_uint64 diff;
+QSLOT qs;
+int lvl, slot;
+UNIT *uptr;
+
+if (base <= sim_queue_base)
+    return;
+diff = ((t_uint64)base) ^ ((t_uint64)sim_queue_base);
+sim_queue_base = base;
+if (diff >> (SIM_QUEUE_LVLS * SIM_QUEUE_BITS)) {
+    qs = sim_queue_far;
+    sim_queue_far.head = sim_queue_far.tail = NULL;
+    }
+else {
+    for (lvl = SIM_QUEUE_LVLS - 1; lvl > 0; --lvl)
+        if (diff >> (lvl * SIM_QUEUE_BITS))
+            break;
+    if (lvl == 0)
+        return;
+    slot = (int)((((t_uint64)base) >> (lvl * SIM_QUEUE_BITS)) & (SIM_QUEUE_SLOTS - 1));
+    qs = sim_queue_wheel[lvl][slot];
+    sim_queue_wheel[lvl][slot].head = sim_queue_wheel[lvl][slot].tail = NULL;
+    sim_queue_map[lvl][slot >> 6] &= ~(((t_uint64)1) << (slot & 63));
+    }
+for (uptr = qs.head; uptr != NULL; ) {
+    UNIT *nptr = (uptr->next != QUEUE_LIST_END) ? uptr->next : NULL;
+
+    _sim_queue_link (uptr);
+    uptr = nptr;
+    }
+}
+
+/* Add an entry at sim_queue_ref + event_time, after any entry due at the same time */
+
+static void _sim_queue_insert (UNIT *uptr, int32 event_time)
+{
+uptr->due = sim_queue_ref + event_time;
+if (sim_clock_queue == QUEUE_LIST_END)                  /* empty queue? rebase wheel */
+    sim_queue_base = (uptr->due < sim_queue_ref) ? uptr->due : sim_queue_ref;
+_sim_queue_link (uptr);
+++sim_queue_count;
+if ((sim_clock_queue == QUEUE_LIST_END) || (uptr->due < sim_clock_queue->due))
+    sim_clock_queue = uptr;
+}
+
+static void _sim_queue_remove (UNIT *uptr)
+{
+_sim_queue_unlink (uptr);
+--sim_queue_count;
+if (uptr == sim_clock_queue)
+    sim_clock_queue = _sim_queue_first ();
+}
+
+/* Remove and return the earliest entry; the time of the next entry
+   becomes relative to it */
+
+static UNIT *_sim_queue_pop (void)
+{
+UNIT *uptr = sim_clock_queue;
+
+_sim_queue_unlink (uptr);
+--sim_queue_count;
+sim_queue_ref = uptr->due;
+_sim_queue_advance (uptr->due);
+sim_clock_queue = _sim_queue_first ();
+return uptr;
+}
+
+/* Queued entries in due time order (caller frees the list) */
+
+static int32 _sim_queue_list (UNIT ***list)
+{
+UNIT **ulist = (UNIT **)calloc (sim_queue_count + 1, sizeof (*ulist));
+UNIT *uptr;
+int32 cnt = 0, i, j;
+int lvl, slot;
+
+if (ulist == NULL) {
+    *list = NULL;
+    return 0;
+    }
+for (uptr = sim_queue_early.head; uptr && (uptr != QUEUE_LIST_END); uptr = uptr->next)
+    ulist[cnt++] = uptr;
+for (lvl = 0; lvl < SIM_QUEUE_LVLS; lvl++)
+    for (slot = 0; slot < SIM_QUEUE_SLOTS; slot++)
+        for (uptr = sim_queue_wheel[lvl][slot].head; uptr && (uptr != QUEUE_LIST_END); uptr = uptr->next)
+            ulist[cnt++] = uptr;
+for (uptr = sim_queue_far.head; uptr && (uptr != QUEUE_LIST_END); uptr = uptr->next)
+    ulist[cnt++] = uptr;
+for (i = 1; i < cnt; i++) {                             /* stable insertion sort */
+    uptr = ulist[i];
+    for (j = i; (j > 0) && (uptr->due < ulist[j - 1]->due); j--)
+        ulist[j] = ulist[j - 1];
+    ulist[j] = uptr;
+    }
+*list = ulist;
+return cnt;
+}
+
 t_stat sim_process_event (void)
 {
 UNIT *uptr;
@@ -11491,23 +12966,19 @@ if (sim_interval < 0) {
     UPDATE_SIM_TIME;                          /* update sim time */
     sim_debug (SIM_DBG_EVENT_NEG, &sim_scp_dev, "Processing event for %s with sim_interval = %d, event time = %.0f\n", 
         sim_uname (sim_clock_queue), sim_interval_catchup, sim_gtime ());
-    if (sim_clock_queue->next != QUEUE_LIST_END)
-        sim_debug (SIM_DBG_EVENT_NEG, &sim_scp_dev, "- Next event for %s after = %d\n", 
-            sim_uname (sim_clock_queue->next), sim_clock_queue->next->time);
-    sim_time -= sim_clock_queue->time;
-    sim_rtime -= sim_clock_queue->time;
+    sim_time -= SIM_QUEUE_HEAD_TIME;
+    sim_rtime -= SIM_QUEUE_HEAD_TIME;
     }
 else
     sim_interval_catchup = 0;
 do {
-    uptr = sim_clock_queue;                             /* get first */
-    sim_clock_queue = uptr->next;                       /* remove first */
-    uptr->next = NULL;                                  /* hygiene */
+    uptr = _sim_queue_pop ();                           /* remove first */
     uptr->time = 0;
+    ++sim_event_count;
     if (sim_clock_queue != QUEUE_LIST_END) {
         if (sim_interval_catchup < 0)
             sim_interval = -sim_interval_catchup;
-        sim_interval += sim_interval_catchup + sim_clock_queue->time;
+        sim_interval += sim_interval_catchup + SIM_QUEUE_HEAD_TIME;
         }
     else
         sim_interval = noqueue_time = NOQUEUE_WAIT;
@@ -11524,10 +12995,10 @@ do {
             reason = SCPE_OK;
         }
     AIO_EVENT_COMPLETE(uptr, reason);
-    if (sim_interval_catchup < -1) {
-        sim_interval_catchup += sim_clock_queue->time;
-        sim_time += sim_clock_queue->time;
-        sim_rtime += sim_clock_queue->time;
+    if ((sim_interval_catchup < -1) && (sim_clock_queue != QUEUE_LIST_END)) {
+        sim_interval_catchup += SIM_QUEUE_HEAD_TIME;
+        sim_time += SIM_QUEUE_HEAD_TIME;
+        sim_rtime += SIM_QUEUE_HEAD_TIME;
         }
     else
         sim_interval_catchup = 0;
@@ -11580,9 +13051,6 @@ return _sim_activate (uptr, event_time);
 
 t_stat _sim_activate (UNIT *uptr, int32 event_time)
 {
-UNIT *cptr, *prvptr;
-int32 accum;
-
 AIO_ACTIVATE (_sim_activate, uptr, event_time);
 if (sim_is_active (uptr))                               /* already active? */
     return SCPE_OK;
@@ -11590,26 +13058,8 @@ UPDATE_SIM_TIME;                                        /* update sim time */
 
 sim_debug (SIM_DBG_ACTIVATE, &sim_scp_dev, "Activating %s delay=%d\n", sim_uname (uptr), event_time);
 
-prvptr = NULL;
-accum = 0;
-for (cptr = sim_clock_queue; cptr != QUEUE_LIST_END; cptr = cptr->next) {
-    if (event_time < (accum + cptr->time))
-        break;
-    accum = accum + cptr->time;
-    prvptr = cptr;
-    }
-if (prvptr == NULL) {                                   /* insert at head */
-    cptr = uptr->next = sim_clock_queue;
-    sim_clock_queue = uptr;
-    }
-else {
-    cptr = uptr->next = prvptr->next;                   /* insert at prvptr */
-    prvptr->next = uptr;
-    }
-uptr->time = event_time - accum;
-if (cptr != QUEUE_LIST_END)
-    cptr->time = cptr->time - uptr->time;
-sim_interval = sim_clock_queue->time;
+_sim_queue_insert (uptr, event_time);
+sim_interval = SIM_QUEUE_HEAD_TIME;
 return SCPE_OK;
 }
 
@@ -11708,8 +13158,6 @@ return sim_timer_activate_after (uptr, usec_delay);
 
 t_stat sim_cancel (UNIT *uptr)
 {
-UNIT *cptr, *nptr;
-
 AIO_VALIDATE(uptr);
 if ((uptr->cancel) && uptr->cancel (uptr))
     return SCPE_OK;
@@ -11723,28 +13171,13 @@ if (!sim_is_active (uptr))
     return SCPE_OK;
 UPDATE_SIM_TIME;                                        /* update sim time */
 sim_debug (SIM_DBG_EVENT, &sim_scp_dev, "Canceling Event for %s\n", sim_uname(uptr));
-nptr = QUEUE_LIST_END;
-
-if (sim_clock_queue == uptr) {
-    nptr = sim_clock_queue = uptr->next;
-    uptr->next = NULL;                                  /* hygiene */
-    }
-else {
-    for (cptr = sim_clock_queue; cptr != QUEUE_LIST_END; cptr = cptr->next) {
-        if (cptr->next == uptr) {
-            nptr = cptr->next = uptr->next;
-            uptr->next = NULL;                          /* hygiene */
-            break;                                      /* end queue scan */
-            }
-        }
-    }
-if (nptr != QUEUE_LIST_END)
-    nptr->time += (uptr->next) ? 0 : uptr->time;
+if (uptr->prev)                                         /* on event queue? */
+    _sim_queue_remove (uptr);
 if (!uptr->next)
     uptr->time = 0;
 uptr->usecs_remaining = 0;
 if (sim_clock_queue != QUEUE_LIST_END)
-    sim_interval = sim_clock_queue->time;
+    sim_interval = SIM_QUEUE_HEAD_TIME;
 else
     sim_interval = noqueue_time = NOQUEUE_WAIT;
 if (uptr->next) {
@@ -11781,21 +13214,14 @@ return (((uptr->next) || AIO_IS_ACTIVE(uptr) || ((uptr->dynflags & UNIT_TMR_UNIT
 
 int32 _sim_activate_queue_time (UNIT *uptr)
 {
-UNIT *cptr;
 int32 accum;
 
-accum = 0;
-for (cptr = sim_clock_queue; cptr != QUEUE_LIST_END; cptr = cptr->next) {
-    if (cptr == sim_clock_queue) {
-        if (sim_interval > 0)
-            accum = accum + sim_interval;
-        }
-    else
-        accum = accum + cptr->time;
-    if (cptr == uptr)
-        return accum + 1;
-    }
-return 0;
+if ((uptr->prev == NULL) || (sim_clock_queue == QUEUE_LIST_END))
+    return 0;
+accum = (int32)(uptr->due - sim_clock_queue->due);
+if (sim_interval > 0)
+    accum = accum + sim_interval;
+return accum + 1;
 }
 
 int32 _sim_activate_time (UNIT *uptr)
@@ -11820,7 +13246,6 @@ return _sim_activate_time (uptr);
 
 double sim_activate_time_usecs (UNIT *uptr)
 {
-UNIT *cptr;
 int32 accum;
 double result;
 
@@ -11828,17 +13253,9 @@ AIO_VALIDATE(uptr);
 result = sim_timer_activate_time_usecs (uptr);
 if (result >= 0)
     return result;
-accum = 0;
-for (cptr = sim_clock_queue; cptr != QUEUE_LIST_END; cptr = cptr->next) {
-    if (cptr == sim_clock_queue) {
-        if (sim_interval > 0)
-            accum = accum + sim_interval;
-        }
-    else
-        accum = accum + cptr->time;
-    if (cptr == uptr)
-        return 1.0 + uptr->usecs_remaining + ((1000000.0 * accum) / sim_timer_inst_per_sec ());
-    }
+accum = _sim_activate_queue_time (uptr);
+if (accum)
+    return 1.0 + uptr->usecs_remaining + ((1000000.0 * (accum - 1)) / sim_timer_inst_per_sec ());
 return 0.0;
 }
 
@@ -11873,13 +13290,204 @@ return sim_rtime;
 
 int32 sim_qcount (void)
 {
-int32 cnt;
-UNIT *uptr;
+return sim_queue_count;
+}
 
-cnt = 0;
-for (uptr = sim_clock_queue; uptr != QUEUE_LIST_END; uptr = uptr->next)
-    cnt++;
-return cnt;
+/* PC sampling profiler
+
+   A simulator invokes SIM_PROFILE (pc, user) once per instruction in its
+   sim_instr loop.  When SET CPU PROFILE=n is in effect every n-th
+   invocation counts the PC and execution mode in an open addressed hash
+   table; otherwise the macro is a single test of a zero countdown.  SHOW
+   PROFILE lists the most frequently sampled locations, and SHOW PROFILE
+   <file> writes all of them as a flat profile.
+*/
+
+#define SIM_PROF_INIBITS 12                             /* initial table size */
+
+typedef struct {
+    t_addr              pc;
+    uint32              user;                           /* user (not exec) mode */
+    uint32              count;                          /* samples, 0 if unused */
+    } PROFENT;
+
+int32 sim_prof_countdown = 0;                           /* instructions to next sample */
+static int32 sim_prof_interval = 0;                     /* sample interval, 0 if off */
+static PROFENT *sim_prof_tab = NULL;                    /* samples */
+static uint32 sim_prof_bits = 0;                        /* log2 table size */
+static uint32 sim_prof_used = 0;                        /* locations sampled */
+static t_uint64 sim_prof_samples = 0;                   /* total samples */
+
+#define SIM_PROF_HASH(pc,user) ((((uint32)(pc) ^ (uint32)((pc) >> 16)) * 2654435761u + (user)) >> (32 - sim_prof_bits))
+
+static t_bool _sim_prof_alloc (uint32 bits)
+{
+PROFENT *otab = sim_prof_tab;
+uint32 i, h, osize = otab ? (1u << sim_prof_bits) : 0;
+uint32 mask = (1u << bits) - 1;
+
+sim_prof_tab = (PROFENT *)calloc ((size_t)1 << bits, sizeof (*sim_prof_tab));
+if (sim_prof_tab == NULL) {
+    sim_prof_tab = otab;
+    return FALSE;
+    }
+sim_prof_bits = bits;
+for (i = 0; i < osize; i++) {                           /* rehash old entries */
+    if (otab[i].count == 0)
+        continue;
+    for (h = SIM_PROF_HASH (otab[i].pc, otab[i].user); sim_prof_tab[h].count; h = (h + 1) & mask);
+    sim_prof_tab[h] = otab[i];
+    }
+free (otab);
+return TRUE;
+}
+
+void sim_profile_sample (t_addr pc, uint32 user)
+{
+uint32 h, mask;
+
+sim_prof_countdown = sim_prof_interval;
+user = (user != 0);
+if ((sim_prof_used >= (3u << (sim_prof_bits - 2))) &&   /* 3/4 full? */
+    (!_sim_prof_alloc (sim_prof_bits + 1)))             /* can't grow? */
+    return;                                             /* lose sample */
+mask = (1u << sim_prof_bits) - 1;
+for (h = SIM_PROF_HASH (pc, user); sim_prof_tab[h].count; h = (h + 1) & mask)
+    if ((sim_prof_tab[h].pc == pc) && (sim_prof_tab[h].user == user))
+        break;
+if (sim_prof_tab[h].count == 0) {                       /* new location? */
+    sim_prof_tab[h].pc = pc;
+    sim_prof_tab[h].user = user;
+    ++sim_prof_used;
+    }
+++sim_prof_tab[h].count;
+++sim_prof_samples;
+}
+
+/* Set/clear/show profiling, MTAB routines for the CPU */
+
+t_stat sim_set_profile (UNIT *uptr, int32 val, CONST char *cptr, void *desc)
+{
+t_stat r;
+uint32 v;
+
+if ((cptr == NULL) || (*cptr == 0))
+    return SCPE_MISVAL;
+v = (uint32) get_uint (cptr, 10, 1000000000, &r);
+if (r != SCPE_OK)
+    return sim_messagef (SCPE_ARG, "Invalid profile interval: %s\n", cptr);
+if (v == 0)
+    return sim_clr_profile (uptr, val, NULL, desc);
+free (sim_prof_tab);                                    /* start over */
+sim_prof_tab = NULL;
+sim_prof_used = 0;
+sim_prof_samples = 0;
+if (!_sim_prof_alloc (SIM_PROF_INIBITS))
+    return SCPE_MEM;
+sim_prof_interval = sim_prof_countdown = (int32)v;
+return SCPE_OK;
+}
+
+t_stat sim_clr_profile (UNIT *uptr, int32 val, CONST char *cptr, void *desc)
+{
+sim_prof_interval = sim_prof_countdown = 0;             /* keep samples for SHOW */
+return SCPE_OK;
+}
+
+t_stat sim_show_profile (FILE *st, UNIT *uptr, int32 val, CONST void *desc)
+{
+if (sim_prof_interval)
+    fprintf (st, "profile=%d\n", sim_prof_interval);
+else
+    fprintf (st, "noprofile\n");
+return SCPE_OK;
+}
+
+static int _sim_prof_compare (const void *pa, const void *pb)
+{
+const PROFENT *a = *(const PROFENT * const *)pa;
+const PROFENT *b = *(const PROFENT * const *)pb;
+
+if (a->count != b->count)
+    return (a->count < b->count) ? 1 : -1;
+if (a->pc != b->pc)
+    return (a->pc < b->pc) ? -1 : 1;
+return (int)a->user - (int)b->user;
+}
+
+/* Show profile
+
+   sh[ow] prof[ile] {n|ALL}     show the n (default 20) most sampled locations
+   sh[ow] prof[ile] file        write all locations as a flat profile
+*/
+
+t_stat show_profile (FILE *st, DEVICE *dptr, UNIT *uptr, int32 flag, CONST char *cptr)
+{
+PROFENT **list;
+char gbuf[CBUFSIZE];
+FILE *pfile = NULL;
+uint32 i, n, lines = 20;
+t_stat r;
+
+dptr = sim_dflt_dev;
+if (sim_prof_used == 0) {
+    fprintf (st, "No profile samples%s\n", sim_prof_interval ? "" : ", use SET CPU PROFILE=n to enable");
+    return SCPE_OK;
+    }
+if (cptr && (*cptr != 0)) {
+    get_glyph_nc (cptr, gbuf, 0);
+    if (sim_isdigit (*gbuf)) {
+        lines = (uint32) get_uint (gbuf, 10, 0xFFFFFFFF, &r);
+        if (r != SCPE_OK)
+            return SCPE_ARG;
+        }
+    else {
+        if (sim_strcasecmp (gbuf, "ALL") == 0)
+            lines = sim_prof_used;
+        else {
+            if ((pfile = sim_fopen (gbuf, "w")) == NULL)
+                return SCPE_OPENERR;
+            lines = sim_prof_used;
+            }
+        }
+    }
+list = (PROFENT **)malloc (sim_prof_used * sizeof (*list));
+if (list == NULL) {
+    if (pfile)
+        fclose (pfile);
+    return SCPE_MEM;
+    }
+for (i = n = 0; n < sim_prof_used; i++)
+    if (sim_prof_tab[i].count)
+        list[n++] = &sim_prof_tab[i];
+qsort (list, n, sizeof (*list), _sim_prof_compare);
+if (lines > n)
+    lines = n;
+if (pfile) {                                            /* flat profile file */
+    for (i = 0; i < lines; i++) {
+        fprintf (pfile, "%s;", list[i]->user ? "user" : "exec");
+        fprint_val (pfile, list[i]->pc, dptr->aradix, dptr->awidth, PV_RZRO);
+        fprintf (pfile, " %u\n", list[i]->count);
+        }
+    fclose (pfile);
+    fprintf (st, "%u locations written to %s\n", lines, gbuf);
+    }
+else {
+    fprintf (st, "%.0f samples%s, %u locations\n", (double)sim_prof_samples, 
+                 sim_prof_interval ? "" : " (sampling stopped)", sim_prof_used);
+    fprintf (st, "    Count      %%  Mode  Address\n");
+    for (i = 0; i < lines; i++) {
+        fprintf (st, "%9u %6.2f  %s  ", list[i]->count, 
+                     (100.0 * list[i]->count) / (double)sim_prof_samples, list[i]->user ? "User" : "Exec");
+        if (sim_vm_fprint_addr)
+            sim_vm_fprint_addr (st, dptr, list[i]->pc);
+        else
+            fprint_val (st, list[i]->pc, dptr->aradix, dptr->awidth, PV_RZRO);
+        fprintf (st, "\n");
+        }
+    }
+free (list);
+return SCPE_OK;
 }
 
 /* Breakpoint package.  This module replaces the VM-implemented one
@@ -11901,6 +13509,10 @@ return cnt;
    is the bitwise OR of all the type fields).  A simulator need only check for
    a breakpoint of type X if bit SWMASK('X') is set in sim_brk_summ.
 
+   sim_brk_hash is the same summary kept for each hash of the breakpoint
+   addresses, so sim_brk_test can reject the usual address which has no
+   breakpoint with a single table lookup instead of a search of sim_brk_tab.
+
    The package contains the following public routines:
 
         sim_brk_init            initialize
@@ -11938,6 +13550,7 @@ sim_brk_tab = (BRKTAB **) realloc (sim_brk_tab, sim_brk_lnt*sizeof (BRKTAB*));
 if (sim_brk_tab == NULL)
     return SCPE_MEM;
 memset (sim_brk_tab, 0, sim_brk_lnt*sizeof (BRKTAB*));
+memset (sim_brk_hash, 0, sizeof (sim_brk_hash));
 sim_brk_ent = sim_brk_ins = 0;
 sim_brk_clract ();
 sim_brk_npc (0);
@@ -12071,6 +13684,7 @@ if ((act != NULL) && (*act != 0)) {                     /* new action? */
     bp->act = newp;                                     /* set pointer */
     }
 sim_brk_summ = sim_brk_summ | (sw & ~BRK_TYP_TEMP);
+sim_brk_hash[SIM_BRK_HASH (loc)] |= sw;
 return SCPE_OK;
 }
 
@@ -12108,10 +13722,13 @@ if (sim_brk_tab[sim_brk_ins] == NULL) {                 /* erased entry */
         sim_brk_tab[i] = sim_brk_tab[i+1];
     }
 sim_brk_summ = 0;                                       /* recalc summary */
+sim_brk_hash[SIM_BRK_HASH (loc)] = 0;                   /* and filter entry */
 for (i = 0; i < sim_brk_ent; i++) {
     bp = sim_brk_tab[i];
     while (bp) {
         sim_brk_summ |= (bp->typ & ~BRK_TYP_TEMP);
+        if (SIM_BRK_HASH (bp->addr) == SIM_BRK_HASH (loc))
+            sim_brk_hash[SIM_BRK_HASH (loc)] |= bp->typ;
         bp = bp->next;
         }
     }
@@ -12257,6 +13874,8 @@ uint32 spc = (btyp >> SIM_BKPT_V_SPC) & (SIM_BKPT_N_SPC - 1);
 if (sim_brk_summ & BRK_TYP_DYN_ALL)
     btyp |= BRK_TYP_DYN_ALL;
 
+if ((sim_brk_hash[SIM_BRK_HASH (loc)] & btyp) == 0)     /* nothing here? */
+    return 0;
 if ((bp = sim_brk_fnd_ex (loc, btyp, TRUE, spc))) {     /* in table, and type match? */
     double s_gtime = sim_gtime ();                      /* get time now */
 
@@ -12533,16 +14152,121 @@ return sim_exp_clr (exp, gbuf);                     /* clear one rule */
 
 /* Search for an expect rule in an expect context */
 
-CONST EXPTAB *sim_exp_fnd (CONST EXPECT *exp, const char *match, int32 start_rule)
-{
-int32 i;
+CONST EXPTAB *sim_exp_fnd (CONST EXPECT *exp, const char *match, int32 start_rule)
+{
+int32 i;
+
+if (!exp->rules)
+    return NULL;
+for (i=start_rule; i<exp->size; i++)
+    if (!strcmp (exp->rules[i].match_pattern, match))
+        return &exp->rules[i];
+return NULL;
+}
+
+/* Combined literal rule matcher
+
+   All literal (non RegEx) rules are compiled into a single Aho-Corasick
+   automaton so that each output character costs one table lookup no matter
+   how many rules are active.  Each state records the lowest numbered rule
+   which ends there, preserving the first-rule-wins ordering of the rule list.
+   The automaton is rebuilt on first use after the rule list changes.
+*/
+
+static void _sim_exp_ac_free (EXPECT *exp)
+{
+free (exp->ac_next);
+exp->ac_next = NULL;
+free (exp->ac_out);
+exp->ac_out = NULL;
+exp->ac_classes = exp->ac_state = 0;
+exp->ac_regex = 0;
+exp->ac_valid = FALSE;
+}
+
+static void _sim_exp_ac_build (EXPECT *exp)
+{
+uint32 states, nstates = 1, n, s, t, c, j, head, tail;
+uint32 *fail, *queue;
+int32 i;
+
+_sim_exp_ac_free (exp);
+memset (exp->ac_class, 0, sizeof (exp->ac_class));
+exp->ac_classes = 1;                                    /* class 0 is any byte not in a rule */
+for (i=0; i<exp->size; i++) {
+    EXPTAB *ep = &exp->rules[i];
+
+    if (ep->switches & EXP_TYP_REGEX) {
+        ++exp->ac_regex;
+        continue;
+        }
+    nstates += ep->size;
+    for (j=0; j<ep->size; j++)
+        if (exp->ac_class[ep->match[j]] == 0)
+            exp->ac_class[ep->match[j]] = (uint16)exp->ac_classes++;
+    }
+exp->ac_valid = TRUE;
+if (exp->ac_regex == exp->size)                         /* No literal rules? */
+    return;
+n = exp->ac_classes;
+exp->ac_next = (uint32 *)calloc (nstates * n, sizeof (*exp->ac_next));
+exp->ac_out = (int32 *)malloc (nstates * sizeof (*exp->ac_out));
+fail = (uint32 *)calloc (nstates, sizeof (*fail));
+queue = (uint32 *)malloc (nstates * sizeof (*queue));
+if (!exp->ac_next || !exp->ac_out || !fail || !queue) {
+    free (fail);
+    free (queue);
+    _sim_exp_ac_free (exp);
+    exp->ac_valid = FALSE;
+    return;
+    }
+for (s=0; s<nstates; s++)
+    exp->ac_out[s] = -1;
+/* Build the trie of match strings (a 0 transition is no edge yet) */
+states = 1;
+for (i=0; i<exp->size; i++) {
+    EXPTAB *ep = &exp->rules[i];
+
+    if (ep->switches & EXP_TYP_REGEX)
+        continue;
+    for (j=s=0; j<ep->size; j++) {
+        uint32 *np = &exp->ac_next[s * n + exp->ac_class[ep->match[j]]];
+
+        if (*np == 0)
+            *np = states++;
+        s = *np;
+        }
+    if (exp->ac_out[s] < 0)
+        exp->ac_out[s] = i;
+    }
+/* Breadth first: compute failure links, merge outputs, fill in the missing transitions */
+head = tail = 0;
+for (c=0; c<n; c++)
+    if (exp->ac_next[c])
+        queue[tail++] = exp->ac_next[c];
+while (head < tail) {
+    s = queue[head++];
+    if ((exp->ac_out[fail[s]] >= 0) && 
+        ((exp->ac_out[s] < 0) || (exp->ac_out[fail[s]] < exp->ac_out[s])))
+        exp->ac_out[s] = exp->ac_out[fail[s]];
+    for (c=0; c<n; c++) {
+        t = exp->ac_next[s * n + c];
+        if (t) {
+            fail[t] = exp->ac_next[fail[s] * n + c];
+            queue[tail++] = t;
+            }
+        else
+            exp->ac_next[s * n + c] = exp->ac_next[fail[s] * n + c];
+        }
+    }
+free (fail);
+free (queue);
+/* Catch up with the data already in the buffer so partial matches survive rule changes */
+for (j=0; j<exp->buf_data; j++) {
+    uint32 off = (exp->buf_ins + exp->buf_size - exp->buf_data + j) % exp->buf_size;
 
-if (!exp->rules)
-    return NULL;
-for (i=start_rule; i<exp->size; i++)
-    if (!strcmp (exp->rules[i].match_pattern, match))
-        return &exp->rules[i];
-return NULL;
+    exp->ac_state = exp->ac_next[exp->ac_state * n + exp->ac_class[exp->buf[off]]];
+    }
 }
 
 /* Clear (delete) an expect rule */
@@ -12553,6 +14277,7 @@ int32 i;
 
 if (!ep)                                                /* not there? ok */
     return SCPE_OK;
+_sim_exp_ac_free (exp);                                 /* rule list changing */
 free (ep->match);                                       /* deallocate match string */
 free (ep->match_pattern);                               /* deallocate the display format match string */
 free (ep->act);                                         /* deallocate action */
@@ -12599,6 +14324,7 @@ for (i=0; i<exp->size; i++) {
 free (exp->rules);
 exp->rules = NULL;
 exp->size = 0;
+_sim_exp_ac_free (exp);
 free (exp->buf);
 exp->buf = NULL;
 exp->buf_size = 0;
@@ -12661,6 +14387,7 @@ for (i=0; i<exp->size; i++) {                           /* Make sure this rule w
     }
 if (after && exp->size)
     return sim_messagef (SCPE_ARG, "Multiple concurrent EXPECT rules aren't valid when a HALTAFTER parameter is non-zero\n");
+_sim_exp_ac_free (exp);                                 /* rule list changing */
 exp->rules = (EXPTAB *) realloc (exp->rules, sizeof (*exp->rules)*(exp->size + 1));
 ep = &exp->rules[exp->size];
 exp->size += 1;
@@ -12803,7 +14530,7 @@ return SCPE_OK;
 
 t_stat sim_exp_check (EXPECT *exp, uint8 data)
 {
-int32 i;
+int32 i, limit, literal = -1;
 EXPTAB *ep = NULL;
 int regex_checks = 0;
 char *tstr = NULL;
@@ -12811,12 +14538,25 @@ char *tstr = NULL;
 if ((!exp) || (!exp->rules))                            /* Anying to check? */
     return SCPE_OK;
 
+if (!exp->ac_valid)                                     /* Rules changed? */
+    _sim_exp_ac_build (exp);                            /* Recompile literal rules */
 exp->buf[exp->buf_ins++] = data;                        /* Save new data */
 exp->buf[exp->buf_ins] = '\0';                          /* Nul terminate for RegEx match */
 if (exp->buf_data < exp->buf_size)
     ++exp->buf_data;                                    /* Record amount of data in buffer */
 
-for (i=0; i < exp->size; i++) {
+limit = exp->size;
+if (exp->ac_next) {                                     /* Literal rules in the automaton? */
+    exp->ac_state = exp->ac_next[exp->ac_state * exp->ac_classes + exp->ac_class[data]];
+    literal = exp->ac_out[exp->ac_state];
+    if (literal >= 0) {
+        sim_debug (exp->dbit, exp->dptr, "Literal Match Rule %d: %s\n", literal, exp->rules[literal].match_pattern);
+        limit = literal;                                /* Only earlier RegEx rules can take precedence */
+        }
+    if (exp->ac_regex == 0)                             /* No RegEx rules? */
+        limit = 0;                                      /* Nothing else to check */
+    }
+for (i=0; i < limit; i++) {
     ep = &exp->rules[i];
     if (ep->switches & EXP_TYP_REGEX) {
 #if defined (USE_REGEX)
@@ -12876,6 +14616,8 @@ for (i=0; i < exp->size; i++) {
 #endif
         }
     else {
+        if (exp->ac_next)                                       /* Matched by the automaton? */
+            continue;                                           /* Yes, Try next one. */
         if (exp->buf_data < ep->size)                           /* Too little data to match yet? */
             continue;                                           /* Yes, Try next one. */
         if (exp->buf_ins < ep->size) {                          /* Match might stradle end of buffer */
@@ -12925,6 +14667,11 @@ for (i=0; i < exp->size; i++) {
             }
         }
     }
+if (i == limit) {                                       /* No earlier rule matched? */
+    i = (literal >= 0) ? literal : exp->size;
+    if (literal >= 0)
+        ep = &exp->rules[literal];
+    }
 if (exp->buf_ins == exp->buf_size) {                    /* At end of match buffer? */
     if (regex_checks) {
         /* When processing regular expressions, let the match buffer fill 
@@ -12974,6 +14721,7 @@ if (i != exp->size) {                                   /* Found? */
         }
     /* Matched data is no longer available for future matching */
     exp->buf_data = exp->buf_ins = 0;
+    exp->ac_state = 0;
     }
 free (tstr);
 return SCPE_OK;
@@ -13269,6 +15017,8 @@ char saved_debug_filename[CBUFSIZE];
 if (sim_deb == NULL)                                    /* no debug? */
     return SCPE_OK;
 
+if (!sim_is_running)                                    /* stopped? */
+    _sim_debug_trace_dump ();                           /* format any trace */
 _sim_debug_write_flush ("", 0, TRUE);
 
 if (sim_deb == sim_log) {                               /* debug is log */
@@ -13276,7 +15026,9 @@ if (sim_deb == sim_log) {                               /* debug is log */
     return SCPE_OK;
     }
 
-if (!(saved_deb_switches & SWMASK ('B'))) {
+if (saved_deb_switches & SWMASK ('K'))                  /* binary trace? */
+    fflush (sim_deb);                                   /* can't reopen */
+else if (!(saved_deb_switches & SWMASK ('B'))) {
     strcpy (saved_debug_filename, sim_logfile_name (sim_deb, sim_deb_ref));
 
     sim_quiet = 1;
@@ -13319,16 +15071,15 @@ return some_match ? some_match : debtab_nomatch;
 
 /* Prints standard debug prefix unless previous call unterminated */
 
-static const char *sim_debug_prefix (uint32 dbits, DEVICE* dptr, UNIT* uptr)
+static const char *_sim_debug_prefix_at (const char *debug_type, DEVICE *dptr, double gtime, t_value val, const struct timespec *when, t_bool main_thread)
 {
-const char* debug_type = _get_dbg_verb (dbits, dptr, uptr);
 char tim_t[32] = "";
 char tim_a[32] = "";
 char pc_s[64] = "";
 struct timespec time_now;
 
 if (sim_deb_switches & (SWMASK ('T') | SWMASK ('R') | SWMASK ('A'))) {
-    sim_rtcn_get_time(&time_now, 0);
+    time_now = *when;
     if (sim_deb_switches & SWMASK ('R'))
         sim_timespec_diff (&time_now, &time_now, &sim_deb_basetime);
     if (sim_deb_switches & SWMASK ('T')) {
@@ -13342,8 +15093,21 @@ if (sim_deb_switches & (SWMASK ('T') | SWMASK ('R') | SWMASK ('A'))) {
         }
     }
 if (sim_deb_switches & SWMASK ('P')) {
-    t_value val;
-    
+    sprintf(pc_s, "-%s:", sim_PC->name);
+    sprint_val (&pc_s[strlen(pc_s)], val, sim_PC->radix, sim_PC->width, sim_PC->flags & REG_FMT);
+    }
+sprintf(debug_line_prefix, "DBG(%s%s%.0f%s)%s> %s %s: ", tim_t, tim_a, gtime, pc_s, main_thread ? "" : "+", dptr->name, debug_type);
+return debug_line_prefix;
+}
+
+static const char *sim_debug_prefix (uint32 dbits, DEVICE* dptr, UNIT* uptr)
+{
+t_value val = 0;
+struct timespec time_now;
+
+if (sim_deb_switches & (SWMASK ('T') | SWMASK ('R') | SWMASK ('A')))
+    sim_rtcn_get_time(&time_now, 0);
+if (sim_deb_switches & SWMASK ('P')) {
     /* Some simulators expose the PC as a register, some don't expose it or expose a register 
        which is not a variable which is updated during instruction execution (i.e. only upon
        exit of sim_instr()).  For the -P debug option to be effective, such a simulator should
@@ -13354,11 +15118,8 @@ if (sim_deb_switches & SWMASK ('P')) {
         val = (*sim_vm_pc_value)();
     else
         val = get_rval (sim_PC, 0);
-    sprintf(pc_s, "-%s:", sim_PC->name);
-    sprint_val (&pc_s[strlen(pc_s)], val, sim_PC->radix, sim_PC->width, sim_PC->flags & REG_FMT);
     }
-sprintf(debug_line_prefix, "DBG(%s%s%.0f%s)%s> %s %s: ", tim_t, tim_a, sim_gtime(), pc_s, AIO_MAIN_THREAD ? "" : "+", dptr->name, debug_type);
-return debug_line_prefix;
+return _sim_debug_prefix_at (_get_dbg_verb (dbits, dptr, uptr), dptr, sim_gtime(), val, &time_now, AIO_MAIN_THREAD);
 }
 
 void fprint_fields (FILE *stream, t_value before, t_value after, BITFIELD* bitdefs)
@@ -13413,6 +15174,7 @@ if (sim_deb && dptr && (dptr->dctrl & dbits)) {
     TMLN *saved_oline = sim_oline;
 
     sim_oline = NULL;                                                   /* avoid potential debug to active socket */
+    _sim_debug_trace_sync ();                                           /* keep output in order */
     if (!debug_unterm)
         fprintf(sim_deb, "%s", sim_debug_prefix(dbits, dptr, NULL));    /* print prefix if required */
     if (header)
@@ -13481,8 +15243,10 @@ else
     fprintf (stdout, "%s", buf);
 if ((!sim_oline) && (sim_log && (sim_log != stdout)))
     fprintf (sim_log, "%s", buf);
-if (sim_deb && (sim_deb != stdout) && (sim_deb != sim_log))
+if (sim_deb && (sim_deb != stdout) && (sim_deb != sim_log)) {
+    _sim_debug_trace_sync ();
     _sim_debug_write (buf, strlen (buf));
+    }
 
 if (buf != stackbuf)
     free (buf);
@@ -13572,6 +15336,7 @@ if (sim_deb && (((sim_deb != stdout) && (sim_deb != sim_log)) || inhibit_message
     TMLN *saved_oline = sim_oline;
 
     sim_oline = NULL;                           /* avoid potential debug to active socket */
+    _sim_debug_trace_sync ();
     fprintf (sim_deb, "%s", buf);
     sim_oline = saved_oline;                    /* restore original socket */
     }
@@ -13581,6 +15346,447 @@ if (buf != stackbuf)
 return stat | ((stat != SCPE_OK) ? SCPE_NOMESSAGE : 0);
 }
 
+/* Output formatted debug data expanding newlines where they exist */
+
+static void _sim_debug_emit (const char *debug_prefix, const char *buf, int32 len)
+{
+int32 i, j;
+
+for (i = j = 0; i < len; ++i) {
+    if ('\n' == buf[i]) {
+        if (i >= j) {
+            if ((i != j) || (i == 0)) {
+                if (!debug_unterm)                      /* print prefix when required */
+                    _sim_debug_write (debug_prefix, strlen (debug_prefix));
+                _sim_debug_write (&buf[j], i-j);
+                _sim_debug_write ("\r\n", 2);
+                }
+            debug_unterm = 0;
+            }
+        j = i + 1;
+        }
+    else {
+        if (buf[i] == 0) {          /* Imbedded \0 character in formatted result? */
+            fprintf (stderr, "sim_debug() formatted result: '%s'\r\n"
+                             "            has an imbedded \\0 character.\r\n"
+                             "DON'T DO THAT!\r\n", buf);
+            abort();
+            }
+        }
+    }
+if (i > j) {
+    if (!debug_unterm)                              /* print prefix when required */
+        _sim_debug_write (debug_prefix, strlen (debug_prefix));
+    _sim_debug_write (&buf[j], i-j);
+    }
+
+/* Set unterminated flag for next time */
+
+debug_unterm = len ? (((buf[len-1]=='\n')) ? 0 : 1) : debug_unterm;
+}
+
+/* Binary debug trace (SET DEBUG -K)
+
+   Rather than being formatted when they are generated, the debug messages
+   of the simulation thread are kept as records of the simulated time, the
+   device, the debug bits, the format and the raw argument values in a
+   circular table.  Formatting is done when the table is written to the
+   debug destination, which happens when the simulator stops and at SET
+   NODEBUG, so that tracing costs little more than a copy of the arguments
+   while instructions are executing and the most recent history remains
+   available after a failure.  Strings are copied into the record since
+   callers often pass transient buffers.  Messages with formats which
+   can't be kept this way are formatted immediately into the record, and
+   messages from other threads are written directly as usual.  Messages
+   too long for a record and debug output which doesn't go through
+   sim_debug (sim_debug_bits, sim_printf, Fprintf to sim_deb) are written
+   directly after the recorded messages, so the trace stays in order.
+*/
+
+#define DT_ARGS         8                               /* args per record */
+#define DT_TEXT         96                              /* string space per record */
+
+#define DT_LNT_NONE     0                               /* printf length modifiers */
+#define DT_LNT_HH       1
+#define DT_LNT_H        2
+#define DT_LNT_L        3
+#define DT_LNT_LL       4
+#define DT_LNT_Z        5
+#define DT_LNT_LD       6
+
+typedef struct {
+    double              gtime;                          /* simulated time */
+    struct timespec     now;                            /* time of day (-T, -A) */
+    t_value             pc;                             /* PC (-P) */
+    DEVICE              *dptr;
+    UNIT                *uptr;
+    const char          *fmt;                           /* format, NULL if formatted */
+    uint32              dbits;
+    union {
+        t_int64         i;                              /* integer or string offset */
+        double          d;
+        const void      *p;
+        }               arg[DT_ARGS];
+    char                text[DT_TEXT];                  /* string args or message */
+    } DEBTRACE;
+
+static DEBTRACE *sim_deb_trace = NULL;                  /* trace records */
+size_t sim_deb_trace_size = 0;                          /* trace record count */
+size_t sim_deb_trace_inuse = 0;                         /* records holding messages */
+static size_t sim_deb_trace_next = 0;                   /* next record to fill */
+
+/* Complete the record being filled, or give it up.  A full table's next
+   record held the oldest message, which has been partly overwritten. */
+
+static t_bool _sim_debug_trace_take (void)
+{
+if (++sim_deb_trace_next == sim_deb_trace_size)
+    sim_deb_trace_next = 0;
+if (sim_deb_trace_inuse < sim_deb_trace_size)
+    ++sim_deb_trace_inuse;
+return TRUE;
+}
+
+static t_bool _sim_debug_trace_drop (void)
+{
+if (sim_deb_trace_inuse == sim_deb_trace_size)
+    --sim_deb_trace_inuse;
+return FALSE;
+}
+
+/* Parse the conversion specification following a % in a format.  The
+   specification without its length modifier and conversion character
+   is copied to spec.  Returns a pointer to the conversion character or
+   NULL if the specification is too long. */
+
+static const char *_sim_debug_trace_conv (const char *fmt, char *spec, size_t size, int32 *lnt, int32 *stars, int32 *prec)
+{
+size_t n = 0;
+
+spec[n++] = '%';
+*stars = 0;
+*prec = -1;
+while ((*fmt != 0) && (strchr ("-+ #0", *fmt) != NULL) && (n < size - 1))
+    spec[n++] = *fmt++;
+if (*fmt == '*') {
+    ++*stars;
+    spec[n++] = *fmt++;
+    }
+else
+    while (sim_isdigit (*fmt) && (n < size - 1))
+        spec[n++] = *fmt++;
+if ((*fmt == '.') && (n < size - 1)) {
+    spec[n++] = *fmt++;
+    if (*fmt == '*') {
+        *prec = -2;                                     /* from the args */
+        ++*stars;
+        spec[n++] = *fmt++;
+        }
+    else {
+        *prec = 0;
+        while (sim_isdigit (*fmt) && (n < size - 1)) {
+            *prec = (*prec * 10) + (*fmt - '0');
+            spec[n++] = *fmt++;
+            }
+        }
+    }
+if (n >= size - 1)                                      /* too long? */
+    return NULL;
+spec[n] = '\0';
+*lnt = DT_LNT_NONE;
+switch (*fmt) {
+    case 'h':
+        *lnt = (fmt[1] == 'h') ? DT_LNT_HH : DT_LNT_H;
+        fmt += (fmt[1] == 'h') ? 2 : 1;
+        break;
+    case 'l':
+        *lnt = (fmt[1] == 'l') ? DT_LNT_LL : DT_LNT_L;
+        fmt += (fmt[1] == 'l') ? 2 : 1;
+        break;
+    case 'q':
+    case 'j':
+        *lnt = DT_LNT_LL;
+        ++fmt;
+        break;
+    case 'z':
+    case 't':
+        *lnt = DT_LNT_Z;
+        ++fmt;
+        break;
+    case 'L':
+        *lnt = DT_LNT_LD;
+        ++fmt;
+        break;
+    case 'I':                                           /* Microsoft sizes */
+        if ((fmt[1] == '6') && (fmt[2] == '4')) {
+            *lnt = DT_LNT_LL;
+            fmt += 3;
+            }
+        else
+            if ((fmt[1] == '3') && (fmt[2] == '2'))
+                fmt += 3;
+            else {
+                *lnt = DT_LNT_Z;
+                ++fmt;
+                }
+        break;
+        }
+return fmt;
+}
+
+/* Record a debug message, returns FALSE if it doesn't fit in a record.
+   The argument list has then been used and the message is not recorded. */
+
+static t_bool _sim_debug_trace_record (uint32 dbits, DEVICE *dptr, UNIT *uptr, const char *fmt, va_list arglist)
+{
+DEBTRACE *rec = &sim_deb_trace[sim_deb_trace_next];
+const char *cp;
+char spec[32];
+int32 lnt, stars, prec, nargs = 0;
+size_t textoff = 0;
+t_bool keep = TRUE;
+
+rec->gtime = sim_gtime ();
+if (sim_deb_switches & (SWMASK ('T') | SWMASK ('R') | SWMASK ('A')))
+    sim_rtcn_get_time (&rec->now, 0);
+if (sim_deb_switches & SWMASK ('P'))
+    rec->pc = sim_vm_pc_value ? (*sim_vm_pc_value)() : get_rval (sim_PC, 0);
+rec->dptr = dptr;
+rec->uptr = uptr;
+rec->dbits = dbits & (dptr->dctrl | (uptr ? uptr->dctrl : 0));
+cp = fmt;
+while (keep && (cp = strchr (cp, '%'))) {               /* check the format */
+    cp = _sim_debug_trace_conv (cp + 1, spec, sizeof (spec), &lnt, &stars, &prec);
+    if ((cp == NULL) || (*cp == 0) || (strchr ("%diouxXcsp" "eEfFgGaA", *cp) == NULL))
+        keep = FALSE;
+    else {
+        if (*cp != '%')
+            nargs += stars + 1;
+        ++cp;
+        }
+    }
+if ((!keep) || (nargs > DT_ARGS)) {                     /* can't keep the args? */
+    rec->fmt = NULL;
+#if defined(NO_vsnprintf)
+    strlcpy (rec->text, fmt, sizeof (rec->text));
+#else
+    if (vsnprintf (rec->text, sizeof (rec->text), fmt, arglist) >= (int)sizeof (rec->text))
+        return _sim_debug_trace_drop ();
+#endif
+    return _sim_debug_trace_take ();
+    }
+rec->fmt = fmt;
+for (nargs = 0, cp = fmt; (cp = strchr (cp, '%')); ++cp) {
+    int32 s;
+
+    cp = _sim_debug_trace_conv (cp + 1, spec, sizeof (spec), &lnt, &stars, &prec);
+    if (*cp == '%')
+        continue;
+    for (s = 0; s < stars; s++) {                       /* width, precision */
+        rec->arg[nargs++].i = va_arg (arglist, int);
+        if ((prec == -2) && (s == stars - 1))
+            prec = (int32)rec->arg[nargs - 1].i;
+        }
+    switch (*cp) {
+        case 'd': case 'i':
+            switch (lnt) {
+                case DT_LNT_HH:
+                    rec->arg[nargs].i = (signed char)va_arg (arglist, int);
+                    break;
+                case DT_LNT_H:
+                    rec->arg[nargs].i = (short)va_arg (arglist, int);
+                    break;
+                case DT_LNT_L:
+                    rec->arg[nargs].i = va_arg (arglist, long);
+                    break;
+                case DT_LNT_LL:
+                    rec->arg[nargs].i = va_arg (arglist, t_int64);
+                    break;
+                case DT_LNT_Z:
+                    rec->arg[nargs].i = (t_int64)va_arg (arglist, size_t);
+                    break;
+                default:
+                    rec->arg[nargs].i = va_arg (arglist, int);
+                    break;
+                }
+            break;
+        case 'o': case 'u': case 'x': case 'X':
+            switch (lnt) {
+                case DT_LNT_HH:
+                    rec->arg[nargs].i = (unsigned char)va_arg (arglist, int);
+                    break;
+                case DT_LNT_H:
+                    rec->arg[nargs].i = (unsigned short)va_arg (arglist, int);
+                    break;
+                case DT_LNT_L:
+                    rec->arg[nargs].i = (t_int64)va_arg (arglist, unsigned long);
+                    break;
+                case DT_LNT_LL:
+                    rec->arg[nargs].i = (t_int64)va_arg (arglist, t_uint64);
+                    break;
+                case DT_LNT_Z:
+                    rec->arg[nargs].i = (t_int64)va_arg (arglist, size_t);
+                    break;
+                default:
+                    rec->arg[nargs].i = va_arg (arglist, unsigned int);
+                    break;
+                }
+            break;
+        case 'c':
+            rec->arg[nargs].i = va_arg (arglist, int);
+            break;
+        case 's': {
+            const char *str = va_arg (arglist, const char *);
+            size_t len;
+
+            if (str == NULL)
+                str = "(null)";
+            if (prec >= 0)
+                for (len = 0; (len < (size_t)prec) && (str[len] != 0); len++);
+            else
+                len = strlen (str);
+            if (textoff + len >= sizeof (rec->text))    /* doesn't fit? */
+                return _sim_debug_trace_drop ();
+            memcpy (&rec->text[textoff], str, len);
+            rec->text[textoff + len] = '\0';
+            rec->arg[nargs].i = (t_int64)textoff;
+            textoff += len + 1;
+            }
+            break;
+        case 'p':
+            rec->arg[nargs].p = va_arg (arglist, void *);
+            break;
+        default:                                        /* floating */
+            if (lnt == DT_LNT_LD)
+                rec->arg[nargs].d = (double)va_arg (arglist, long double);
+            else
+                rec->arg[nargs].d = va_arg (arglist, double);
+            break;
+        }
+    ++nargs;
+    }
+return _sim_debug_trace_take ();
+}
+
+/* Format a recorded message into buf, returning its length */
+
+static size_t _sim_debug_trace_format (const DEBTRACE *rec, char *buf, size_t size)
+{
+const char *cp, *fmt = rec->fmt;
+char spec[40], piece[CBUFSIZE];
+int32 lnt, stars, prec, nargs = 0;
+size_t len = 0;
+
+if (fmt == NULL)                                        /* already formatted? */
+    return strlcpy (buf, rec->text, size);
+buf[0] = '\0';
+while ((cp = strchr (fmt, '%'))) {
+    int sa[2] = {0, 0};
+    int32 s, plen;
+
+    if ((size_t)(cp - fmt) < size - len) {              /* literal text */
+        memcpy (&buf[len], fmt, cp - fmt);
+        len += cp - fmt;
+        buf[len] = '\0';
+        }
+    cp = _sim_debug_trace_conv (cp + 1, spec, sizeof (spec) - 4, &lnt, &stars, &prec);
+    fmt = cp + 1;
+    if (*cp == '%') {
+        strlcpy (piece, "%", sizeof (piece));
+        plen = 1;
+        }
+    else {
+        for (s = 0; s < stars; s++)
+            sa[s] = (int)rec->arg[nargs++].i;
+#define DT_PRINT(val) ((stars == 0) ? snprintf (piece, sizeof (piece), spec, val) : \
+                       (stars == 1) ? snprintf (piece, sizeof (piece), spec, sa[0], val) : \
+                                      snprintf (piece, sizeof (piece), spec, sa[0], sa[1], val))
+        switch (*cp) {
+            case 'd': case 'i': case 'o': case 'u': case 'x': case 'X':
+                strlcat (spec, LL_FMT, sizeof (spec));
+                strncat (spec, cp, 1);
+                plen = DT_PRINT ((LL_TYPE)rec->arg[nargs].i);
+                break;
+            case 'c':
+                strlcat (spec, "c", sizeof (spec));
+                plen = DT_PRINT ((int)rec->arg[nargs].i);
+                break;
+            case 's':
+                strlcat (spec, "s", sizeof (spec));
+                plen = DT_PRINT (&rec->text[rec->arg[nargs].i]);
+                break;
+            case 'p':
+                strlcat (spec, "p", sizeof (spec));
+                plen = DT_PRINT (rec->arg[nargs].p);
+                break;
+            default:
+                strncat (spec, cp, 1);
+                plen = DT_PRINT (rec->arg[nargs].d);
+                break;
+            }
+#undef DT_PRINT
+        ++nargs;
+        }
+    if ((plen < 0) || ((size_t)plen >= sizeof (piece)))
+        plen = (int32)strlen (piece);
+    if ((size_t)plen < size - len) {
+        memcpy (&buf[len], piece, plen);
+        len += plen;
+        buf[len] = '\0';
+        }
+    }
+return len + strlcpy (&buf[len], fmt, size - len);
+}
+
+/* Write out and discard the recorded messages */
+
+static void _sim_debug_trace_dump (void)
+{
+size_t i = (sim_deb_trace_next + sim_deb_trace_size - sim_deb_trace_inuse) % MAX (sim_deb_trace_size, 1);
+char buf[4*CBUFSIZE];
+
+if ((sim_deb == NULL) || (sim_deb_trace_inuse == 0))
+    return;
+while (sim_deb_trace_inuse > 0) {
+    DEBTRACE *rec = &sim_deb_trace[i];
+    size_t len = _sim_debug_trace_format (rec, buf, sizeof (buf));
+
+    if (len >= sizeof (buf))
+        len = strlen (buf);
+    _sim_debug_emit (_sim_debug_prefix_at (_get_dbg_verb (rec->dbits, rec->dptr, rec->uptr), rec->dptr, rec->gtime, rec->pc, &rec->now, TRUE), buf, (int32)len);
+    if (++i == sim_deb_trace_size)
+        i = 0;
+    --sim_deb_trace_inuse;
+    }
+_sim_debug_write_flush ("", 0, TRUE);
+}
+
+/* Write out the recorded messages ahead of debug output which is
+   written directly by the simulation thread */
+
+static void _sim_debug_trace_sync (void)
+{
+if (sim_deb_trace_inuse && AIO_MAIN_THREAD)
+    _sim_debug_trace_dump ();
+}
+
+/* Set the size of the trace, 0 writes it out and stops tracing */
+
+t_stat sim_debug_trace_set (size_t records)
+{
+_sim_debug_trace_dump ();
+free (sim_deb_trace);
+sim_deb_trace = NULL;
+sim_deb_trace_size = sim_deb_trace_next = sim_deb_trace_inuse = 0;
+if (records == 0)
+    return SCPE_OK;
+sim_deb_trace = (DEBTRACE *)calloc (records, sizeof (*sim_deb_trace));
+if (sim_deb_trace == NULL)
+    return SCPE_MEM;
+sim_deb_trace_size = records;
+return SCPE_OK;
+}
+
 /* Inline debugging - will print debug message if debug file is
    set and the bitmask matches the current device debug options.
    Extra returns are added for un*x systems, since the output
@@ -13588,17 +15794,26 @@ return stat | ((stat != SCPE_OK) ? SCPE_NOMESSAGE : 0);
    and the extra returns don't hurt any other systems. 
    Callers should be calling sim_debug() which is a macro
    defined in scp.h which evaluates the action condition before 
-   incurring call overhead. */
-static void _sim_vdebug (uint32 dbits, DEVICE* dptr, UNIT *uptr, const char* fmt, va_list arglist)
+   incurring call overhead.  Returns FALSE when a binary trace record
+   can't hold the message; the caller then passes its arguments again
+   with trace FALSE to write the message directly. */
+static t_bool _sim_vdebug (uint32 dbits, DEVICE* dptr, UNIT *uptr, t_bool trace, const char* fmt, va_list arglist)
 {
 if (sim_deb && dptr && ((dptr->dctrl | (uptr ? uptr->dctrl : 0)) & dbits)) {
-    TMLN *saved_oline = sim_oline;
+    TMLN *saved_oline;
     char stackbuf[STACKBUFSIZE];
     int32 bufsize = sizeof(stackbuf);
     char *buf = stackbuf;
-    int32 i, j, len;
-    const char* debug_prefix = sim_debug_prefix(dbits, dptr, uptr);   /* prefix to print if required */
+    int32 len;
+    const char* debug_prefix;
 
+    if (sim_deb_trace && AIO_MAIN_THREAD) {             /* binary trace? */
+        if (trace)
+            return _sim_debug_trace_record (dbits, dptr, uptr, fmt, arglist);
+        _sim_debug_trace_dump ();                       /* written after the trace */
+        }
+    saved_oline = sim_oline;
+    debug_prefix = sim_debug_prefix(dbits, dptr, uptr); /* prefix to print if required */
     sim_oline = NULL;                                   /* avoid potential debug to active socket */
     buf[bufsize-1] = '\0';
 
@@ -13619,50 +15834,19 @@ if (sim_deb && dptr && ((dptr->dctrl | (uptr ? uptr->dctrl : 0)) & dbits)) {
                 bufsize = len + 2;
             buf = (char *) malloc (bufsize);
             if (buf == NULL)                            /* out of memory */
-                return;
+                return TRUE;
             buf[bufsize-1] = '\0';
             continue;
             }
         break;
         }
 
-/* Output the formatted data expanding newlines where they exist */
-
-    for (i = j = 0; i < len; ++i) {
-        if ('\n' == buf[i]) {
-            if (i >= j) {
-                if ((i != j) || (i == 0)) {
-                    if (!debug_unterm)                  /* print prefix when required */
-                        _sim_debug_write (debug_prefix, strlen (debug_prefix));
-                    _sim_debug_write (&buf[j], i-j);
-                    _sim_debug_write ("\r\n", 2);
-                    }
-                debug_unterm = 0;
-                }
-            j = i + 1;
-            }
-        else {
-            if (buf[i] == 0) {      /* Imbedded \0 character in formatted result? */
-                fprintf (stderr, "sim_debug() formatted result: '%s'\r\n"
-                                 "            has an imbedded \\0 character.\r\n"
-                                 "DON'T DO THAT!\r\n", buf);
-                abort();
-                }
-            }
-        }
-    if (i > j) {
-        if (!debug_unterm)                          /* print prefix when required */
-            _sim_debug_write (debug_prefix, strlen (debug_prefix));
-        _sim_debug_write (&buf[j], i-j);
-        }
-
-/* Set unterminated flag for next time */
-
-    debug_unterm = len ? (((buf[len-1]=='\n')) ? 0 : 1) : debug_unterm;
+    _sim_debug_emit (debug_prefix, buf, len);
     if (buf != stackbuf)
         free (buf);
     sim_oline = saved_oline;                            /* restore original socket */
     }
+return TRUE;
 }
 
 void _sim_debug_unit (uint32 dbits, UNIT *uptr, const char* fmt, ...)
@@ -13672,7 +15856,11 @@ DEVICE *dptr = (uptr ? uptr->dptr : NULL);
 if (sim_deb && (((dptr ? dptr->dctrl : 0) | (uptr ? uptr->dctrl : 0)) & dbits)) {
     va_list arglist;
     va_start (arglist, fmt);
-    _sim_vdebug (dbits, dptr, uptr, fmt, arglist);
+    if (!_sim_vdebug (dbits, dptr, uptr, TRUE, fmt, arglist)) {
+        va_end (arglist);                               /* too long to trace */
+        va_start (arglist, fmt);
+        _sim_vdebug (dbits, dptr, uptr, FALSE, fmt, arglist);
+        }
     va_end (arglist);
     }
 }
@@ -13682,7 +15870,11 @@ void _sim_debug_device (uint32 dbits, DEVICE* dptr, const char* fmt, ...)
 if (sim_deb && dptr && (dptr->dctrl & dbits)) {
     va_list arglist;
     va_start (arglist, fmt);
-    _sim_vdebug (dbits, dptr, NULL, fmt, arglist);
+    if (!_sim_vdebug (dbits, dptr, NULL, TRUE, fmt, arglist)) {
+        va_end (arglist);                               /* too long to trace */
+        va_start (arglist, fmt);
+        _sim_vdebug (dbits, dptr, NULL, FALSE, fmt, arglist);
+        }
     va_end (arglist);
     }
 }
@@ -13849,6 +16041,7 @@ if (sim_mfile || (sim_deb && (f == sim_deb))) {
         sim_mfile->pos += len;
         }
     else {
+        _sim_debug_trace_sync ();
         _sim_debug_write (buf, len);
         }
 
@@ -15917,6 +18110,325 @@ sim_set_deb_switches (start_deb_switches);
 return r;
 }
 
+#define QTEST_UNITS 40
+static UNIT qtest_units[QTEST_UNITS];
+static int32 qtest_fired[QTEST_UNITS];
+static int32 qtest_count;
+
+static t_stat sim_scp_qtest_svc (UNIT *uptr)
+{
+qtest_fired[qtest_count++] = (int32)(uptr - qtest_units);
+return SCPE_OK;
+}
+
+/* Event queue ordering across all timing wheel levels */
+
+static t_stat test_scp_event_queue ()
+{
+static const int32 delays[QTEST_UNITS] = {
+    5, 0, 255, 256, 257, 65535, 65536, 65537, 16777215, 16777216, 
+    3, 3, 300, 70000, 5, 0, 511, 1000000, 2000000000, 77,
+    16777217, 1, 65536, 256, 4095, 4096, 100000, 5, 12345678, 98765,
+    2, 999, 1 << 30, 257, 1024, 33333, 65537, 17, 88, 4000000};
+int32 due[QTEST_UNITS], seq[QTEST_UNITS], order[QTEST_UNITS];
+int32 i, j, cnt;
+double start;
+t_stat r = SCPE_OK;
+
+while (sim_clock_queue != QUEUE_LIST_END)
+    sim_cancel (sim_clock_queue);
+sim_time = sim_rtime = 0;
+noqueue_time = sim_interval = 0;
+sim_interval = -12345;                                  /* start off a slot boundary */
+start = sim_gtime ();
+for (i = 0; i < QTEST_UNITS; i++) {
+    memset (&qtest_units[i], 0, sizeof (qtest_units[i]));
+    qtest_units[i].action = &sim_scp_qtest_svc;
+    sim_activate (&qtest_units[i], delays[i]);
+    due[i] = delays[i];
+    seq[i] = i;
+    }
+if (sim_qcount () != QTEST_UNITS)
+    return sim_messagef (SCPE_IERR, "sim_qcount() unexpected result: %d\n", sim_qcount ());
+for (i = 0; i < QTEST_UNITS; i++) {
+    int32 t = sim_activate_time (&qtest_units[i]);
+
+    if (t != delays[i] + 1)
+        return sim_messagef (SCPE_IERR, "sim_activate_time() unexpected result for unit %d: %d instead of %d\n", i, t, delays[i] + 1);
+    }
+sim_cancel (&qtest_units[3]);
+sim_cancel (&qtest_units[1]);
+sim_activate_abs (&qtest_units[10], 5);                 /* requeued after the others due at 5 */
+due[10] = 5;
+seq[10] = QTEST_UNITS;
+for (i = cnt = 0; i < QTEST_UNITS; i++) {               /* expected order: due time then queue order */
+    if ((i == 1) || (i == 3))
+        continue;
+    for (j = cnt++; (j > 0) && ((due[i] < due[order[j - 1]]) || 
+                                ((due[i] == due[order[j - 1]]) && (seq[i] < seq[order[j - 1]]))); j--)
+        order[j] = order[j - 1];
+    order[j] = i;
+    }
+qtest_count = 0;
+while (sim_clock_queue != QUEUE_LIST_END) {
+    sim_interval = 0;                                   /* advance to the next event */
+    r = sim_process_event ();
+    if (r != SCPE_OK)
+        return sim_messagef (SCPE_IERR, "sim_process_event() unexpected result: %s\n", sim_error_text (r));
+    }
+if (qtest_count != cnt)
+    return sim_messagef (SCPE_IERR, "unexpected count %d of fired units - expected %d\n", qtest_count, cnt);
+for (i = 0; i < cnt; i++) {
+    if (qtest_fired[i] != order[i])
+        return sim_messagef (SCPE_IERR, "event %d fired for unit %d instead of unit %d\n", i, qtest_fired[i], order[i]);
+    }
+if (sim_gtime () != start + delays[18])
+    return sim_messagef (SCPE_IERR, "unexpected final time %.0f - expected %.0f\n", sim_gtime (), start + delays[18]);
+return r;
+}
+
+/* Deferred formatting of debug trace records */
+
+static t_bool test_scp_trace_kept (const char *fmt, ...)
+{
+va_list arglist;
+t_bool kept;
+
+va_start (arglist, fmt);
+kept = _sim_debug_trace_record (SIM_DBG_EVENT, &sim_scp_dev, NULL, fmt, arglist);
+va_end (arglist);
+return kept;
+}
+
+static t_stat test_scp_trace_msg (const char *fmt, ...)
+{
+char expect[CBUFSIZE], got[CBUFSIZE];
+va_list arglist;
+t_bool kept;
+
+va_start (arglist, fmt);
+vsnprintf (expect, sizeof (expect), fmt, arglist);
+va_end (arglist);
+va_start (arglist, fmt);
+kept = _sim_debug_trace_record (SIM_DBG_EVENT, &sim_scp_dev, NULL, fmt, arglist);
+va_end (arglist);
+if (!kept)
+    return sim_messagef (SCPE_IERR, "trace of \"%s\" was not recorded\n", fmt);
+_sim_debug_trace_format (&sim_deb_trace[0], got, sizeof (got));
+if (strcmp (expect, got) != 0)
+    return sim_messagef (SCPE_IERR, "trace of \"%s\" formatted as \"%s\" instead of \"%s\"\n", fmt, got, expect);
+return SCPE_OK;
+}
+
+static t_stat test_scp_debug_trace ()
+{
+DEBTRACE rec, *saved_trace = sim_deb_trace;
+size_t saved_size = sim_deb_trace_size, saved_next = sim_deb_trace_next, saved_inuse = sim_deb_trace_inuse;
+char str[16] = "transient";
+t_stat r = SCPE_OK;
+
+sim_deb_trace = &rec;
+sim_deb_trace_size = 1;
+sim_deb_trace_next = sim_deb_trace_inuse = 0;
+r = test_scp_trace_msg ("plain text\n");
+if (r == SCPE_OK)
+    r = test_scp_trace_msg ("%d %u %x %X %o %i\n", -5, 7u, 0xbeefu, 0xbeefu, 8u, 42);
+if (r == SCPE_OK)
+    r = test_scp_trace_msg ("|%5d|%-5d|%05d|%+d|%#o|%#x|\n", 12, 12, 12, 12, 8u, 255u);
+if (r == SCPE_OK)
+    r = test_scp_trace_msg ("|%*d|%-*s|%.*s|\n", 6, 99, 8, "ab", 3, "abcdef");
+if (r == SCPE_OK)
+    r = test_scp_trace_msg ("%s %c%c %%\n", str, 'o', 'k');
+if (r == SCPE_OK)
+    r = test_scp_trace_msg ("%ld %lu %lx\n", -70000L, 70000UL, 0xfffffUL);
+if (r == SCPE_OK)
+    r = test_scp_trace_msg ("%012" LL_FMT "o %" LL_FMT "d\n", (LL_TYPE)0777777777777, (LL_TYPE)-1);
+if (r == SCPE_OK)
+    r = test_scp_trace_msg ("%hx %hhx %hd\n", -1, -1, 70000);
+if (r == SCPE_OK)
+    r = test_scp_trace_msg ("%8.3f %g %e\n", 3.14159, 0.5, 1e10);
+if (r == SCPE_OK)
+    r = test_scp_trace_msg ("%p\n", (void *)&rec);
+if (r == SCPE_OK)
+    r = test_scp_trace_msg ("%d %d %d %d %d %d %d %d %d %d\n", 1, 2, 3, 4, 5, 6, 7, 8, 9, 10);
+if (r == SCPE_OK) {                                     /* strings are copied */
+    r = test_scp_trace_msg ("%s\n", str);
+    strcpy (str, "changed");
+    if ((r == SCPE_OK) && (strcmp (&rec.text[rec.arg[0].i], "transient") != 0))
+        r = sim_messagef (SCPE_IERR, "trace string argument not copied\n");
+    }
+if (r == SCPE_OK) {                                     /* too long isn't kept */
+    char lng[DT_TEXT + 1];
+
+    memset (lng, 'x', DT_TEXT);
+    lng[DT_TEXT] = '\0';
+    if (test_scp_trace_kept ("%s\n", lng) || (sim_deb_trace_inuse != 0))
+        r = sim_messagef (SCPE_IERR, "trace of a long string was recorded\n");
+    }
+if (r == SCPE_OK) {                                     /* direct output follows the trace */
+    FILE *saved_deb = sim_deb;
+    int32 saved_deb_switches = sim_deb_switches;
+    char line[CBUFSIZE] = "";
+
+    if ((sim_deb = tmpfile ()) != NULL) {
+        sim_deb_switches = SWMASK ('F');
+        test_scp_trace_kept ("first\n");
+        Fprintf (sim_deb, "second\n");
+        rewind (sim_deb);
+        if (fgets (line, sizeof (line), sim_deb) == NULL)
+            line[0] = '\0';
+        fclose (sim_deb);
+        }
+    sim_deb = saved_deb;
+    sim_deb_switches = saved_deb_switches;
+    if (strstr (line, "first") == NULL)
+        r = sim_messagef (SCPE_IERR, "debug output written ahead of the trace\n");
+    }
+sim_deb_trace = saved_trace;
+sim_deb_trace_size = saved_size;
+sim_deb_trace_next = saved_next;
+sim_deb_trace_inuse = saved_inuse;
+return r;
+}
+
+/* Event journal recording and replay */
+
+static t_stat test_scp_journal ()
+{
+const char *file = "scp_journal_test.jrn";
+uint8 data[4] = {1, 2, 3, 4}, got[4], raw[8 + 16] = {0};
+int32 c;
+uint32 cnt;
+FILE *f;
+t_stat r;
+
+if ((r = _sim_jrn_open (SIM_JRN_RECORD, file)) != SCPE_OK)
+    return r;
+cnt = sim_jrn_count;                            /* clock state recorded at start */
+c = 'A';
+sim_jrn_record (SIM_JRN_CON, 0, &c, sizeof (c));
+sim_jrn_base += 100;
+sim_jrn_record (SIM_JRN_TMXR, 0x20001, data, sizeof (data));
+c = 'B';
+sim_jrn_record (SIM_JRN_CON, 0, &c, sizeof (c));
+_sim_jrn_close ();
+if ((f = fopen (file, "rb")) != NULL) {         /* first header is little endian */
+    if (fread (raw, sizeof (raw), 1, f) != 1)
+        memset (raw, 0xFF, sizeof (raw));
+    fclose (f);
+    }
+if ((raw[20] != (cnt ? SIM_JRN_CALB : SIM_JRN_CON)) || (raw[21] != 0) ||
+    (raw[22] == 0) || (raw[23] != 0)) {
+    remove (file);
+    return sim_messagef (SCPE_IERR, "journal header not written little endian\n");
+    }
+r = _sim_jrn_open (SIM_JRN_REPLAY, file);
+if ((r == SCPE_OK) && (sim_jrn_count != cnt + 3))
+    r = sim_messagef (SCPE_IERR, "journal loaded %u events - expected %u\n", sim_jrn_count, cnt + 3);
+c = 0;
+if ((r == SCPE_OK) && ((sim_jrn_replay (SIM_JRN_CON, 0, &c, sizeof (c)) != sizeof (c)) || (c != 'A')))
+    r = sim_messagef (SCPE_IERR, "first console event not replayed\n");
+if ((r == SCPE_OK) && (sim_jrn_replay (SIM_JRN_CON, 0, &c, sizeof (c)) >= 0))
+    r = sim_messagef (SCPE_IERR, "console event replayed before its time\n");
+sim_jrn_base += 100;
+if ((r == SCPE_OK) && ((sim_jrn_replay (SIM_JRN_CON, 0, &c, sizeof (c)) != sizeof (c)) || (c != 'B')))
+    r = sim_messagef (SCPE_IERR, "second console event not replayed\n");
+if ((r == SCPE_OK) && (sim_jrn_replay (SIM_JRN_TMXR, 0x20002, got, sizeof (got)) >= 0))
+    r = sim_messagef (SCPE_IERR, "event replayed for the wrong source\n");
+if ((r == SCPE_OK) && ((sim_jrn_replay (SIM_JRN_TMXR, 0x20001, got, sizeof (got)) != sizeof (got)) ||
+                       (memcmp (got, data, sizeof (data)) != 0)))
+    r = sim_messagef (SCPE_IERR, "multiplexer event data not replayed\n");
+if ((r == SCPE_OK) && (sim_jrn_first != sim_jrn_count))
+    r = sim_messagef (SCPE_IERR, "%u events left unreplayed\n", sim_jrn_count - sim_jrn_first);
+_sim_jrn_close ();
+remove (file);
+return r;
+}
+
+/* Combined expect rule matching against a rule at a time reference */
+
+static t_stat test_scp_expect ()
+{
+EXPECT exp;
+char pats[40][10], match[16];
+uint8 hist[64];
+uint32 seed = 1, hlen = 0;
+int32 i, j, cnt[40], k, want, got;
+t_stat r = SCPE_OK;
+
+memset (&exp, 0, sizeof (exp));
+exp.dptr = &sim_scp_dev;
+for (i=0; i<40; i++) {                                  /* overlapping patterns over a small alphabet */
+    int32 len = 2 + (i % 6);
+
+    for (j=0; j<len; j++) {
+        seed = seed * 1103515245 + 12345;
+        pats[i][j] = "abcd"[(seed >> 16) % 4];
+        }
+    pats[i][len] = '\0';
+    if (i < 2)                                          /* a long rule and its suffix */
+        strcpy (pats[i], i ? "bcab" : "abcabcab");
+    if (i == 39)                                        /* rule which comes and goes */
+        strcpy (pats[i], "abcae");
+    sprintf (match, "\"%s\"", pats[i]);
+    if (sim_exp_fnd (&exp, match, 0) != NULL) {
+        pats[i][0] = '\0';
+        continue;
+        }
+    r = sim_exp_set (&exp, match, cnt[i] = 100000, 0, EXP_TYP_PERSIST, NULL);
+    if (r != SCPE_OK)
+        break;
+    }
+for (k=0; (r == SCPE_OK) && (k<20000); k++) {
+    uint8 data;
+
+    if ((k % 100) == 0) {                               /* rule list changes mid stream */
+        if (pats[39][0]) {
+            sim_exp_clr (&exp, "\"abcae\"");
+            pats[39][0] = '\0';
+            }
+        else {
+            strcpy (pats[39], "abcae");
+            r = sim_exp_set (&exp, "\"abcae\"", cnt[39] = 100000, 0, EXP_TYP_PERSIST, NULL);
+            }
+        }
+    seed = seed * 1103515245 + 12345;
+    data = (uint8)"abcde"[(seed >> 16) % 5];
+    if (hlen == sizeof (hist)) {
+        memmove (hist, hist + 1, hlen - 1);
+        --hlen;
+        }
+    hist[hlen++] = data;
+    want = -1;
+    for (i=j=0; i<40; i++) {                            /* first rule ending here wins */
+        uint32 len = (uint32)strlen (pats[i]);
+
+        if (!len)
+            continue;
+        if ((want < 0) && (len <= hlen) && (0 == memcmp (&hist[hlen - len], pats[i], len)))
+            want = j;
+        ++j;
+        }
+    sim_exp_check (&exp, data);
+    got = -1;
+    for (i=j=0; i<40; i++) {
+        if (!pats[i][0])
+            continue;
+        if (exp.rules[j].cnt != cnt[i]) {
+            got = j;
+            cnt[i] = exp.rules[j].cnt;
+            }
+        ++j;
+        }
+    if (want >= 0)                                      /* matched data is consumed */
+        hlen = 0;
+    if (got != want)
+        r = sim_messagef (SCPE_IERR, "expect character %d matched rule %d instead of rule %d\n", k, got, want);
+    }
+sim_exp_clrall (&exp);
+return r;
+}
+
 /*
  * Compiled in unit tests for the various device oriented library 
  * modules: sim_card, sim_disk, sim_tape, sim_ether, sim_tmxr, etc.
@@ -15957,6 +18469,14 @@ if ((strcmp (gbuf, "ALL") == 0) || (strcmp (gbuf, "SCP") == 0)) {
         return sim_messagef (SCPE_IERR, "SCP parsing test failed\n");
     if (test_scp_event_sequencing () != SCPE_OK)
         return sim_messagef (SCPE_IERR, "SCP event sequencing test failed\n");
+    if (test_scp_event_queue () != SCPE_OK)
+        return sim_messagef (SCPE_IERR, "SCP event queue test failed\n");
+    if (test_scp_debug_trace () != SCPE_OK)
+        return sim_messagef (SCPE_IERR, "SCP debug trace test failed\n");
+    if (test_scp_journal () != SCPE_OK)
+        return sim_messagef (SCPE_IERR, "SCP event journal test failed\n");
+    if (test_scp_expect () != SCPE_OK)
+        return sim_messagef (SCPE_IERR, "SCP expect matching test failed\n");
 }
 for (i = 0; (dptr = sim_devices[i]) != NULL; i++) {
     t_stat tstat = SCPE_OK;
@@ -117,6 +117,7 @@ t_stat echo_cmd (int32 flag, CONST char *ptr);
 t_stat echof_cmd (int32 flag, CONST char *ptr);
 t_stat debug_cmd (int32 flag, CONST char *ptr);
 t_stat runlimit_cmd (int32 flag, CONST char *ptr);
+t_stat benchmark_cmd (int32 flag, CONST char *ptr);
 t_stat tar_cmd (int32 flag, CONST char *ptr);
 t_stat curl_cmd (int32 flag, CONST char *ptr);
 t_stat test_lib_cmd (int32 flag, CONST char *ptr);
@@ -211,6 +212,7 @@ DEVICE *find_dev (const char *ptr);
 DEVICE *find_unit (const char *ptr, UNIT **uptr);
 DEVICE *find_dev_from_unit (UNIT *uptr);
 t_stat sim_register_internal_device (DEVICE *dptr);
+t_stat sim_register_mem_region (MEMREGION *mr);
 void sim_sub_args (char *in_str, size_t in_str_size, char *do_arg[]);
 REG *find_reg (CONST char *ptr, CONST char **optr, DEVICE *dptr);
 CTAB *find_ctab (CTAB *tab, const char *gbuf);
@@ -220,6 +222,13 @@ t_stat get_aval (t_addr addr, DEVICE *dptr, UNIT *uptr);
 t_value get_rval (REG *rptr, uint32 idx);
 BRKTAB *sim_brk_fnd (t_addr loc);
 uint32 sim_brk_test (t_addr bloc, uint32 btyp);
+void sim_profile_sample (t_addr pc, uint32 user);
+t_stat sim_set_profile (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
+t_stat sim_clr_profile (UNIT *uptr, int32 val, CONST char *cptr, void *desc);
+t_stat sim_show_profile (FILE *st, UNIT *uptr, int32 val, CONST void *desc);
+uint32 sim_jrn_devid (DEVICE *dptr);
+void sim_jrn_record (uint32 type, uint32 id, const void *data, uint32 len);
+int32 sim_jrn_replay (uint32 type, uint32 id, void *data, uint32 size);
 void sim_brk_clrspc (uint32 spc, uint32 btyp);
 void sim_brk_npc (uint32 cnt);
 void sim_brk_setact (const char *action);
@@ -250,6 +259,7 @@ t_stat sim_cancel_step (void);
 void sim_printf (const char *fmt, ...) GCC_FMT_ATTR(1, 2);
 void sim_perror (const char *msg);
 t_stat sim_messagef (t_stat stat, const char *fmt, ...) GCC_FMT_ATTR(2, 3);
+t_stat sim_debug_trace_set (size_t records);
 void sim_data_trace(DEVICE *dptr, UNIT *uptr, const uint8 *data, const char *position, size_t len, const char *txt, uint32 reason);
 void sim_debug_bits_hdr (uint32 dbits, DEVICE* dptr, const char *header, 
     BITFIELD* bitdefs, uint32 before, uint32 after, int terminate);
@@ -269,6 +279,19 @@ void _sim_debug_device (uint32 dbits, DEVICE* dptr, const char* fmt, ...) GCC_FM
 #define sim_debug(dbits, dptr, ...) do { if ((sim_deb != NULL) && ((dptr) != NULL) && ((dptr)->dctrl & (dbits))) _sim_debug_device (dbits, dptr, __VA_ARGS__);} while (0)
 #define sim_debug_unit(dbits, uptr, ...) do { if ((sim_deb != NULL) && ((uptr) != NULL) && (uptr->dptr != NULL) && (((uptr)->dctrl | (uptr)->dptr->dctrl) & (dbits))) _sim_debug_unit (dbits, uptr, __VA_ARGS__);} while (0)
 #endif
+/* PC sampling hook for sim_instr, one test when profiling is off */
+#define SIM_PROFILE(pc, user) do { if (sim_prof_countdown && (--sim_prof_countdown == 0)) sim_profile_sample ((t_addr)(pc), (uint32)(user));} while (0)
+/* Event journal modes (sim_jrn_mode) and record types */
+#define SIM_JRN_OFF     0
+#define SIM_JRN_RECORD  1
+#define SIM_JRN_REPLAY  2
+#define SIM_JRN_CON     1                   /* console keyboard character */
+#define SIM_JRN_TMXR    2                   /* multiplexer line receive data */
+#define SIM_JRN_CONN    3                   /* multiplexer line connection */
+#define SIM_JRN_ETH     4                   /* Ethernet receive packet */
+#define SIM_JRN_CALB    5                   /* calibrated timer interval */
+#define SIM_JRN_AIO     6                   /* asynchronous I/O completion */
+#define SIM_JRN_IDLE    7                   /* time skipped while idling */
 void sim_flush_buffered_files (void);
 
 void fprint_stopped_gen (FILE *st, t_stat v, REG *pc, DEVICE *dptr);
@@ -313,6 +336,8 @@ extern size_t sim_deb_buffer_size;                      /* debug memory buffer s
 extern char *sim_deb_buffer;                            /* debug memory buffer */
 extern size_t sim_debug_buffer_offset;                  /* debug memory buffer insertion offset */
 extern size_t sim_debug_buffer_inuse;                   /* debug memory buffer inuse count */
+extern size_t sim_deb_trace_size;                       /* debug trace record count */
+extern size_t sim_deb_trace_inuse;                      /* debug trace records in use */
 extern struct timespec sim_deb_basetime;                /* debug base time for relative time output */
 extern DEVICE **sim_internal_devices;
 extern uint32 sim_internal_device_count;
@@ -329,6 +354,8 @@ extern uint32 sim_brk_summ;
 extern uint32 sim_brk_match_type;
 extern t_addr sim_brk_match_addr;
 extern BRKTYPTAB *sim_brk_type_desc;                    /* type descriptions */
+extern int32 sim_prof_countdown;                        /* instructions to next PC sample */
+extern int32 sim_jrn_mode;                              /* event journal mode */
 extern const char *sim_prog_name;                       /* executable program name */
 extern FILE *stdnul;
 extern t_bool sim_asynch_enabled;
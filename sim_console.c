@@ -2282,7 +2282,7 @@ sim_deb_switches = switches &
                     SWMASK ('T') | SWMASK ('A') | 
                     SWMASK ('F') | SWMASK ('N') |
                     SWMASK ('B') | SWMASK ('E') |
-                    SWMASK ('D') );                 /* save debug switches */
+                    SWMASK ('D') | SWMASK ('K') );  /* save debug switches */
 return old_deb_switches;
 }
 
@@ -2294,6 +2294,7 @@ char gbuf[CBUFSIZE];
 t_stat r;
 time_t now;
 size_t buffer_size = 0;
+size_t trace_size = 0;
 
 if ((cptr == NULL) || (*cptr == 0))                     /* need arg */
     return SCPE_2FARG;
@@ -2303,6 +2304,12 @@ if (sim_switches & SWMASK ('B')) {
     if ((buffer_size == 0) || (buffer_size > 1024))
         return sim_messagef (SCPE_ARG, "Invalid debug memory buffersize %u MB\n", (unsigned int)buffer_size);
     }
+if (sim_switches & SWMASK ('K')) {
+    cptr = get_glyph_nc (cptr, gbuf, 0);                /* trace entries */
+    trace_size = (size_t)strtoul (gbuf, NULL, 10);
+    if ((trace_size == 0) || (trace_size > 16*1024*1024))
+        return sim_messagef (SCPE_ARG, "Invalid debug trace size %u entries\n", (unsigned int)trace_size);
+    }
 cptr = get_glyph_nc (cptr, gbuf, 0);                    /* get file name */
 if (*cptr != 0)                                         /* now eol? */
     return SCPE_2MARG;
@@ -2340,6 +2347,9 @@ if (sim_deb_switches & SWMASK ('E'))
 if (sim_deb_switches & SWMASK ('B'))
     sim_messagef (SCPE_OK, "   Debug messages will be written to a %u MB circular memory buffer\n", 
                                 (unsigned int)buffer_size);
+if (sim_deb_switches & SWMASK ('K'))
+    sim_messagef (SCPE_OK, "   Debug messages will be recorded in a %u entry trace\n", 
+                                (unsigned int)trace_size);
 time(&now);
 if (!sim_quiet) {
     fprintf (sim_deb, "Debug output to \"%s\" at %s", sim_logfile_name (sim_deb, sim_deb_ref), ctime(&now));
@@ -2354,6 +2364,14 @@ if (sim_deb_switches & SWMASK ('B')) {
     sim_debug_buffer_offset = sim_debug_buffer_inuse = 0;
     memset (sim_deb_buffer, 0, sim_deb_buffer_size);
     }
+if (sim_deb_switches & SWMASK ('K')) {
+    r = sim_debug_trace_set (trace_size);
+    if (r != SCPE_OK) {
+        sim_switches = 0;
+        sim_set_deboff (0, NULL);
+        return r;
+        }
+    }
 
 return SCPE_OK;
 }
@@ -2366,6 +2384,7 @@ if (cptr && (*cptr != 0))                               /* now eol? */
     return SCPE_2MARG;
 if (sim_deb == NULL)                                    /* no debug? */
     return SCPE_OK;
+sim_debug_trace_set (0);                                /* write any trace */
 if (sim_deb_switches & SWMASK ('B')) {
     size_t offset = (sim_debug_buffer_inuse == sim_deb_buffer_size) ? sim_debug_buffer_offset : 0;
     const char *bufmsg = "Circular Buffer Contents follow here:\n\n";
@@ -2412,6 +2431,9 @@ if (sim_deb) {
         fprintf (st, "   Debug messages are not being filtered to summarize duplicate lines\n");
     if (sim_deb_switches & SWMASK ('E'))
         fprintf (st, "   Debug messages containing blob data in EBCDIC will display in readable form\n");
+    if (sim_deb_trace_size)
+        fprintf (st, "   Debug messages are being recorded in a %u entry trace (%u in use)\n", 
+                     (unsigned int)sim_deb_trace_size, (unsigned int)sim_deb_trace_inuse);
     for (i = 0; (dptr = sim_devices[i]) != NULL; i++) {
         t_bool unit_debug = FALSE;
         uint32 unit;
@@ -2880,6 +2902,14 @@ if (!sim_rem_master_mode) {
         }
     if ((sim_con_tmxr.master == 0) &&                       /* not Telnet? */
         (sim_con_ldsc.serport == 0)) {                      /* and not serial? */
+        if (sim_jrn_mode == SIM_JRN_REPLAY) {               /* replaying event journal? */
+            c = SCPE_OK;                                    /* journal stands in for keyboard */
+            sim_jrn_replay (SIM_JRN_CON, 0, &c, sizeof (c));
+            }
+        else {
+            if (c && (sim_jrn_mode == SIM_JRN_RECORD))      /* recording event journal? */
+                sim_jrn_record (SIM_JRN_CON, 0, &c, sizeof (c));
+            }
         if (c && sim_con_ldsc.rxbps)                        /* got something && rate limiting? */
             sim_con_ldsc.rxnexttime =                       /* compute next input time */
                 floor (sim_gtime () + ((sim_con_ldsc.rxdeltausecs * sim_timer_inst_per_sec ()) / USECS_PER_SECOND));
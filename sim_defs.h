@@ -479,6 +479,7 @@ typedef struct DEBTAB DEBTAB;
 typedef struct FILEREF FILEREF;
 typedef struct MEMFILE MEMFILE;
 typedef struct BITFIELD BITFIELD;
+typedef struct MEMREGION MEMREGION;
 
 typedef t_stat (*ACTIVATE_API)(UNIT *unit, int32 interval);
 
@@ -605,6 +606,8 @@ struct UNIT {
     char                *uname;                         /* Unit name */
     DEVICE              *dptr;                          /* DEVICE linkage (backpointer) */
     uint32              dctrl;                          /* debug control */
+    UNIT                *prev;                          /* previous active */
+    t_int64             due;                            /* event queue due time */
 #ifdef SIM_ASYNCH_IO
     void                (*a_check_completion)(UNIT *);
     t_bool              (*a_is_active)(UNIT *);
@@ -814,6 +817,37 @@ struct BRKTYPTAB {
     };
 #define BRKTYPE(typ,descrip) {SWMASK(typ), descrip}
 
+/* Memory region
+
+   Describes the host array behind a memory-like unit so that SAVE and
+   RESTORE can move its contents directly instead of calling the
+   device's examine and deposit routines for every address.  The region
+   covers unit addresses low through capac-1; lower addresses still go
+   through examine/deposit.  When an element holds several addresses
+   they are packed most significant first.
+
+   A simulator which sets a bit in dirty (one bit per SIM_DIRTY_PAGE
+   addresses, sized with SIM_DIRTY_BYTES) every time it changes that
+   part of the region lets SAVE -I write just the pages changed since
+   the last snapshot. */
+
+#define SIM_DIRTY_SHIFT         10                      /* log2 addresses per dirty bit */
+#define SIM_DIRTY_PAGE          (1u << SIM_DIRTY_SHIFT)
+#define SIM_DIRTY_BYTES(n)      ((((n) >> SIM_DIRTY_SHIFT) >> 3) + 1)
+#define SIM_SET_DIRTY(map,a)    ((map)[(a) >> (SIM_DIRTY_SHIFT + 3)] |= (uint8)(1u << (((a) >> SIM_DIRTY_SHIFT) & 7)))
+#define SIM_IS_DIRTY(map,a)     (((map)[(a) >> (SIM_DIRTY_SHIFT + 3)] >> (((a) >> SIM_DIRTY_SHIFT) & 7)) & 1)
+
+struct MEMREGION {
+    DEVICE              *dptr;                          /* device */
+    UNIT                *uptr;                          /* memory unit */
+    void                *mem;                           /* memory array */
+    uint32              width;                          /* bytes per element */
+    uint32              addrs;                          /* addresses per element */
+    t_addr              low;                            /* first address in region */
+    t_value             mask;                           /* value mask (0 = none) */
+    uint8               *dirty;                         /* changed pages (NULL = not tracked) */
+    };
+
 /* Expect rule */
 
 struct EXPTAB {
@@ -846,6 +880,13 @@ struct EXPECT {
     uint32              buf_ins;                        /* buffer insertion point for the next output data */
     uint32              buf_size;                       /* buffer size */
     uint32              buf_data;                       /* count of data in buffer */
+    t_bool              ac_valid;                       /* literal rule automaton is current */
+    uint32              *ac_next;                       /* automaton transitions (state x input class) */
+    int32               *ac_out;                        /* lowest matching literal rule per state (-1 = none) */
+    uint16              ac_class[256];                  /* data byte to automaton input class */
+    uint32              ac_classes;                     /* count of input classes */
+    uint32              ac_state;                       /* current automaton state */
+    int32               ac_regex;                       /* count of RegEx rules */
     };
 
 /* Send Context */
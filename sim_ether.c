@@ -3786,7 +3786,7 @@ if (bpf_used ? to_me : (to_me && !from_me)) {
   }
 }
 
-int eth_read(ETH_DEV* dev, ETH_PACK* packet, ETH_PCALLBACK routine)
+static int _eth_read(ETH_DEV* dev, ETH_PACK* packet, ETH_PCALLBACK routine)
 {
 int status;
 
@@ -3907,6 +3907,48 @@ if (status < 0) {
 return status;
 }
 
+/* Received packets are journaled as their two lengths followed by the frame */
+
+int eth_read(ETH_DEV* dev, ETH_PACK* packet, ETH_PCALLBACK routine)
+{
+uint8 buf[2 * sizeof (uint32) + ETH_FRAME_SIZE];
+uint32 lens[2];
+int32 size;
+int status;
+
+if ((!dev) || (dev->eth_api == ETH_API_NONE) || (!packet))
+  return 0;
+if (sim_jrn_mode == SIM_JRN_REPLAY) {     /* replaying event journal? */
+  packet->len = 0;
+  size = sim_jrn_replay (SIM_JRN_ETH, sim_jrn_devid (dev->dptr), buf, sizeof (buf));
+  if (size < (int32)sizeof (lens))
+    return 0;
+  memcpy (lens, buf, sizeof (lens));
+  packet->len = lens[0];
+  packet->crc_len = lens[1];
+  size -= (int32)sizeof (lens);
+  if (size > (int32)sizeof (packet->msg))
+    size = (int32)sizeof (packet->msg);
+  memcpy (packet->msg, &buf[sizeof (lens)], size);
+  ++dev->packets_received;
+  if (routine)
+    routine(0);
+  return 1;
+  }
+status = _eth_read (dev, packet, routine);
+if ((status > 0) && (packet->len) && (sim_jrn_mode == SIM_JRN_RECORD)) {
+  lens[0] = packet->len;
+  lens[1] = packet->crc_len;
+  size = (int32)((lens[0] > lens[1]) ? lens[0] : lens[1]);
+  if (size > ETH_FRAME_SIZE)
+    size = ETH_FRAME_SIZE;
+  memcpy (buf, lens, sizeof (lens));
+  memcpy (&buf[sizeof (lens)], packet->msg, size);
+  sim_jrn_record (SIM_JRN_ETH, sim_jrn_devid (dev->dptr), buf, sizeof (lens) + size);
+  }
+return status;
+}
+
 t_stat eth_bpf_filter (ETH_DEV* dev, int addr_count, ETH_MAC* const filter_address,
                        ETH_BOOL all_multicast, ETH_BOOL promiscuous, 
                        int reflections,
@@ -53,6 +53,9 @@
    sim_buf_swap_data -       swap data elements inplace in buffer
    sim_shmem_open            create or attach to a shared memory region
    sim_shmem_close           close a shared memory region
+   sim_fmap_open             map an open file into memory, privately if read only
+   sim_fmap_sync             write a mapped file's changes to disk
+   sim_fmap_close            unmap a mapped file
 
 
    sim_fopen and sim_fseek are OS-dependent.  The other routines are not.
@@ -582,6 +585,61 @@ t_bool sim_shmem_atomic_cas (int32 *ptr, int32 oldv, int32 newv)
 return (InterlockedCompareExchange ((LONG volatile *) ptr, newv, oldv) == oldv);
 }
 
+struct FMAP {
+    HANDLE hFile;
+    HANDLE hMapping;
+    size_t size;
+    void *base;
+    };
+
+t_stat sim_fmap_open (FILE *fptr, size_t size, t_bool rdonly, FMAP **fmap, void **addr)
+{
+*addr = NULL;
+*fmap = NULL;
+if (rdonly && (sim_fsize_ex (fptr) < (t_offset)size))   /* can't map past the end */
+    return SCPE_OPENERR;
+fflush (fptr);
+*fmap = (FMAP *)calloc (1, sizeof(**fmap));
+if (*fmap == NULL)
+    return SCPE_MEM;
+(*fmap)->size = size;
+(*fmap)->hFile = (HANDLE)_get_osfhandle (_fileno (fptr));
+(*fmap)->hMapping = CreateFileMappingA ((*fmap)->hFile, NULL, rdonly ? PAGE_READONLY : PAGE_READWRITE,
+                                        (DWORD)(((t_uint64)size) >> 32), (DWORD)size, NULL);
+if ((*fmap)->hMapping == NULL) {
+    free (*fmap);
+    *fmap = NULL;
+    return SCPE_OPENERR;
+    }
+(*fmap)->base = MapViewOfFile ((*fmap)->hMapping, rdonly ? FILE_MAP_COPY : FILE_MAP_WRITE, 0, 0, size);
+if ((*fmap)->base == NULL) {
+    CloseHandle ((*fmap)->hMapping);
+    free (*fmap);
+    *fmap = NULL;
+    return SCPE_OPENERR;
+    }
+*addr = (*fmap)->base;
+return SCPE_OK;
+}
+
+void sim_fmap_sync (FMAP *fmap)
+{
+if (fmap == NULL)
+    return;
+FlushViewOfFile (fmap->base, fmap->size);
+FlushFileBuffers (fmap->hFile);
+}
+
+void sim_fmap_close (FMAP *fmap)
+{
+if (fmap == NULL)
+    return;
+FlushViewOfFile (fmap->base, fmap->size);
+UnmapViewOfFile (fmap->base);
+CloseHandle (fmap->hMapping);
+free (fmap);
+}
+
 #else /* !defined(_WIN32) */
 #include <unistd.h>
 int sim_set_fsize (FILE *fptr, t_addr size)
@@ -774,6 +832,58 @@ else
 #endif
 }
 
+struct FMAP {
+    size_t size;
+    void *base;
+    };
+
+t_stat sim_fmap_open (FILE *fptr, size_t size, t_bool rdonly, FMAP **fmap, void **addr)
+{
+int fd = fileno (fptr);
+struct stat statb;
+
+*addr = NULL;
+*fmap = NULL;
+fflush (fptr);
+if (fstat (fd, &statb))
+    return SCPE_OPENERR;
+if (statb.st_size < (off_t)size) {
+    if (rdonly)                                         /* can't map past the end */
+        return SCPE_OPENERR;
+    if (ftruncate (fd, (off_t)size))                    /* extend to full size */
+        return SCPE_IOERR;
+    }
+*fmap = (FMAP *)calloc (1, sizeof(**fmap));
+if (*fmap == NULL)
+    return SCPE_MEM;
+(*fmap)->size = size;
+/* Stores to a read only file stay in private pages, as with a buffer */
+(*fmap)->base = mmap (NULL, size, PROT_READ | PROT_WRITE, rdonly ? MAP_PRIVATE : MAP_SHARED, fd, 0);
+if ((*fmap)->base == MAP_FAILED) {
+    free (*fmap);
+    *fmap = NULL;
+    return SCPE_OPENERR;
+    }
+*addr = (*fmap)->base;
+return SCPE_OK;
+}
+
+void sim_fmap_sync (FMAP *fmap)
+{
+if (fmap == NULL)
+    return;
+msync (fmap->base, fmap->size, MS_SYNC);
+}
+
+void sim_fmap_close (FMAP *fmap)
+{
+if (fmap == NULL)
+    return;
+msync (fmap->base, fmap->size, MS_SYNC);
+munmap (fmap->base, fmap->size);
+free (fmap);
+}
+
 #else /* !(defined (__linux__) || defined (__APPLE__)) */
 
 t_stat sim_shmem_open (const char *name, size_t size, SHMEM **shmem, void **addr)
@@ -795,6 +905,21 @@ t_bool sim_shmem_atomic_cas (int32 *ptr, int32 oldv, int32 newv)
 return FALSE;
 }
 
+t_stat sim_fmap_open (FILE *fptr, size_t size, t_bool rdonly, FMAP **fmap, void **addr)
+{
+*fmap = NULL;
+*addr = NULL;
+return SCPE_NOFNC;
+}
+
+void sim_fmap_sync (FMAP *fmap)
+{
+}
+
+void sim_fmap_close (FMAP *fmap)
+{
+}
+
 #endif /* defined (__linux__) || defined (__APPLE__) */
 #endif /* defined (_WIN32) */
 
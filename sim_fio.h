@@ -95,6 +95,10 @@ t_stat sim_shmem_open (const char *name, size_t size, SHMEM **shmem, void **addr
 void sim_shmem_close (SHMEM *shmem);
 int32 sim_shmem_atomic_add (int32 *ptr, int32 val);
 t_bool sim_shmem_atomic_cas (int32 *ptr, int32 oldv, int32 newv);
+typedef struct FMAP FMAP;
+t_stat sim_fmap_open (FILE *fptr, size_t size, t_bool rdonly, FMAP **fmap, void **addr);
+void sim_fmap_sync (FMAP *fmap);
+void sim_fmap_close (FMAP *fmap);
 
 extern t_bool sim_taddr_64;         /* t_addr is > 32b and Large File Support available */
 extern t_bool sim_toffset_64;       /* Large File (>2GB) file I/O support */
@@ -223,6 +223,7 @@ typedef struct RTC {
     uint32 clock_calib_skip_idle;   /* Calibrations skipped due to idling */
     uint32 clock_calib_gap2big;     /* Calibrations skipped Gap Too Big */
     uint32 clock_calib_backwards;   /* Calibrations skipped Clock Running Backwards */
+    int32 jrn_currd;                /* journaled current delay */
     } RTC;
 
 RTC rtcs[SIM_NTIMERS+1];
@@ -920,8 +921,60 @@ RTC *rtc = &rtcs[tmr];
 return sim_rtcn_calb (rtc->hz, tmr);
 }
 
+/* Calibrated intervals depend on wall clock time, so while an event
+   journal is active each change is recorded, and on replay the recorded
+   interval replaces the one just computed */
+
+static int32 _rtcn_journal (int32 tmr, int32 currd)
+{
+RTC *rtc = &rtcs[tmr];
+
+if (sim_jrn_mode == SIM_JRN_RECORD) {
+    if (currd != rtc->jrn_currd) {
+        rtc->jrn_currd = currd;
+        sim_jrn_record (SIM_JRN_CALB, tmr, &currd, sizeof (currd));
+        }
+    return currd;
+    }
+while (sim_jrn_replay (SIM_JRN_CALB, tmr, &rtc->jrn_currd, sizeof (rtc->jrn_currd)) >= 0)
+    ;
+if (rtc->jrn_currd != 0)
+    rtc->currd = rtc->jrn_currd;
+return rtc->currd;
+}
+
+void sim_timer_journal_start (void)
+{
+int32 tmr;
+
+for (tmr=0; tmr<=SIM_NTIMERS; tmr++) {
+    rtcs[tmr].jrn_currd = 0;
+    if (rtcs[tmr].hz)
+        _rtcn_journal (tmr, rtcs[tmr].currd);
+    }
+if (sim_jrn_mode == SIM_JRN_RECORD)
+    sim_jrn_record (SIM_JRN_CALB, SIM_NTIMERS + 1, &sim_inst_per_sec_last, sizeof (sim_inst_per_sec_last));
+else
+    sim_jrn_replay (SIM_JRN_CALB, SIM_NTIMERS + 1, &sim_inst_per_sec_last, sizeof (sim_inst_per_sec_last));
+}
+
+static int32 _sim_rtcn_calb (uint32 ticksper, int32 tmr);
+
 int32 sim_rtcn_calb (uint32 ticksper, int32 tmr)
 {
+int32 currd = _sim_rtcn_calb (ticksper, tmr);
+
+if ((sim_jrn_mode != SIM_JRN_OFF) && (ticksper != 0)) {
+    if (tmr == SIM_INTERNAL_CLK)
+        tmr = SIM_NTIMERS;
+    if ((tmr >= 0) && (tmr <= SIM_NTIMERS))
+        currd = _rtcn_journal (tmr, currd);
+    }
+return currd;
+}
+
+static int32 _sim_rtcn_calb (uint32 ticksper, int32 tmr)
+{
 uint32 new_rtime, delta_rtime, last_idle_pct, catchup_ticks_curr;
 int32 delta_vtime;
 double new_gtime;
@@ -990,6 +1043,7 @@ if (sim_calb_tmr != tmr) {
     }
 new_rtime = sim_os_msec ();                         /* wall time */
 if (!sim_signaled_int_char && 
+    (sim_jrn_mode == SIM_JRN_OFF) &&                /* polls must stay deterministic */
     ((new_rtime - sim_last_poll_kbd_time) > 500)) {
     sim_debug (DBG_CAL, &sim_timer_dev, "sim_rtcn_calb(tmr=%d) gratuitious keyboard poll after %d msecs\n", tmr, (int)(new_rtime - sim_last_poll_kbd_time));
     (void)sim_poll_kbd ();
@@ -1619,8 +1673,42 @@ return SCPE_OK;
         w = ms_to_wait / ms_per_wait
 */
 
+/* The time skipped by idling depends on how long the host slept, so
+   while an event journal is active it is recorded for each idle call
+   and replayed without sleeping */
+
+static t_bool _sim_idle (uint32 tmr, int sin_cyc);
+
 t_bool sim_idle (uint32 tmr, int sin_cyc)
 {
+int32 jrn[2];                                           /* cycles skipped, idled */
+int32 before = sim_interval, after;
+
+switch (sim_jrn_mode) {
+    case SIM_JRN_OFF:
+        return _sim_idle (tmr, sin_cyc);
+    case SIM_JRN_REPLAY:
+        if (sim_jrn_replay (SIM_JRN_IDLE, 0, jrn, sizeof (jrn)) != sizeof (jrn)) {
+            sim_interval -= sin_cyc;
+            return FALSE;
+            }
+        sim_interval -= jrn[0];
+        return (t_bool)jrn[1];
+    default:
+        jrn[1] = _sim_idle (tmr, sin_cyc);
+        jrn[0] = before - sim_interval;
+        if (jrn[0] != sin_cyc) {
+            after = sim_interval;                       /* stamp with the time idling began */
+            sim_interval = before;
+            sim_jrn_record (SIM_JRN_IDLE, 0, jrn, sizeof (jrn));
+            sim_interval = after;
+            }
+        return (t_bool)jrn[1];
+    }
+}
+
+static t_bool _sim_idle (uint32 tmr, int sin_cyc)
+{
 uint32 w_ms, w_idle, act_ms;
 int32 act_cyc;
 static t_bool in_nowait = FALSE;
@@ -2241,7 +2329,7 @@ static t_bool _rtcn_tick_catchup_check (RTC *rtc, int32 time)
 int32 tmr;
 t_bool bReturn = FALSE;
 
-if (!sim_catchup_ticks)
+if ((!sim_catchup_ticks) || (sim_jrn_mode != SIM_JRN_OFF))
     return FALSE;
 if (time == -1) {
     for (tmr=0; tmr<=SIM_NTIMERS; tmr++) {
@@ -677,16 +677,35 @@ return loop_read_ex (lp, buf, bufsize);
    embedded in the Telnet protocol and must be determined externally.
 */
 
+static uint32 tmxr_jrn_id (TMLN *lp)
+{
+if (lp->mp == NULL)
+    return 0xFFFF0000;
+return (sim_jrn_devid (lp->mp->dptr) << 16) | (uint32)(lp - lp->mp->ldsc);
+}
+
 static int32 tmxr_read (TMLN *lp, int32 length)
 {
 int32 i = lp->rxbpi;
+int32 nbytes;
 
+if (sim_jrn_mode == SIM_JRN_REPLAY) {                   /* replaying event journal? */
+    nbytes = sim_jrn_replay (SIM_JRN_TMXR, tmxr_jrn_id (lp), &(lp->rxb[i]), length);
+    if (nbytes == 0)                                    /* recorded line error? */
+        return -1;
+    return (nbytes < 0) ? 0 : nbytes;
+    }
 if (lp->loopback)
-    return loop_read (lp, &(lp->rxb[i]), length);
-if (lp->serport)                                        /* serial port connection? */
-    return sim_read_serial (lp->serport, &(lp->rxb[i]), length, &(lp->rbr[i]));
-else                                                    /* Telnet connection */
-    return sim_read_sock (lp->sock, &(lp->rxb[i]), length);
+    nbytes = loop_read (lp, &(lp->rxb[i]), length);
+else {
+    if (lp->serport)                                    /* serial port connection? */
+        nbytes = sim_read_serial (lp->serport, &(lp->rxb[i]), length, &(lp->rbr[i]));
+    else                                                /* Telnet connection */
+        nbytes = sim_read_sock (lp->sock, &(lp->rxb[i]), length);
+    }
+if ((nbytes != 0) && (sim_jrn_mode == SIM_JRN_RECORD))  /* recording event journal? */
+    sim_jrn_record (SIM_JRN_TMXR, tmxr_jrn_id (lp), &(lp->rxb[i]), (nbytes > 0) ? nbytes : 0);
+return nbytes;
 }
 
 
@@ -994,8 +1013,19 @@ return SCPE_OK;
 
 */
 
+static int32 _tmxr_poll_conn (TMXR *mp);
+
 int32 tmxr_poll_conn (TMXR *mp)
 {
+int32 ln = _tmxr_poll_conn (mp);
+
+if ((ln >= 0) && (sim_jrn_mode == SIM_JRN_RECORD))      /* recording event journal? */
+    sim_jrn_record (SIM_JRN_CONN, sim_jrn_devid (mp->dptr), &ln, sizeof (ln));
+return ln;
+}
+
+static int32 _tmxr_poll_conn (TMXR *mp)
+{
 SOCKET newsock;
 TMLN *lp;
 int32 *op;
@@ -1043,6 +1073,17 @@ if (mp->last_poll_time == 0) {                          /* first poll initializa
         }
     }
 
+if (sim_jrn_mode == SIM_JRN_REPLAY) {                   /* replaying event journal? */
+    if ((sim_jrn_replay (SIM_JRN_CONN, sim_jrn_devid (mp->dptr), &i, sizeof (i)) < 0) ||
+        (i < 0) || (i >= mp->lines))
+        return -1;
+    lp = mp->ldsc + i;
+    tmxr_set_line_loopback (lp, TRUE);                  /* journal stands in for the connection */
+    lp->ser_connect_pending = FALSE;
+    lp->conn = TRUE;
+    return i;
+    }
+
 if (sim_is_running && 
     ((poll_time - mp->last_poll_time) < mp->poll_interval*1000))
     return -1;                                          /* too soon to try */